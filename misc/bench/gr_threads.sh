@@ -0,0 +1,34 @@
+#!/bin/sh
+
+# Thread scaling benchmark of the g(r) histogram accumulation:
+# OMP ATOMIC updates of shared histograms against per-thread histograms.
+#
+# Usage: gr_threads.sh [max. number of threads] [atoms] [MD steps] [bins]
+# Every run is repeated 3 times, the best wall time is kept.
+
+MAXTH=${1:-$(nproc)}
+NA=${2:-6000}
+NS=${3:-4}
+NDR=${4:-200}
+FC=${FC:-gfortran}
+BENCH_DIR=$(dirname "$0")
+EXE=$(mktemp /tmp/gr_threads.XXXXXX)
+
+${FC} -O2 -cpp -fopenmp -DOPENMP -o ${EXE} ${BENCH_DIR}/gr_threads.F90 || exit 1
+
+best ()
+{
+  for r in 1 2 3; do
+    OMP_NUM_THREADS=$2 ${EXE} $1 ${NA} ${NS} ${NDR}
+  done | sort -k3 -g | head -1
+}
+
+echo "atoms= ${NA}, MD steps= ${NS}, bins= ${NDR}"
+echo "threads   atomic (s)   per-thread (s)   atomic/per-thread   checksums equal"
+for t in $(seq 1 ${MAXTH}); do
+  a=$(best 0 $t)
+  p=$(best 1 $t)
+  echo "$a $p" | awk '{printf "%7d   %10.4f   %14.4f   %17.2f   %s\n", $2, $3, $7, $3/$7, ($4 == $8) ? "yes" : "no"}'
+done
+
+rm -f ${EXE}
@@ -105,9 +105,7 @@ extern int alloc_data_ (int *,
                         int *,
                         int *);
 
-extern void read_pos_ (double *,
-                       double *,
-                       double *);
+extern void bind_pos_ (double *);
 
 extern void read_data_ (int *,
                         int *);
@@ -142,6 +140,7 @@ extern void sendcuts_ (int *,
 extern int rundmtx_ (int *,
                      int *,
                      int *);
+extern int update_dmtx_ ();
 
 extern int bonding_ (int *,
                      int *,
@@ -151,8 +150,7 @@ extern int bonding_ (int *,
                      double *,
                      char *);
 
-extern int molecules_ (int *,
-                       int *);
+extern int molecules_ (int *);
 
 extern int bond_angles_ (int *);
 extern int bond_diedrals_ (int *);
@@ -624,7 +624,7 @@ void print_coord_cp2k (GtkTextBuffer * buffer)
         print_info ("\n", NULL, buffer);
         print_info (qm_proj -> chemistry -> label[i], NULL, buffer);
         str = g_strdup_printf ("         %15.10lf     %15.10lf     %15.10lf",
-                               qm_proj -> atoms[0][j].x, qm_proj -> atoms[0][j].y, qm_proj -> atoms[0][j].z);
+                               qm_proj -> pos[0][0][j], qm_proj -> pos[0][1][j], qm_proj -> pos[0][2][j]);
         print_info (str, NULL, buffer);
         g_free (str);
         /*if (qm_view -> bonding)
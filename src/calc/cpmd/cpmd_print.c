@@ -674,7 +674,7 @@ void print_atoms_section (GtkTextBuffer * buf)
       if (qm_proj -> atoms[0][j].sp == i)
       {
         str = g_strdup_printf ("      %12.6lf  %12.6lf  %12.6lf\n",
-                               qm_proj -> atoms[0][j].x/u, qm_proj -> atoms[0][j].y/u, qm_proj -> atoms[0][j].z/u);
+                               qm_proj -> pos[0][0][j]/u, qm_proj -> pos[0][1][j]/u, qm_proj -> pos[0][2][j]/u);
         print_info (str, NULL, buf);
         g_free (str);
       }
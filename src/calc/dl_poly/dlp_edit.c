@@ -1782,7 +1782,7 @@ G_MODULE_EXPORT void selection_button (GtkButton * but, gpointer data)
         l = tmp_fmol -> atoms_id[tmp_fcons -> ia[1]-1][k].a;
         m = tmp_fmol -> atoms_id[tmp_fcons -> ia[1]-1][k].b;
         o = get_active_atom (tmp_fmol -> id, l) -> list[m];
-        tmp_fcons -> av += distance_3d (& tmp_proj -> cell, 0, & tmp_proj -> atoms[0][n], & tmp_proj -> atoms[0][o]).length;
+        tmp_fcons -> av += distance_3d (& tmp_proj -> cell, 0, get_atom_pos (tmp_proj, 0, n), get_atom_pos (tmp_proj, 0, o)).length;
       }
       tmp_fcons -> av /= tmp_fmol -> multi;
     }
@@ -1792,7 +1792,7 @@ G_MODULE_EXPORT void selection_button (GtkButton * but, gpointer data)
   {
     if (tmp_fpmf -> num[0] > 0 && tmp_fpmf -> num[1] > 0)
     {
-      atom at[2][tmp_fmol -> multi];
+      atom_pos at[2][tmp_fmol -> multi];
       float ma[2][tmp_fmol -> multi];
       gboolean all_zero = TRUE;
       float v;
@@ -1837,9 +1837,9 @@ G_MODULE_EXPORT void selection_button (GtkButton * but, gpointer data)
             {
               v = tmp_fpmf -> weight[k][l];
             }
-            at[k][n].x += v * tmp_proj -> atoms[0][q].x;
-            at[k][n].y += v * tmp_proj -> atoms[0][q].y;
-            at[k][n].z += v * tmp_proj -> atoms[0][q].z;
+            at[k][n].x += v * tmp_proj -> pos[0][0][q];
+            at[k][n].y += v * tmp_proj -> pos[0][1][q];
+            at[k][n].z += v * tmp_proj -> pos[0][2][q];
             ma[k][n] += v;
           }
         }
@@ -1853,7 +1853,7 @@ G_MODULE_EXPORT void selection_button (GtkButton * but, gpointer data)
           at[k][n].y /= ma[k][n];
           at[k][n].z /= ma[k][n];
         }
-        v += distance_3d (& tmp_proj -> cell, 0, & at[0][n], & at[1][n]).length;
+        v += distance_3d (& tmp_proj -> cell, 0, at[0][n], at[1][n]).length;
       }
       tmp_fpmf -> av = v / tmp_fmol -> multi;
     }
@@ -528,10 +528,10 @@ extern G_MODULE_EXPORT void remove_molecule_from_field (GSimpleAction * action,
 extern G_MODULE_EXPORT void remove_atom_from_field_molecule (GSimpleAction * action, GVariant * parameter, gpointer data);
 
 // OGL utils
-extern distance distance_3d (cell_info * cell, int mdstep, atom * at, atom * bt);
-extern angle angle_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct);
-extern angle dihedral_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct, atom * dt);
-extern angle inversion_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct, atom * dt);
+extern distance distance_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt);
+extern angle angle_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt, atom_pos ct);
+extern angle dihedral_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt, atom_pos ct, atom_pos dt);
+extern angle inversion_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt, atom_pos ct, atom_pos dt);
 
 // Print
 extern gchar * parameters_info (int obj, int key,  gchar ** words, float * data);
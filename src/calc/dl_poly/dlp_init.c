@@ -959,7 +959,7 @@ int test_for_bonds (field_atom* at, field_atom* bt)
       if (tmp_proj -> atoms[0][l].faid == bt -> id)
       {
         m ++;
-        val += distance_3d (& tmp_proj -> cell, 0, & tmp_proj -> atoms[0][j], & tmp_proj -> atoms[0][l]).length;
+        val += distance_3d (& tmp_proj -> cell, 0, get_atom_pos (tmp_proj, 0, j), get_atom_pos (tmp_proj, 0, l)).length;
       }
     }
   }
@@ -1098,9 +1098,9 @@ int test_for_angles (field_atom* at,
           {
             o ++;
             val += angle_3d (& tmp_proj -> cell, 0,
-                             & tmp_proj -> atoms[0][j],
-                             & tmp_proj -> atoms[0][l],
-                             & tmp_proj -> atoms[0][n]).angle;
+                             get_atom_pos (tmp_proj, 0, j),
+                             get_atom_pos (tmp_proj, 0, l),
+                             get_atom_pos (tmp_proj, 0, n)).angle;
           }
         }
       }
@@ -1198,10 +1198,10 @@ int test_for_dihedrals (field_atom* at,
               {
                 q ++;
                 val += dihedral_3d (& tmp_proj -> cell, 0,
-                                    & tmp_proj -> atoms[0][j],
-                                    & tmp_proj -> atoms[0][l],
-                                    & tmp_proj -> atoms[0][n],
-                                    & tmp_proj -> atoms[0][p]).angle;
+                                    get_atom_pos (tmp_proj, 0, j),
+                                    get_atom_pos (tmp_proj, 0, l),
+                                    get_atom_pos (tmp_proj, 0, n),
+                                    get_atom_pos (tmp_proj, 0, p)).angle;
               }
             }
           }
@@ -1302,18 +1302,18 @@ int impropers_inversion (int n, int stru,
   if (stru == 6)
   {
     v = dihedral_3d (& tmp_proj -> cell, 0,
-                     & tmp_proj -> atoms[0][b],
-                     & tmp_proj -> atoms[0][c],
-                     & tmp_proj -> atoms[0][a],
-                     & tmp_proj -> atoms[0][d]).angle;
+                     get_atom_pos (tmp_proj, 0, b),
+                     get_atom_pos (tmp_proj, 0, c),
+                     get_atom_pos (tmp_proj, 0, a),
+                     get_atom_pos (tmp_proj, 0, d)).angle;
   }
   else
   {
     v = inversion_3d (& tmp_proj -> cell, 0,
-                      & tmp_proj -> atoms[0][a],
-                      & tmp_proj -> atoms[0][b],
-                      & tmp_proj -> atoms[0][c],
-                      & tmp_proj -> atoms[0][d]).angle;
+                      get_atom_pos (tmp_proj, 0, a),
+                      get_atom_pos (tmp_proj, 0, b),
+                      get_atom_pos (tmp_proj, 0, c),
+                      get_atom_pos (tmp_proj, 0, d)).angle;
   }
   tmp_fstr -> av += v;
   tmp_fstr -> num ++;
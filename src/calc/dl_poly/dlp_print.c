@@ -419,18 +419,18 @@ void print_dlp_improper_inversion (int di, GtkTextBuffer * buf, field_struct * d
                               if (di == 6)
                               {
                                 w += dihedral_3d (& tmp_proj -> cell, 0,
-                                                  & tmp_proj -> atoms[0][t],
-                                                  & tmp_proj -> atoms[0][u],
-                                                  & tmp_proj -> atoms[0][s],
-                                                  & tmp_proj -> atoms[0][v]).angle;
+                                                  get_atom_pos (tmp_proj, 0, t),
+                                                  get_atom_pos (tmp_proj, 0, u),
+                                                  get_atom_pos (tmp_proj, 0, s),
+                                                  get_atom_pos (tmp_proj, 0, v)).angle;
                               }
                               else
                               {
                                 w += inversion_3d (& tmp_proj -> cell, 0,
-                                                   & tmp_proj -> atoms[0][s],
-                                                   & tmp_proj -> atoms[0][t],
-                                                   & tmp_proj -> atoms[0][u],
-                                                   & tmp_proj -> atoms[0][v]).angle;
+                                                   get_atom_pos (tmp_proj, 0, s),
+                                                   get_atom_pos (tmp_proj, 0, t),
+                                                   get_atom_pos (tmp_proj, 0, u),
+                                                   get_atom_pos (tmp_proj, 0, v)).angle;
                               }
                             }
 
@@ -592,10 +592,10 @@ void print_dlp_dihedral (int dih, GtkTextBuffer * buf, field_struct * dh, int fi
                       s = tmp_fmol -> atoms_id[d][q].b;
                       h = get_active_atom (tmp_fmol -> id, r) -> list[s];
                       v += dihedral_3d (& tmp_proj -> cell, 0,
-                                        & tmp_proj -> atoms[0][e],
-                                        & tmp_proj -> atoms[0][f],
-                                        & tmp_proj -> atoms[0][g],
-                                        & tmp_proj -> atoms[0][h]).angle;
+                                        get_atom_pos (tmp_proj, 0, e),
+                                        get_atom_pos (tmp_proj, 0, f),
+                                        get_atom_pos (tmp_proj, 0, g),
+                                        get_atom_pos (tmp_proj, 0, h)).angle;
                     }
                     v /= tmp_fmol -> multi;
                     stre = g_strdup_printf ("%.3f", v);
@@ -722,9 +722,9 @@ void print_dlp_angle (int ai, GtkTextBuffer * buf, field_struct * an, int fi, Gt
                   g = tmp_fmol -> atoms_id[q][u].b;
                   h = get_active_atom (tmp_fmol -> id, e) -> list[g];
                   v += angle_3d (& tmp_proj -> cell, 0,
-                                 & tmp_proj -> atoms[0][c],
-                                 & tmp_proj -> atoms[0][f],
-                                 & tmp_proj -> atoms[0][h]).angle;
+                                 get_atom_pos (tmp_proj, 0, c),
+                                 get_atom_pos (tmp_proj, 0, f),
+                                 get_atom_pos (tmp_proj, 0, h)).angle;
                 }
                 v /= tmp_fmol -> multi;
                 strd = g_strdup_printf ("%.3f", v);
@@ -835,7 +835,7 @@ void print_dlp_bond (int bi, GtkTextBuffer * buf,  field_struct * bd, int fi, Gt
               s = tmp_fmol -> atoms_id[n][o].a;
               t = tmp_fmol -> atoms_id[n][o].b;
               u = get_active_atom (tmp_fmol -> id, s) -> list[t];
-              v += distance_3d (& tmp_proj -> cell, 0, & tmp_proj -> atoms[0][r], & tmp_proj -> atoms[0][u]).length;
+              v += distance_3d (& tmp_proj -> cell, 0, get_atom_pos (tmp_proj, 0, r), get_atom_pos (tmp_proj, 0, u)).length;
             }
             v /= tmp_fmol -> multi;
             strc = g_strdup_printf ("%.3f", v);
@@ -1647,7 +1647,7 @@ void print_dlp_config (GtkTextBuffer * buf)
           h ++;
         }
         n = tmp_fat -> list[m];
-        str = g_strdup_printf ("%f\t%f\t%f\n", tmp_proj -> atoms[0][n].x, tmp_proj -> atoms[0][n].y, tmp_proj -> atoms[0][n].z);
+        str = g_strdup_printf ("%f\t%f\t%f\n", tmp_proj -> pos[0][0][n], tmp_proj -> pos[0][1][n], tmp_proj -> pos[0][2][n]);
         print_info (str, NULL, buf);
         g_free (str);
       }
@@ -523,7 +523,7 @@ void print_lammps_atoms (GtkTextBuffer * buf)
     // molid = g_strdup_printf ("%5d", la_mol -> id+1);
     la_ats = get_print_atom (i);
     atype = g_strdup_printf ("%5d", la_ats -> id);
-    pos = g_strdup_printf ("%f\t%f\t%f", tmp_proj -> atoms[0][i].x, tmp_proj -> atoms[0][i].y, tmp_proj -> atoms[0][i].z);
+    pos = g_strdup_printf ("%f\t%f\t%f", tmp_proj -> pos[0][0][i], tmp_proj -> pos[0][1][i], tmp_proj -> pos[0][2][i]);
     // amass = g_strdup_printf ("%f", la_ats -> mass);
     /* switch ()
     {
@@ -178,6 +178,7 @@ double * xsk = NULL;
 GMainLoop * Event_loop[5];
 
 gboolean in_movie_encoding = FALSE;
+gboolean atomes_batch = FALSE;
 gboolean newspace = TRUE;
 gboolean reading_input;
 gboolean tmp_adv_bonding[2];
@@ -278,6 +278,11 @@ enum ImageFormats {
 */
 #define STEP_LIMIT 10000
 
+/*! \def FRAME_WINDOW_LIMIT
+  \brief size of the atomic coordinates, in bytes, above which only a window of MD steps is kept in memory
+*/
+#define FRAME_WINDOW_LIMIT 1073741824
+
 #define OK            0
 #define ERROR_RW      1
 #define ERROR_PROJECT 2
@@ -439,6 +444,7 @@ extern atomic_object * copied_object;
 extern GMainLoop * Event_loop[5];
 
 extern gboolean in_movie_encoding;
+extern gboolean atomes_batch;
 extern gboolean newspace;
 extern gboolean reading_input;
 extern gboolean tmp_adv_bonding[2];
@@ -882,6 +888,18 @@ struct insertion_menu
   int ats;
 };
 
+/*! \typedef atom_pos
+
+  \brief atomic coordinates
+*/
+typedef struct atom_pos atom_pos;
+struct atom_pos
+{
+  double x;                      /*!< x coordinate */
+  double y;                      /*!< y coordinate */
+  double z;                      /*!< z coordinate */
+};
+
 /*! \typedef atom
 
   \brief atom data structure
@@ -891,10 +909,7 @@ struct atom
 {
   int id;                        /*!< The atom's id in the model */ // The id in the model
   int sp;                        /*!< The chemical species */ // The chemical species
-  // The coordinates
-  double x;                      /*!< x coordinate */
-  double y;                      /*!< y coordinate */
-  double z;                      /*!< z coordinate */
+  // The coordinates are stored by the project, see 'project -> pos'
   int numv;                      /*!< The number of neighbors */ // The number of neighbors
   int * vois;                    /*!< The list of neighbors */ // The list of neighbors
   // 0 = Total coordination
@@ -933,6 +948,23 @@ struct atom
   atom * next;
 };
 
+/*! \typedef pos_window
+
+  \brief window of MD steps kept in memory for a large trajectory
+*/
+typedef struct pos_window pos_window;
+struct pos_window
+{
+  int size;                      /*!< Maximum number of MD steps in memory */
+  int num;                       /*!< Number of MD steps in memory */
+  int * steps;                   /*!< MD steps in memory, from the least to the most recently used */
+  int active;                    /*!< MD step whose data is in the atoms, -1 if none */
+  int * step_data;               /*!< Atom data of each MD step, in the file after the coordinates:
+                                      coord[0-4] then cloned, for each atom */
+  int fd;                        /*!< Descriptor of the file that stores the atomic coordinates and the atom data */
+  gsize length;                  /*!< Size of the file, in bytes */
+};
+
 /*! \typedef project
 
   \brief data structure for the 'atomes' project
@@ -960,7 +992,15 @@ struct project
   chemical_data * chemistry;           /*!< Chemical data */
   coord_info * coord;                  /*!< Coordination(s) data */
   cell_info cell;                      /*!< Periodicity data */
-  atom ** atoms;                /*!< Atom list: atoms[steps][natomes] */
+  atom ** atoms;                /*!< Atom list: atoms[steps][natomes], if 'pos_win' all MD steps point on the same atoms */
+  double * pos_store;           /*!< Atomic coordinates, one block per MD step: x[natomes], y[natomes] then z[natomes],
+                                     the Fortran90 FULLPOS(natomes,3,steps) array is bound to it */
+  double *** pos;               /*!< Atomic coordinates: pos[step][0-2][atom] for x, y and z, views on 'pos_store' */
+  pos_window * pos_win;         /*!< Window of MD steps in memory, NULL if all the coordinates are in memory,
+                                     otherwise 'pos_store' is a file mapped in memory */
+  int ** vois_csr;              /*!< Neighbor lists per MD step in CSR layout: natomes+1 offsets then the neighbor ids,
+                                      atoms[step][atom].vois points in it, NULL if the lists were allocated atom by atom */
+  int csr_steps;                /*!< Number of MD steps 'vois_csr' was allocated for */
   /*
      Analysis related parameters
   */
@@ -1073,6 +1113,7 @@ extern project * opengl_project;
 extern element_data periodic_table_info[];
 
 extern project * get_project_by_id (int p);
+extern atom_pos get_atom_pos (project * this_proj, int step, int aid);
 extern void opengl_project_changed (int id);
 extern gboolean in_md_shaders (project * this_proj, int id);
 extern void recreate_all_shaders (glwin * view);
@@ -1303,6 +1344,14 @@ extern double string_to_double (gpointer string);
 extern double get_calc_time (struct timespec start, struct timespec stop);
 extern gchar * calculation_time (gboolean modelv, double ctime);
 
+extern gboolean profiling;
+extern void init_profiling ();
+extern void profile_start (struct timespec * start);
+extern void profile_stop (const gchar * name, struct timespec * start);
+extern void profile_add (const gchar * name, struct timespec start, struct timespec stop);
+extern void profile_count (const gchar * name, gint64 value);
+extern void save_profiling ();
+
 extern int get_widget_width (GtkWidget * widg);
 extern int get_widget_height (GtkWidget * widg);
 
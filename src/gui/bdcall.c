@@ -33,6 +33,7 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
   int * save_color_map (glwin * view);
 
   gboolean run_distance_matrix (GtkWidget * widg, int calc, int up_ngb);
+  gboolean update_distance_matrix ();
 
   double get_cutoff (double s_a, double s_b);
 
@@ -360,17 +361,16 @@ gboolean run_distance_matrix (GtkWidget * widg, int calc, int up_ngb)
     {
       for (j=0; j < active_project -> natomes; j++)
       {
-        active_project -> atoms[i][j].cloned = FALSE;
-        if (active_project -> atoms[i][j].numv)
-        {
-          active_project -> atoms[i][j].numv = 0;
-          if (active_project -> atoms[i][j].vois)
-          {
-            g_free (active_project -> atoms[i][j].vois);
-            active_project -> atoms[i][j].vois = NULL;
-          }
-        }
+        set_step_clone (active_project, i, j, FALSE);
       }
+      free_step_neighbors (active_project, i);
+    }
+    // Filled step by step, possibly by several threads, in 'update_step_neighbors_'
+    if (active_project -> csr_steps != active_project -> steps)
+    {
+      free_neighbor_lists (active_project);
+      active_project -> vois_csr = g_malloc0 (active_project -> steps*sizeof*active_project -> vois_csr);
+      active_project -> csr_steps = active_project -> steps;
     }
   }
   prepostcalc (widg, FALSE, -1, (active_project -> steps > 1) ? 1 : 0, opac);
@@ -393,6 +393,23 @@ gboolean run_distance_matrix (GtkWidget * widg, int calc, int up_ngb)
   prepostcalc (widg, TRUE, -1, 0, 1.0);
   clock_gettime (CLOCK_MONOTONIC, & stop_time);
   g_print ("Time to calculate distance matrix: %s\n", calculation_time(FALSE, get_calc_time (start_time, stop_time)));
+  profile_add ("rundmtx", start_time, stop_time);
+  return res;
+}
+
+/*!
+  \fn gboolean update_distance_matrix ()
+
+  \brief update the distance matrix for the atom(s) moved since the last calculation,
+  return FALSE if the complete distance matrix must be computed instead
+*/
+gboolean update_distance_matrix ()
+{
+  gboolean res;
+  clock_gettime (CLOCK_MONOTONIC, & start_time);
+  res = update_dmtx_ ();
+  clock_gettime (CLOCK_MONOTONIC, & stop_time);
+  if (res) profile_add ("update_dmtx", start_time, stop_time);
   return res;
 }
 
@@ -551,6 +568,7 @@ G_MODULE_EXPORT void on_calc_bonds_released (GtkWidget * widg, gpointer data)
       j = bonding_ (& m, & l, & bonding, & active_project -> num_delta[BD], & active_project -> min[BD], & active_project -> delta[BD], active_project -> bondfile);
       clock_gettime (CLOCK_MONOTONIC, & stop_time);
       active_project -> calc_time[BD] = get_calc_time (start_time, stop_time);
+      profile_add ("bonding", start_time, stop_time);
       active_project -> runok[SP] = j;
       prepostcalc (widg, bonding, BD, (bonding) ? j : vis_bd, 1.0);
       if (! j)
@@ -564,9 +582,8 @@ G_MODULE_EXPORT void on_calc_bonds_released (GtkWidget * widg, gpointer data)
         if (frag_update)
         {
           prepostcalc (widg, FALSE, -1, statusb, opac);
-          k = active_glwin -> allbonds[0] + active_glwin -> allbonds[1];
           clock_gettime (CLOCK_MONOTONIC, & start_time);
-          if (! molecules_ (& mol_update, & k))
+          if (! molecules_ (& mol_update))
           {
             show_error ("Unexpected error when looking for isolated fragment(s) and molecule(s)", 0, (widg) ? widg : MainWindow);
             if (active_glwin)
@@ -600,6 +617,7 @@ G_MODULE_EXPORT void on_calc_bonds_released (GtkWidget * widg, gpointer data)
           clock_gettime (CLOCK_MONOTONIC, & stop_time);
           // Using the RI slot to store Frag-mol calc time.
           active_project -> calc_time[RI] = get_calc_time (start_time, stop_time);
+          profile_add ("molecules", start_time, stop_time);
           active_project_changed (activep);
           prepostcalc (widg, TRUE, -1, statusb, 1.0);
           if (widg != NULL) show_the_widgets (curvetoolbox);
@@ -628,6 +646,7 @@ G_MODULE_EXPORT void on_calc_bonds_released (GtkWidget * widg, gpointer data)
         j = bond_diedrals_ (& active_project -> num_delta[AN]);
         clock_gettime (CLOCK_MONOTONIC, & stop_time);
         active_project -> calc_time[AN] = get_calc_time (start_time, stop_time);
+        profile_add ("angles", start_time, stop_time);
         if (! j)
         {
           show_error ("Unexpected error when calculating the dihedral angles distribution", 0, (widg) ? widg : MainWindow);
@@ -1442,6 +1442,8 @@ G_MODULE_EXPORT void run_on_calc_activate (GtkDialog * dial, gint response_id, g
         default:
           break;
       }
+      // The analysis went through all MD steps: only the window of MD steps remains in memory
+      release_pos_window (active_project);
       break;
     default:
       frag_update = mol_update = 0;
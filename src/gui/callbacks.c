@@ -45,6 +45,7 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
   void apply_project (gboolean showtools);
   void open_this_isaacs_xml_file (gchar * profile, int ptoc, gboolean visible);
   void to_read_pos ();
+  void shift_crystal_pos (double dir);
   void check_read_sa ();
   void update_sa_info (int sid);
   void prepare_sp_box ();
@@ -644,8 +645,10 @@ void run_project ()
                 & active_cell -> frac,
                 & active_cell -> pbc);
     }
+    if (active_cell -> crystal) shift_crystal_pos (1.0);
     to_read_pos ();
     prep_pos_ (& active_cell -> pbc, & active_cell -> frac);
+    release_pos_window (active_project);
     if (active_project -> numwid < 0) initcwidgets ();
     active_project -> dmtx = FALSE;
     active_project -> run = 1;
@@ -824,43 +827,39 @@ G_MODULE_EXPORT void on_isaacs_port (GtkWidget * widg, gpointer data)
 /*!
   \fn void to_read_pos ()
 
-  \brief send atomic coordinates to Fortran90
+  \brief send atomic coordinates to Fortran90:
+  the Fortran90 FULLPOS array is bound to the coordinates of the project, that are not copied
 */
 void to_read_pos ()
 {
-  int i, j, k;
-  double * x, * y, * z;
-  double lat[3];
+  bind_pos_ (active_project -> pos_store);
+}
+
+/*!
+  \fn void shift_crystal_pos (double dir)
+
+  \brief shift the atomic coordinates of a crystal by half the sum of the lattice vectors
 
-  x = allocdouble(active_project -> steps*active_project -> natomes);
-  y = allocdouble(active_project -> steps*active_project -> natomes);
-  z = allocdouble(active_project -> steps*active_project -> natomes);
-  k = 0;
-  lat[0] = lat[1] = lat[2] = 0.0;
-  if (active_cell -> crystal)
+  \param dir 1.0 to center the crystal at the origin, -1.0 to shift it back
+*/
+void shift_crystal_pos (double dir)
+{
+  int i, j;
+  double lat[3];
+  for (i=0; i<3; i++)
   {
-    for (i=0; i<3; i++)
-    {
-      for (j=0; j<3; j++) lat[i] -= active_box -> vect[j][i]/2.0;
-    }
+    lat[i] = 0.0;
+    for (j=0; j<3; j++) lat[i] -= dir*active_box -> vect[j][i]/2.0;
   }
   for (i=0; i<active_project -> steps; i++)
   {
     for (j=0; j<active_project -> natomes; j++)
     {
-      x[k] = active_project -> atoms[i][j].x + lat[0];
-      y[k] = active_project -> atoms[i][j].y + lat[1];
-      z[k] = active_project -> atoms[i][j].z + lat[2];
-      k ++;
+      active_project -> pos[i][0][j] += lat[0];
+      active_project -> pos[i][1][j] += lat[1];
+      active_project -> pos[i][2][j] += lat[2];
     }
   }
-  read_pos_ (x, y, z);
-  g_free (x);
-  x = NULL;
-  g_free (y);
-  y = NULL;
-  g_free (z);
-  z = NULL;
 }
 
 GtkWidget * read_box;
@@ -1341,6 +1340,8 @@ int open_coordinate_file (int id)
   }
   clock_gettime (CLOCK_MONOTONIC, & sto_time);
   g_print ("Time to read atomic coordinates: %s\n", calculation_time(FALSE, get_calc_time (sta_time, sto_time)));
+  profile_add ("read coordinates", sta_time, sto_time);
+  if (! result) profile_count ("coordinates read", (gint64)active_project -> natomes*active_project -> steps);
   if (this_reader)
   {
     if (this_reader -> msg && (! silent_input || cif_use_symmetry_positions))
@@ -1407,6 +1408,7 @@ int open_coordinate_file (int id)
         }
         clock_gettime (CLOCK_MONOTONIC, & sto_time);
         g_print ("Time to prepare data: %s\n", calculation_time(FALSE, get_calc_time (sta_time, sto_time)));
+        profile_add ("prep_data", sta_time, sto_time);
       }
       break;
   }
@@ -1564,6 +1566,7 @@ G_MODULE_EXPORT void run_on_coord_port (GtkDialog * info, gint response_id, gpoi
                       & active_cell -> frac,
                       & active_cell -> pbc);
           }
+          if (active_cell -> crystal) shift_crystal_pos (1.0);
           to_read_pos ();
         }
         int length = strlen (active_project -> coordfile);
@@ -1581,6 +1584,8 @@ G_MODULE_EXPORT void run_on_coord_port (GtkDialog * info, gint response_id, gpoi
             k = write_c3d_ (active_project -> coordfile, & length, & active_cell -> frac, & car_to_au);
             break;
         }
+        if (j < 2 && active_cell -> crystal) shift_crystal_pos (-1.0);
+        release_pos_window (active_project);
         if (k)
         {
           tmp_str = g_strdup_printf ("Impossible to export the atomic coordinates\nError code: %d", k);
@@ -46,6 +46,7 @@ G_MODULE_EXPORT void on_isaacs_port (GtkWidget * widg, gpointer data);
 extern void open_this_coordinate_file (int format, gchar * proj_name);
 G_MODULE_EXPORT void on_coord_port (GtkWidget * widg, gpointer data);
 void to_read_pos ();
+void shift_crystal_pos (double dir);
 void display_distances ();
 void run_project ();
 void apply_project (gboolean showtools);
@@ -316,7 +316,7 @@ G_MODULE_EXPORT void on_calc_chains_released (GtkWidget * widg, gpointer data)
     {
       active_glwin -> all_chains[j] = g_malloc0 (active_project -> csparam[5]*sizeof*active_glwin -> all_chains[j]);
       active_glwin -> num_chains[j] = allocint (active_project -> csparam[5]);
-      for (k=0; k < active_project -> natomes; k++)
+      for (k=0; k < active_project -> natomes && j < atom_steps (active_project); k++)
       {
         if (active_project -> atoms[j][k].chain) g_free (active_project -> atoms[j][k].chain);
         active_project -> atoms[j][k].chain = NULL;
@@ -335,6 +335,7 @@ G_MODULE_EXPORT void on_calc_chains_released (GtkWidget * widg, gpointer data)
                      & active_project -> csearch);
     clock_gettime (CLOCK_MONOTONIC, & stop_time);
     active_project -> calc_time[CH] = get_calc_time (start_time, stop_time);
+    profile_add ("chains", start_time, stop_time);
     if (j == 0)
     {
       show_error ("The chain statistics calculation has failed", 0, widg);
@@ -207,6 +207,7 @@ G_MODULE_EXPORT void on_calc_gr_released (GtkWidget * widg, gpointer data)
   i = g_of_r_ (& active_project -> num_delta[GR], & active_project -> delta[GR], & fitc);
   clock_gettime (CLOCK_MONOTONIC, & stop_time);
   active_project -> calc_time[GR] = get_calc_time (start_time, stop_time);
+  profile_add ("g(r)", start_time, stop_time);
   prepostcalc (widg, TRUE, GR, i, 1.0);
   if (! i)
   {
@@ -330,6 +331,7 @@ G_MODULE_EXPORT void on_calc_gq_released (GtkWidget * widg, gpointer data)
                    & active_project -> max[GK]);
   clock_gettime (CLOCK_MONOTONIC, & stop_time);
   active_project -> calc_time[GK] = get_calc_time (start_time, stop_time);
+  profile_add ("g(r) FFT", start_time, stop_time);
   prepostcalc (widg, TRUE, GK, i, 1.0);
   if (! i)
   {
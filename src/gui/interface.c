@@ -243,9 +243,16 @@ void show_info (char * information, int val, GtkWidget * win)
     info = g_strdup_printf ("%s", information);
   }
 
-  GtkWidget * dialog = message_dialogmodal (info, "Information", GTK_MESSAGE_INFO, GTK_BUTTONS_OK, win);
-  if (val != 0) show_web (dialog, (val < 0) ? 0 : val);
-  run_this_gtk_dialog (dialog, G_CALLBACK(run_destroy_dialog), NULL);
+  if (atomes_batch)
+  {
+    g_print ("%s\n", info);
+  }
+  else
+  {
+    GtkWidget * dialog = message_dialogmodal (info, "Information", GTK_MESSAGE_INFO, GTK_BUTTONS_OK, win);
+    if (val != 0) show_web (dialog, (val < 0) ? 0 : val);
+    run_this_gtk_dialog (dialog, G_CALLBACK(run_destroy_dialog), NULL);
+  }
   g_free (info);
 }
 
@@ -259,6 +266,11 @@ void show_info (char * information, int val, GtkWidget * win)
 */
 void show_warning (char * warning, GtkWidget * win)
 {
+  if (atomes_batch)
+  {
+    g_warning ("%s", warning);
+    return;
+  }
   GtkWidget * dialog = message_dialogmodal (warning,  "Warning", GTK_MESSAGE_WARNING, GTK_BUTTONS_OK, win);
   run_this_gtk_dialog (dialog, G_CALLBACK(run_destroy_dialog), NULL);
 }
@@ -301,10 +313,14 @@ void show_error (char * error, int val, GtkWidget * win)
   {
     etot = g_strdup_printf ("%s\n%s", error, ifbug);
   }
-  GtkWidget * dialog = message_dialogmodal (etot, "Error", GTK_MESSAGE_ERROR, GTK_BUTTONS_OK, win);
-  show_web (dialog, val);
   g_warning ("%s", etot);
-  run_this_gtk_dialog (dialog, G_CALLBACK(run_destroy_dialog), NULL);
+  // No dialog in batch mode, there might not even be a display
+  if (! atomes_batch)
+  {
+    GtkWidget * dialog = message_dialogmodal (etot, "Error", GTK_MESSAGE_ERROR, GTK_BUTTONS_OK, win);
+    show_web (dialog, val);
+    run_this_gtk_dialog (dialog, G_CALLBACK(run_destroy_dialog), NULL);
+  }
   g_free (etot);
 }
 
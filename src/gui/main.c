@@ -41,6 +41,7 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 
   void printhelp();
   void printversion ();
+  void init_atomes_config ();
   void read_this_file (int file_type, gchar * this_file);
   void open_this_data_file (int file_type, gchar * file_name);
 
@@ -72,6 +73,7 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 #endif
 
 extern GtkWidget * create_main_window (GApplication * app);
+extern int batch_render (int argc, char * argv[]);
 
 const gchar * dfi[2];
 struct file_list {
@@ -117,11 +119,26 @@ void printhelp()
                    "       ATOMES [FILE]\n"
                    "       ATOMES [OPTION] [FILE]\n"
                    "       ATOMES [FILE1] [FILE2] ...\n"
-                   "       ATOMES [OPTION1] [FILE1] [OPTION2] [FILE2] ...\n\n"
+                   "       ATOMES [OPTION1] [FILE1] [OPTION2] [FILE2] ...\n"
+                   "       ATOMES --batch [BATCH OPTION] ... -o OUTPUT [FILE]\n\n"
                    "3D atomistic model analysis, creation/edition and post-processing tool\n\n"
                    "options:\n"
                    "  -v, --version             version information\n"
                    "  -h, --help                display this help message\n\n"
+                   "batch rendering, without graphical interface (Linux, EGL):\n\n"
+                   "  --batch                   render images or a movie of a project or coordinate file\n"
+                   "  -o, --output FILE         output file, the extension selects the format:\n"
+                   "                              images: .png, .jpg, .tiff, .bmp\n"
+                   "                              movies: .mpeg, .avi, .mkv, .mp4, .ogv, .flv\n"
+                   "  --size WIDTHxHEIGHT       image size in pixels (default: 1024x768)\n"
+                   "  --steps FIRST[:LAST[:N]]  MD step(s) to render, one image per step,\n"
+                   "                            or one movie frame per step (default: all for a movie)\n"
+                   "  --quality N               OpenGL quality [1-1000] (default: project image)\n"
+                   "  --fps N                   movie frames per second (default: 24)\n"
+                   "  --bitrate N               movie bitrate in kb/s (default: 5000)\n\n"
+                   "profiling, using environment variables:\n\n"
+                   "  ATOMES_PROFILE=FILE       save timers and counters summary (JSON)\n"
+                   "  ATOMES_TRACE=FILE         save timers and counters events (Chrome trace)\n\n"
                    "files, any number, in any order, in the following formats:\n\n"
                    "  Atomes workspace file: .awf\n"
                    "  Atomes prject file: .apf\n"
@@ -643,6 +660,38 @@ int check_opengl_rendering ()
   return res;
 }
 
+/*!
+  \fn void init_atomes_config ()
+
+  \brief set the user configuration directory and preferences file names
+*/
+void init_atomes_config ()
+{
+#ifdef G_OS_WIN32
+  PWSTR localPath = NULL;
+  HRESULT hr = SHGetKnownFolderPath (& FOLDERID_LocalAppData, 0, NULL, & localPath);
+  if (FAILED(hr))
+  {
+    fprintf (stderr, "Error impossible to obtain the AppData\\Roaming (code 0x%08lx)\n%s", hr);
+    ATOMES_CONFIG_DIR = NULL;
+    ATOMES_CONFIG = NULL;
+  }
+  else
+  {
+    char appdata[MAX_PATH];
+    wcstombs (appdata, localPath, MAX_PATH);
+    CoTaskMemFree (localPath);  // libérer mémoire retournée par SHGetKnownFolderPath
+    // Build the folder path for atomes
+    ATOMES_CONFIG_DIR = g_strdup_printf ("%s\\atomes", appdata);
+    ATOMES_CONFIG = g_strdup_printf ("%s\\atomes.pml", ATOMES_CONFIG_DIR);
+  }
+#else
+  struct passwd * pw = getpwuid(getuid());
+  ATOMES_CONFIG_DIR = g_strdup_printf ("%s/.config/atomes", pw -> pw_dir);
+  ATOMES_CONFIG = g_strdup_printf ("%s/atomes.pml", ATOMES_CONFIG_DIR);
+#endif
+}
+
 /*!
   \fn int main (int argc, char *argv[])
 
@@ -719,6 +768,16 @@ int main (int argc, char *argv[])
   PACKAGE_SGTC = g_build_filename (PACKAGE_PREFIX, "pixmaps/bravais/Triclinic.png", NULL);
 
   int i, j, k;
+  if (argc > 1 && g_strcmp0 (argv[1], "--batch") == 0)
+  {
+    // Rendering without graphical interface, nor OpenGL window
+    init_atomes_config ();
+    set_atomes_preferences ();
+    init_profiling ();
+    i = batch_render (argc, argv);
+    save_profiling ();
+    return i;
+  }
   switch (argc)
   {
     case 1:
@@ -828,29 +887,7 @@ int main (int argc, char *argv[])
 #endif
     atomes_visual = ! (abs(atomes_visual));
 
-#ifdef G_OS_WIN32
-    PWSTR localPath = NULL;
-    HRESULT hr = SHGetKnownFolderPath (& FOLDERID_LocalAppData, 0, NULL, & localPath);
-    if (FAILED(hr))
-    {
-      fprintf (stderr, "Error impossible to obtain the AppData\\Roaming (code 0x%08lx)\n%s", hr);
-      ATOMES_CONFIG_DIR = NULL;
-      ATOMES_CONFIG = NULL;
-    }
-    else
-    {
-      char appdata[MAX_PATH];
-      wcstombs (appdata, localPath, MAX_PATH);
-      CoTaskMemFree (localPath);  // libérer mémoire retournée par SHGetKnownFolderPath
-      // Build the folder path for atomes
-      ATOMES_CONFIG_DIR = g_strdup_printf ("%s\\atomes", appdata);
-      ATOMES_CONFIG = g_strdup_printf ("%s\\atomes.pml", ATOMES_CONFIG_DIR);
-    }
-#else
-    struct passwd * pw = getpwuid(getuid());
-    ATOMES_CONFIG_DIR = g_strdup_printf ("%s/.config/atomes", pw -> pw_dir);
-    ATOMES_CONFIG = g_strdup_printf ("%s/atomes.pml", ATOMES_CONFIG_DIR);
-#endif
+    init_atomes_config ();
     set_atomes_preferences ();
     // setlocale(LC_ALL,"en_US");
     gtk_disable_setlocale ();
@@ -862,7 +899,9 @@ int main (int argc, char *argv[])
     GError * error = NULL;
     g_application_register (G_APPLICATION(AtomesApp), NULL, & error);
     g_signal_connect (G_OBJECT(AtomesApp), "activate", G_CALLBACK(run_program), NULL);
+    init_profiling ();
     int status = g_application_run (G_APPLICATION (AtomesApp), 0, NULL);
+    save_profiling ();
     g_object_unref (AtomesApp);
     return status;
   }
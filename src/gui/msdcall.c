@@ -163,6 +163,7 @@ G_MODULE_EXPORT void on_calc_msd_released (GtkWidget * widg, gpointer data)
   i = msd_ (& active_project -> delta[MS], & active_project -> num_delta[MS]);
   clock_gettime (CLOCK_MONOTONIC, & stop_time);
   active_project -> calc_time[MS] = get_calc_time (start_time, stop_time);
+  profile_add ("MSD", start_time, stop_time);
   prepostcalc (widg, TRUE, MS, i, 1.0);
   if (! i)
   {
@@ -182,6 +182,8 @@ int * default_num_delta = NULL;   /*!< Number of x points: \n 0 = gr, \n 1 = sq,
 int * tmp_num_delta = NULL;
 double * default_delta_t = NULL;  /*!< 0 = time step, \n 1 = time unit , in: fs, ps, ns, µs, ms */
 double * tmp_delta_t = NULL;
+int default_frame_window;         /*!< Number of MD steps kept in memory for large trajectories, 0 = all MD steps */
+int tmp_frame_window;
 
 int * default_rsparam = NULL;     /*!< Ring statistics parameters: \n
                                        0 = Default search, \n
@@ -571,6 +573,11 @@ int save_preferences_to_xml_file ()
     g_free (str);
     if (! rc) return 0;
   }
+  // MD steps in memory
+  str = g_strdup_printf ("%d", default_frame_window);
+  rc = xml_save_parameter_to_file (writer, "MD steps in memory", "default_frame_window", TRUE, 0, str);
+  g_free (str);
+  if (! rc) return 0;
   // Rings
   for (i=0; i<7; i++)
   {
@@ -1251,6 +1258,10 @@ void set_parameter (gchar * content, gchar * key, int vid, dint * bond, vec3_t *
   {
     default_delta_t[vid] = xml_string_to_double(content);
   }
+  else if (g_strcmp0(key, "default_frame_window") == 0)
+  {
+    default_frame_window = (int)xml_string_to_double(content);
+  }
   else if (g_strcmp0(key, "default_rsparam") == 0)
   {
     default_rsparam[vid] = (int)xml_string_to_double(content);
@@ -2065,6 +2076,7 @@ void set_atomes_defaults ()
   default_num_delta[MS-2] = 0;
   default_delta_t[0] = 0.0;
   default_delta_t[1] = -1.0;
+  default_frame_window = 64;
 
   default_rsparam[0] = -1;
   default_rsparam[1] = 0;
@@ -3799,11 +3811,16 @@ G_MODULE_EXPORT void set_default_num_delta (GtkEntry * res, gpointer data)
     if (value > 0) tmp_num_delta[i] = (int) value;
     update_entry_int (res, tmp_num_delta[i]);
   }
-  else
+  else if (i == 8)
   {
     if (value > 0.0) tmp_delta_t[0] = value;
     update_entry_double (res, tmp_delta_t[0]);
   }
+  else
+  {
+    if (value >= 0.0) tmp_frame_window = (int) value;
+    update_entry_int (res, tmp_frame_window);
+  }
 }
 
 /*!
@@ -4220,6 +4237,19 @@ GtkWidget * calc_preferences ()
 
   add_box_child_start (GTK_ORIENTATION_VERTICAL, vbox, hbox, FALSE, FALSE, 5);
 
+  hbox = create_hbox (BSEP);
+  add_box_child_start (GTK_ORIENTATION_HORIZONTAL, hbox, markup_label ("<b>Large trajectories</b>:", 310, -1, 0.0, 0.5), FALSE, FALSE, 15);
+  add_box_child_start (GTK_ORIENTATION_VERTICAL, vbox, hbox, FALSE, FALSE, 5);
+  hbox = create_hbox (BSEP);
+  add_box_child_start (GTK_ORIENTATION_HORIZONTAL, hbox, markup_label ("MD steps kept in memory <sup>*</sup>", 285, -1, 0.0, 0.5), FALSE, FALSE, 30);
+  entry = create_entry (G_CALLBACK(set_default_num_delta), 110, 10, FALSE, GINT_TO_POINTER(9));
+  update_entry_int ((GtkEntry *)entry, tmp_frame_window);
+  add_box_child_start (GTK_ORIENTATION_HORIZONTAL, hbox, entry, FALSE, FALSE, 0);
+  add_box_child_start (GTK_ORIENTATION_VERTICAL, vbox, hbox, FALSE, FALSE, 5);
+
+  add_box_child_start (GTK_ORIENTATION_VERTICAL, vbox, markup_label(" ", -1, 20, 0.0, 0.0), FALSE, FALSE, 0);
+  append_comments (vbox, "<sup>*</sup>", "When the atomic coordinates exceed 1 GB, 0 to keep all MD steps in memory.");
+
   gtk_notebook_append_page (GTK_NOTEBOOK(notebook), vbox, gtk_label_new ("Calculations"));
 
   for (i=0; i<2; i++)
@@ -4445,6 +4475,7 @@ void prepare_tmp_default ()
   tmp_bond_cutoff = duplicate_cutoffs (default_bond_cutoff);
   tmp_num_delta = duplicate_int (8, default_num_delta);
   tmp_delta_t = duplicate_double (2, default_delta_t);
+  tmp_frame_window = default_frame_window;
   tmp_rsparam = duplicate_int (7, default_rsparam);
   tmp_csparam = duplicate_int (7, default_csparam);
   tmp_opengl = duplicate_int (4, default_opengl);
@@ -4572,6 +4603,7 @@ void save_preferences ()
   }
   default_num_delta = duplicate_int (8, tmp_num_delta);
   default_delta_t = duplicate_double (2, tmp_delta_t);
+  default_frame_window = tmp_frame_window;
   if (default_rsparam)
   {
     g_free (default_rsparam);
@@ -106,6 +106,7 @@ extern bond_cutoff * tmp_bond_cutoff;
 extern int * default_num_delta;
 extern int * tmp_num_delta;
 extern double * default_delta_t;
+extern int default_frame_window;
 extern gchar * default_ring_param[7] ;
 extern int * default_rsparam;
 extern int * tmp_rsparam;
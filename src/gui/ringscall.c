@@ -479,7 +479,7 @@ G_MODULE_EXPORT void on_calc_rings_released (GtkWidget * widg, gpointer data)
       active_glwin -> all_rings[i][j] = g_malloc0 (active_project -> rsparam[i][1]*sizeof*active_glwin -> all_rings[i][j]);
       active_glwin -> num_rings[i][j] = allocint (active_project -> rsparam[i][1]);
       active_glwin -> show_rpoly[i][j] = g_malloc (active_project -> rsparam[i][1]*sizeof*active_glwin -> show_rpoly[i][j]);
-      for (k=0; k < active_project -> natomes; k++)
+      for (k=0; k < active_project -> natomes && j < atom_steps (active_project); k++)
       {
         active_project -> atoms[j][k].rings[i] = g_malloc0 (active_project -> rsparam[i][1]*sizeof*active_project -> atoms[j][k].rings[i]);
       }
@@ -494,6 +494,7 @@ G_MODULE_EXPORT void on_calc_rings_released (GtkWidget * widg, gpointer data)
                     & active_project -> rsparam[i][3]);
     clock_gettime (CLOCK_MONOTONIC, & stop_time);
     active_project -> rsdata[i][4] = get_calc_time (start_time, stop_time);
+    profile_add ("rings", start_time, stop_time);
     if (j == 0)
     {
       show_error ("The ring statistics calculation has failed", 0, widg);
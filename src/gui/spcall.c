@@ -211,6 +211,7 @@ G_MODULE_EXPORT void on_calc_sph_released (GtkWidget * widg, gpointer data)
     }
     clock_gettime (CLOCK_MONOTONIC, & stop_time);
     active_project -> calc_time[SP] = get_calc_time (start_time, stop_time);
+    profile_add ("spherical harmonics", start_time, stop_time);
     if (l != active_project -> numc[SP])
     {
       i = 0;
@@ -203,6 +203,7 @@ G_MODULE_EXPORT void on_calc_sq_released (GtkWidget * widg, gpointer data)
                & active_project -> num_delta[SQ]);
   clock_gettime (CLOCK_MONOTONIC, & stop_time);
   active_project -> calc_time[SQ] = get_calc_time (start_time, stop_time);
+  profile_add ("S(q)", start_time, stop_time);
   prepostcalc (widg, TRUE, SQ, i, 1.0);
   if (! i)
   {
@@ -266,6 +267,7 @@ G_MODULE_EXPORT void on_calc_sk_released (GtkWidget * widg, gpointer data)
     j = s_of_k_ (& active_project -> num_delta[SK], & active_project -> xcor);
     clock_gettime (CLOCK_MONOTONIC, & stop_time);
     active_project -> calc_time[SK] = get_calc_time (start_time, stop_time);
+    profile_add ("S(k)", start_time, stop_time);
     g_free (xsk);
     xsk = NULL;
     active_project -> runok[GK] = j;
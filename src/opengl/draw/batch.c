@@ -0,0 +1,540 @@
+/* This file is part of the 'atomes' software
+
+'atomes' is free software: you can redistribute it and/or modify it under the terms
+of the GNU Affero General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+'atomes' is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License along with 'atomes'.
+If not, see <https://www.gnu.org/licenses/>
+
+Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
+
+/*!
+* @file batch.c
+* @short Functions to render images and movies from the command line, without OpenGL window
+* @author Sébastien Le Roux <sebastien.leroux@ipcms.unistra.fr>
+*/
+
+/*
+* This file: 'batch.c'
+*
+* Contains:
+*
+
+ - The functions to render images and movies from the command line, without OpenGL window
+
+*
+* List of functions:
+
+  int batch_render (int argc, char * argv[]);
+
+  static gboolean init_batch_context ();
+  static gboolean batch_open_file (int file_type, gchar * file_name);
+  static gboolean batch_read_options (int argc, char * argv[]);
+  static gboolean batch_render_images (glwin * view);
+  static gboolean batch_render_movie (glwin * view);
+
+  static int batch_output_format (gchar * file, gboolean * movie);
+
+  void create_batch_model (project * this_proj);
+
+  static void close_batch_context ();
+
+  static gchar * batch_image_name (gchar * file, int stp);
+
+*/
+
+#include "global.h"
+#include "interface.h"
+#include "callbacks.h"
+#include "project.h"
+#include "glwindow.h"
+#include "glview.h"
+#include "movie.h"
+#include "bind.h"
+
+#ifdef LINUX
+#include <epoxy/egl.h>
+#endif
+
+extern int test_this_arg (gchar * arg);
+extern int open_coordinate_file (int id);
+extern void init_glwin (glwin * view);
+extern void add_image ();
+extern gboolean create_movie (glwin * view, video_options * vopts, gchar * videofile);
+extern void fill_image (VideoStream * vs, int width, int height, glwin * view);
+extern void init_frame_buffer (int x, int y);
+extern void close_frame_buffer ();
+extern GdkPixbuf * pixbuf;
+extern char * image_list[IMAGE_FORMATS];
+extern char * codec_list[VIDEO_CODECS];
+
+// The batch rendering request, read from the command line
+static gchar * batch_input = NULL;
+static int batch_input_type = 0;
+static gchar * batch_output = NULL;
+static int batch_res[2] = {1024, 768};
+static int batch_steps[3] = {0, 0, 1};
+static int batch_quality = 0;
+static int batch_fps = 24;
+static int batch_bitrate = 5000;
+
+#ifdef LINUX
+static EGLDisplay batch_display = EGL_NO_DISPLAY;
+static EGLContext batch_context = EGL_NO_CONTEXT;
+static EGLSurface batch_surface = EGL_NO_SURFACE;
+#endif
+
+/*!
+  \fn static gboolean init_batch_context ()
+
+  \brief create and make current an OpenGL context without window, all rendering goes to the frame buffer
+*/
+static gboolean init_batch_context ()
+{
+#ifdef LINUX
+  EGLint major, minor;
+  EGLint num_configs;
+  EGLConfig config;
+  EGLint config_attribs[] = {EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                             EGL_RED_SIZE, 8,
+                             EGL_GREEN_SIZE, 8,
+                             EGL_BLUE_SIZE, 8,
+                             EGL_DEPTH_SIZE, 24,
+                             EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                             EGL_NONE};
+  EGLint pbuffer_attribs[] = {EGL_WIDTH, 1,
+                              EGL_HEIGHT, 1,
+                              EGL_NONE};
+
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+  // No display server required: the driver renders directly on the GPU, or in software
+  if (epoxy_has_egl_extension (EGL_NO_DISPLAY, "EGL_MESA_platform_surfaceless"))
+  {
+    batch_display = eglGetPlatformDisplayEXT (EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+  }
+#endif
+  if (batch_display == EGL_NO_DISPLAY) batch_display = eglGetDisplay (EGL_DEFAULT_DISPLAY);
+  if (batch_display == EGL_NO_DISPLAY || ! eglInitialize (batch_display, & major, & minor))
+  {
+    g_warning ("BATCH:: impossible to initialize the EGL display");
+    return FALSE;
+  }
+  if (! eglBindAPI (EGL_OPENGL_API))
+  {
+    g_warning ("BATCH:: EGL does not support desktop OpenGL");
+    return FALSE;
+  }
+  if (! eglChooseConfig (batch_display, config_attribs, & config, 1, & num_configs) || num_configs < 1)
+  {
+    g_warning ("BATCH:: no suitable EGL configuration");
+    return FALSE;
+  }
+  batch_context = eglCreateContext (batch_display, config, EGL_NO_CONTEXT, NULL);
+  if (batch_context == EGL_NO_CONTEXT)
+  {
+    g_warning ("BATCH:: impossible to create the OpenGL context");
+    return FALSE;
+  }
+  // The frame buffer object is the only render target, a surface is only used if mandatory
+  if (! epoxy_has_egl_extension (batch_display, "EGL_KHR_surfaceless_context"))
+  {
+    batch_surface = eglCreatePbufferSurface (batch_display, config, pbuffer_attribs);
+  }
+  if (! eglMakeCurrent (batch_display, batch_surface, batch_surface, batch_context))
+  {
+    g_warning ("BATCH:: impossible to use the OpenGL context");
+    return FALSE;
+  }
+  g_print ("OpenGL rendering, EGL %d.%d: %s\n", major, minor, (const char *)glGetString (GL_RENDERER));
+  return TRUE;
+#else
+  g_warning ("BATCH:: rendering without OpenGL window is only available on Linux");
+  return FALSE;
+#endif
+}
+
+/*!
+  \fn static void close_batch_context ()
+
+  \brief release the OpenGL context used for batch rendering
+*/
+static void close_batch_context ()
+{
+#ifdef LINUX
+  if (batch_display == EGL_NO_DISPLAY) return;
+  eglMakeCurrent (batch_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+  if (batch_surface != EGL_NO_SURFACE) eglDestroySurface (batch_display, batch_surface);
+  if (batch_context != EGL_NO_CONTEXT) eglDestroyContext (batch_display, batch_context);
+  eglTerminate (batch_display);
+  batch_display = EGL_NO_DISPLAY;
+#endif
+}
+
+/*!
+  \fn void create_batch_model (project * this_proj)
+
+  \brief create the glwin of a project without any widget, the batch OpenGL context must be current
+
+  \param this_proj the target project
+*/
+void create_batch_model (project * this_proj)
+{
+  this_proj -> modelgl = g_malloc0 (sizeof*this_proj -> modelgl);
+  this_proj -> modelgl -> init = FALSE;
+  this_proj -> modelgl -> proj = this_proj -> id;
+  this_proj -> modelgl -> pixels[0] = batch_res[0];
+  this_proj -> modelgl -> pixels[1] = batch_res[1];
+  init_glwin (this_proj -> modelgl);
+}
+
+/*!
+  \fn static gboolean batch_open_file (int file_type, gchar * file_name)
+
+  \brief read a project or a coordinate file, without dialog
+
+  \param file_type the file type, as returned by 'test_this_arg'
+  \param file_name the file name
+*/
+static gboolean batch_open_file (int file_type, gchar * file_name)
+{
+  FILE * fp;
+  int i;
+  if (file_type == 2)
+  {
+    fp = fopen (file_name, "rb");
+    if (! fp) return FALSE;
+    init_project (FALSE);
+    reading_input = TRUE;
+    i = open_project (fp, 0);
+    reading_input = FALSE;
+    fclose (fp);
+    if (i != 0)
+    {
+      g_warning ("BATCH:: impossible to open project file: %s, error code: %d", file_name, i);
+      return FALSE;
+    }
+    active_project -> projfile = g_strdup_printf ("%s", file_name);
+  }
+  else
+  {
+    init_project (TRUE);
+    active_project -> coordfile = g_strdup_printf ("%s", file_name);
+    active_project -> newproj = FALSE;
+    if (open_coordinate_file (file_type-3) != 0)
+    {
+      g_warning ("BATCH:: impossible to open coordinate file: %s", file_name);
+      return FALSE;
+    }
+    active_project -> tfile = file_type-3;
+    active_project -> name = g_path_get_basename (file_name);
+    initcutoffs (active_chem, active_project -> nspec);
+    active_project_changed (activep);
+    frag_update = (active_project -> natomes > ATOM_LIMIT) ? 0 : 1;
+    mol_update = (frag_update) ? ((active_project -> steps > STEP_LIMIT) ? 0 : 1) : 0;
+    chemistry_ ();
+    apply_project (FALSE);
+    active_project_changed (activep);
+  }
+  return (active_glwin != NULL);
+}
+
+/*!
+  \fn static int batch_output_format (gchar * file, gboolean * movie)
+
+  \brief find the image format or the video codec from the output file extension
+
+  \param file the output file name
+  \param movie is this a movie ?
+*/
+static int batch_output_format (gchar * file, gboolean * movie)
+{
+  char * image_alias[IMAGE_FORMATS] = {"png", "jpg", "tif", "bmp"};
+  char * codec_alias[VIDEO_CODECS] = {"mpg", "avi", "mp4", "ogg", "flv"};
+  gchar * ext = g_strrstr (file, ".");
+  int i = -1;
+  int j;
+  if (! ext) return -1;
+  ext = g_ascii_strdown (ext+1, -1);
+  for (j=0; j<IMAGE_FORMATS; j++)
+  {
+    if (g_strcmp0 (ext, image_list[j]) == 0 || g_strcmp0 (ext, image_alias[j]) == 0)
+    {
+      * movie = FALSE;
+      i = j;
+    }
+  }
+  for (j=0; j<VIDEO_CODECS; j++)
+  {
+    if (g_strcmp0 (ext, codec_list[j]) == 0 || g_strcmp0 (ext, codec_alias[j]) == 0)
+    {
+      * movie = TRUE;
+      i = j;
+    }
+  }
+  g_free (ext);
+  return i;
+}
+
+/*!
+  \fn static gchar * batch_image_name (gchar * file, int stp)
+
+  \brief image file name for an MD step, the step number is only added when rendering several steps
+
+  \param file the output file name
+  \param stp the MD step, starting at 0
+*/
+static gchar * batch_image_name (gchar * file, int stp)
+{
+  if (batch_steps[0] == batch_steps[1]) return g_strdup_printf ("%s", file);
+  gchar * ext = g_strrstr (file, ".");
+  gchar * base = g_strndup (file, ext - file);
+  int digits = (int)log10 (batch_steps[1]+1) + 1;
+  gchar * str = g_strdup_printf ("%s-%0*d%s", base, digits, stp+1, ext);
+  g_free (base);
+  return str;
+}
+
+/*!
+  \fn static gboolean batch_render_images (glwin * view)
+
+  \brief render one image for each of the requested MD steps
+
+  \param view the target glwin
+*/
+static gboolean batch_render_images (glwin * view)
+{
+  gboolean movie;
+  int format = batch_output_format (batch_output, & movie);
+  int stp;
+  gchar * file;
+  gboolean res = TRUE;
+  GError * error = NULL;
+  image * img = view -> anim -> last -> img;
+
+  init_frame_buffer (batch_res[0], batch_res[1]);
+  init_opengl ();
+  re_create_all_md_shaders (view);
+  recreate_all_shaders (view);
+  in_movie_encoding = TRUE;
+  if (batch_quality) img -> quality = batch_quality;
+  for (stp=batch_steps[0]; stp<=batch_steps[1] && res; stp+=batch_steps[2])
+  {
+    img -> step = stp;
+    fill_image (NULL, batch_res[0], batch_res[1], view);
+    file = batch_image_name (batch_output, stp);
+    res = gdk_pixbuf_savev (pixbuf, file, image_list[format], NULL, NULL, & error);
+    if (! res)
+    {
+      g_warning ("BATCH:: impossible to save image: %s, error: %s", file, error -> message);
+      g_error_free (error);
+    }
+    else
+    {
+      g_print ("%s\n", file);
+    }
+    g_free (file);
+    g_object_unref (pixbuf);
+    pixbuf = NULL;
+  }
+  in_movie_encoding = FALSE;
+  close_frame_buffer ();
+  return res;
+}
+
+/*!
+  \fn static gboolean batch_render_movie (glwin * view)
+
+  \brief render a movie of the requested MD steps, one frame per step
+
+  \param view the target glwin
+*/
+static gboolean batch_render_movie (glwin * view)
+{
+  gboolean movie;
+  int stp;
+  gboolean res;
+  video_options vopts;
+
+  vopts.proj = view -> proj;
+  vopts.codec = batch_output_format (batch_output, & movie);
+  vopts.framesec = batch_fps;
+  vopts.extraframes = 10;
+  vopts.bitrate = batch_bitrate;
+  vopts.oglquality = batch_quality;
+  vopts.video_res = batch_res;
+
+  // The animation is recorded as it would be using the OpenGL window, one snapshot per step
+  wingl = view;
+  proj_gl = get_project_by_id (view -> proj);
+  coord_gl = proj_gl -> coord;
+  plot = view -> anim -> last -> img;
+  for (stp=batch_steps[0]; stp<=batch_steps[1]; stp+=batch_steps[2])
+  {
+    step = plot -> step = stp;
+    add_image ();
+  }
+
+  init_frame_buffer (batch_res[0], batch_res[1]);
+  init_opengl ();
+  re_create_all_md_shaders (view);
+  recreate_all_shaders (view);
+  in_movie_encoding = TRUE;
+  res = create_movie (view, & vopts, batch_output);
+  in_movie_encoding = FALSE;
+  close_frame_buffer ();
+  if (res) g_print ("%s\n", batch_output);
+  return res;
+}
+
+/*!
+  \fn static gboolean batch_read_options (int argc, char * argv[])
+
+  \brief read the batch rendering options from the command line
+
+  \param argc number of argument(s) on the command line
+  \param *argv[] list of argument(s) on the command line, argv[1] is '--batch'
+*/
+static gboolean batch_read_options (int argc, char * argv[])
+{
+  int i, j;
+  gboolean movie;
+  gchar ** vals;
+  for (i=2; i<argc; i++)
+  {
+    if (i < argc-1 && (g_strcmp0 (argv[i], "-o") == 0 || g_strcmp0 (argv[i], "--output") == 0))
+    {
+      batch_output = argv[++i];
+    }
+    else if (i < argc-1 && g_strcmp0 (argv[i], "--size") == 0)
+    {
+      if (sscanf (argv[++i], "%dx%d", & batch_res[0], & batch_res[1]) != 2 || batch_res[0] < 1 || batch_res[1] < 1)
+      {
+        g_printerr ("Wrong image size: %s, use WIDTHxHEIGHT\n", argv[i]);
+        return FALSE;
+      }
+    }
+    else if (i < argc-1 && g_strcmp0 (argv[i], "--steps") == 0)
+    {
+      vals = g_strsplit (argv[++i], ":", 3);
+      for (j=0; j<3 && vals[j]; j++) batch_steps[j] = (int)g_ascii_strtoll (vals[j], NULL, 10);
+      if (j == 1) batch_steps[1] = batch_steps[0];
+      if (j < 3) batch_steps[2] = 1;
+      g_strfreev (vals);
+      if (batch_steps[0] < 1 || batch_steps[1] < batch_steps[0] || batch_steps[2] < 1)
+      {
+        g_printerr ("Wrong MD steps: %s, use FIRST[:LAST[:STRIDE]]\n", argv[i]);
+        return FALSE;
+      }
+    }
+    else if (i < argc-1 && g_strcmp0 (argv[i], "--quality") == 0)
+    {
+      batch_quality = CLAMP ((int)g_ascii_strtoll (argv[++i], NULL, 10), 0, 1000);
+    }
+    else if (i < argc-1 && g_strcmp0 (argv[i], "--fps") == 0)
+    {
+      batch_fps = MAX ((int)g_ascii_strtoll (argv[++i], NULL, 10), 1);
+    }
+    else if (i < argc-1 && g_strcmp0 (argv[i], "--bitrate") == 0)
+    {
+      batch_bitrate = MAX ((int)g_ascii_strtoll (argv[++i], NULL, 10), 1);
+    }
+    else
+    {
+      j = test_this_arg (argv[i]);
+      if (j > 0 && i < argc-1)
+      {
+        batch_input_type = j;
+        batch_input = argv[++i];
+      }
+      else if (j < 0)
+      {
+        batch_input_type = -j;
+        batch_input = argv[i];
+      }
+      else
+      {
+        g_printerr ("Unknown option or file format: %s\n", argv[i]);
+        return FALSE;
+      }
+    }
+  }
+  if (! batch_input || ! batch_output)
+  {
+    g_printerr ("Batch rendering requires an input file and an output file (-o FILE)\n");
+    return FALSE;
+  }
+  if (batch_input_type == 1 || batch_input_type == 15)
+  {
+    g_printerr ("Batch rendering requires a project file or a coordinate file\n");
+    return FALSE;
+  }
+  if (batch_output_format (batch_output, & movie) < 0)
+  {
+    g_printerr ("Unknown output format: %s\n", batch_output);
+    return FALSE;
+  }
+  return TRUE;
+}
+
+/*!
+  \fn int batch_render (int argc, char * argv[])
+
+  \brief render images or a movie from the command line, without OpenGL window, return the exit status
+
+  \param argc number of argument(s) on the command line
+  \param *argv[] list of argument(s) on the command line, argv[1] is '--batch'
+*/
+int batch_render (int argc, char * argv[])
+{
+  gboolean movie;
+  gboolean res;
+  project * this_proj;
+
+  if (! batch_read_options (argc, argv)) return 1;
+  batch_output_format (batch_output, & movie);
+  if (! init_batch_context ())
+  {
+    close_batch_context ();
+    return 1;
+  }
+  // Nothing is shown: with 'atomes_batch' the widgets, dialogs and event loops are skipped,
+  // so the rendering does not require a display, the toolkit is only initialized if one is available
+#ifdef GTK4
+  if (! gtk_init_check ())
+#else
+  if (! gtk_init_check (NULL, NULL))
+#endif
+  {
+    g_print ("BATCH:: no display available, rendering without GTK\n");
+  }
+  atomes_batch = TRUE;
+  res = batch_open_file (batch_input_type, batch_input);
+  if (res)
+  {
+    this_proj = active_project;
+    // User steps start at 1, by default a movie shows all MD steps, an image the first one
+    if (batch_steps[0])
+    {
+      batch_steps[0] --;
+      batch_steps[1] = MIN (batch_steps[1], this_proj -> steps) - 1;
+      if (batch_steps[1] < batch_steps[0])
+      {
+        g_printerr ("Wrong MD steps: the project only contains %d step(s)\n", this_proj -> steps);
+        res = FALSE;
+      }
+    }
+    else
+    {
+      batch_steps[1] = (movie) ? this_proj -> steps - 1 : 0;
+    }
+    if (res) res = (movie) ? batch_render_movie (this_proj -> modelgl) : batch_render_images (this_proj -> modelgl);
+  }
+  atomes_batch = FALSE;
+  close_batch_context ();
+  return (res) ? 0 : 1;
+}
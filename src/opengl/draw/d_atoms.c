@@ -37,17 +37,23 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 
   float get_sphere_radius (int style, int sp, int ac, int sel);
 
+  gboolean use_impostors (int instances, int indices);
+  gboolean atom_style_is_sphere (int sty);
+  gboolean stream_atom_lists (int cells);
+
   void setup_sphere_vertice (float * vertices, vec3_t pos, ColRGBA col, float rad, float alpha);
-  void setup_this_atom (int style, gboolean to_pick, gboolean picked, atom * at, int ac, float * vert, float al);
+  void setup_this_atom (int style, gboolean to_pick, int picked, gl_atom * at, int ac, float * vert, float al);
   void setup_atom_vertices (int style, gboolean to_pick, float * vertices);
-  void prepare_clone (int style, gboolean to_pick, int picked, atom at, atom bt, float x, float y, float z, float * vertices);
+  void prepare_clone (int style, gboolean to_pick, int picked, atom * at, atom * bt, float x, float y, float z, float * vertices);
   void setup_clone_vertices (int style, gboolean to_pick, float * vertices);
   void atom_positions_colors_and_sizes (int style, gboolean to_pick, float * instances);
+  void free_atom_lists ();
   void create_atom_lists (gboolean to_pick);
 
   ColRGBA get_atom_color (int i, int j, double al, int picked, gboolean to_pick);
 
   object_3d * draw_sphere (int quality);
+  object_3d * draw_impostor_box ();
 
 */
 
@@ -58,7 +64,7 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 #include "preferences.h"
 
 int atom_id;
-int gColorID[3];
+int pick_id;
 int all_styles[NUM_STYLES];
 
 /*!
@@ -80,23 +86,12 @@ ColRGBA get_atom_color (int i, int j, double al, int picked, gboolean to_pick)
   ColRGBA colo;
   if (to_pick)
   {
-    gColorID[0]++;
-    if(gColorID[0] > 255)
-    {
-      gColorID[0] = 0;
-      gColorID[1]++;
-      if(gColorID[1] > 255)
-      {
-        gColorID[1] = 0;
-        gColorID[2]++;
-      }
-    }
-    wingl -> color_to_pick[wingl -> to_be_picked] = gColorID[0] + 256*gColorID[1] + 256*256*gColorID[2];
-    colo.red = gColorID[0]/255.0;
-    colo.green = gColorID[1]/255.0;
-    colo.blue = gColorID[2]/255.0;
+    // The color is the pick id + 1, set by the caller, black is the background
+    pick_id ++;
+    colo.red = (pick_id & 255)/255.0;
+    colo.green = ((pick_id >> 8) & 255)/255.0;
+    colo.blue = ((pick_id >> 16) & 255)/255.0;
     colo.alpha = 1.0;
-    wingl -> to_be_picked ++;
   }
   else if (picked)
   {
@@ -257,6 +252,51 @@ object_3d * draw_sphere (int quality)
   return new_sphere;
 }
 
+/*!
+  \fn gboolean use_impostors (int instances, int indices)
+
+  \brief level of detail: render spheres / cylinders as ray cast impostors (1) or as meshes (0)
+
+  \param instances the number of instances to render
+  \param indices the number of OpenGL indices of the mesh for one instance
+*/
+gboolean use_impostors (int instances, int indices)
+{
+  return ((double)instances * indices > IMPOSTOR_INDICES) ? TRUE : FALSE;
+}
+
+/*!
+  \fn object_3d * draw_impostor_box ()
+
+  \brief OpenGL 3D box object, in [-1, 1], that bounds a sphere or a cylinder impostor
+*/
+object_3d * draw_impostor_box ()
+{
+  int i;
+  // Triangles, counter clockwise seen from outside: -z, +z, -y, +y, -x, +x
+  int box_ind[36] = {0, 2, 3, 0, 3, 1,
+                     4, 5, 7, 4, 7, 6,
+                     0, 1, 5, 0, 5, 4,
+                     2, 6, 7, 2, 7, 3,
+                     0, 4, 6, 0, 6, 2,
+                     1, 3, 7, 1, 7, 5};
+  object_3d * new_box = g_malloc0 (sizeof*new_box);
+  new_box -> num_vertices = 8;
+  new_box -> vert_buffer_size = 3;
+  new_box -> vertices = allocfloat (3*new_box -> num_vertices);
+  for (i=0; i<8; i++)
+  {
+    new_box -> vertices[3*i]   = (i & 1) ? 1.0 : -1.0;
+    new_box -> vertices[3*i+1] = (i & 2) ? 1.0 : -1.0;
+    new_box -> vertices[3*i+2] = (i & 4) ? 1.0 : -1.0;
+  }
+  new_box -> num_indices = 36;
+  new_box -> ind_buffer_size = 1;
+  new_box -> indices = allocint (new_box -> num_indices);
+  for (i=0; i<36; i++) new_box -> indices[i] = box_ind[i];
+  return new_box;
+}
+
 /*!
   \fn float get_sphere_radius (int style, int sp, int ac, int sel)
 
@@ -314,26 +354,26 @@ void setup_sphere_vertice (float * vertices, vec3_t pos, ColRGBA col, float rad,
 }
 
 /*!
-  \fn void setup_this_atom (int style, gboolean to_pick, gboolean picked, atom * at, int ac, float * vert, float al)
+  \fn void setup_this_atom (int style, gboolean to_pick, int picked, gl_atom * at, int ac, float * vert, float al)
 
   \brief prepare the OpenGL rendering data of an atom / clone
 
   \param style rendering style
   \param to_pick to pick (1) or to draw (0)
   \param picked is the atom selected (1) or not (0)
-  \param at the atom to render
+  \param at the rendering view of the atom to render
   \param ac atom (0) or clone (1)
   \param vert the OpenGL buffer data to fill
   \param al the opacity (atom: 1.0, clone: 0.5)
 */
-void setup_this_atom (int style, gboolean to_pick, gboolean picked, atom * at, int ac, float * vert, float al)
+void setup_this_atom (int style, gboolean to_pick, int picked, gl_atom * at, int ac, float * vert, float al)
 {
   int i, j, k;
   float alpha = 1.0;
   float shift[3];
   ColRGBA col = get_atom_color (at -> sp, at -> id, 1.0, picked, to_pick);
-  if (at -> sp > proj_sp - 1) at -> sp -= proj_sp;
-  float rad = get_sphere_radius ((style == NONE) ? plot -> style : style, at -> sp, ac, (picked) ? 1 : 0);
+  int sp = (at -> sp > proj_sp - 1) ? at -> sp - proj_sp : at -> sp;
+  float rad = get_sphere_radius ((style == NONE) ? plot -> style : style, sp, ac, (picked) ? 1 : 0);
   for (i=0; i<plot -> abc -> extra_cell[0]+1;i++)
   {
     for (j=0; j<plot -> abc -> extra_cell[1]+1; j++)
@@ -343,9 +383,7 @@ void setup_this_atom (int style, gboolean to_pick, gboolean picked, atom * at, i
         shift[0]=i*box_gl -> vect[0][0]+j*box_gl -> vect[1][0]+k*box_gl -> vect[2][0];
         shift[1]=i*box_gl -> vect[0][1]+j*box_gl -> vect[1][1]+k*box_gl -> vect[2][1];
         shift[2]=i*box_gl -> vect[0][2]+j*box_gl -> vect[1][2]+k*box_gl -> vect[2][2];
-        at_shift (at, shift);
-        setup_sphere_vertice (vert, vec3(at -> x, at -> y, at -> z), col, rad, (to_pick) ? 1.0 : alpha*al);
-        at_unshift (at, shift);
+        setup_sphere_vertice (vert, vec3(at -> x + shift[0], at -> y + shift[1], at -> z + shift[2]), col, rad, (to_pick) ? 1.0 : alpha*al);
         alpha = 0.5;
       }
     }
@@ -411,25 +449,26 @@ int find_atom_vertices (gboolean to_pick)
 void setup_atom_vertices (int style, gboolean to_pick, float * vertices)
 {
   int i;
-  atom * tmp_a;
+  gl_atom va;
+  gboolean movie = (in_movie_encoding && plot -> at_data != NULL) ? TRUE : FALSE;
   for (i=0; i<proj_at; i++)
   {
-    tmp_a = duplicate_atom (& proj_gl -> atoms[step][i]);
-    if (in_movie_encoding && plot -> at_data != NULL)
+    gl_atom_view (& va, & proj_gl -> atoms[step][i]);
+    if (movie)
     {
-      tmp_a -> show[0] = plot -> at_data[i].show[0];
-      tmp_a -> style = plot -> at_data[i].style;
+      va.show[0] = plot -> at_data[i].show[0];
+      va.style = plot -> at_data[i].style;
     }
-    if (tmp_a -> show[0] && (tmp_a -> style == style || to_pick))
+    if (va.show[0] && (va.style == style || to_pick))
     {
-      setup_this_atom (style, to_pick, 0, tmp_a, 0, vertices, 1.0);
+      pick_id = i;
+      setup_this_atom (style, to_pick, 0, & va, 0, vertices, 1.0);
     }
-    g_free (tmp_a);
   }
 }
 
 /*!
-  \fn void prepare_clone (int style, gboolean to_pick, int picked, atom at, atom bt, float x, float y, float z, float * vertices)
+  \fn void prepare_clone (int style, gboolean to_pick, int picked, atom * at, atom * bt, float x, float y, float z, float * vertices)
 
   \brief prepare the rendering data of a clone
 
@@ -443,25 +482,26 @@ void setup_atom_vertices (int style, gboolean to_pick, float * vertices)
   \param z z position
   \param vertices the OpenGL buffer data to fill
 */
-void prepare_clone (int style, gboolean to_pick, int picked, atom at, atom bt, float x, float y, float z, float * vertices)
+void prepare_clone (int style, gboolean to_pick, int picked, atom * at, atom * bt, float x, float y, float z, float * vertices)
 {
-  atom * tmp_a = duplicate_atom (& bt);
-  tmp_a -> x += x;
-  tmp_a -> y += y;
-  tmp_a -> z += z;
-  tmp_a -> id = at.id;
-  tmp_a -> sp = at.sp + proj_sp;
-  int sty = at.style;
+  gl_atom va;
+  gboolean show = at -> show[1];
+  int sty = at -> style;
   if (in_movie_encoding && plot -> at_data != NULL)
   {
-    tmp_a -> show[1] = plot -> at_data[at.id].show[1];
-    sty = plot -> at_data[at.id].style;
+    show = plot -> at_data[at -> id].show[1];
+    sty = plot -> at_data[at -> id].style;
   }
-  if (at.show[1] && (sty == style || to_pick))
+  if (show && (sty == style || to_pick))
   {
-    setup_this_atom (style, to_pick, picked, tmp_a, 1, vertices, 0.5);
+    gl_atom_view (& va, bt);
+    va.x += x;
+    va.y += y;
+    va.z += z;
+    va.id = at -> id;
+    va.sp = at -> sp + proj_sp;
+    setup_this_atom (style, to_pick, picked, & va, 1, vertices, 0.5);
   }
-  g_free (tmp_a);
 }
 
 /*!
@@ -553,15 +593,17 @@ void setup_clone_vertices (int style, gboolean to_pick, float * vertices)
   {
     j = wingl -> bondid[step][1][i][0];
     k = wingl -> bondid[step][1][i][1];
+    pick_id = wingl -> atoms_to_be_picked + 2*i;
     prepare_clone (style, to_pick, 0,
-                   proj_gl -> atoms[step][j],
-                   proj_gl -> atoms[step][k],
+                   & proj_gl -> atoms[step][j],
+                   & proj_gl -> atoms[step][k],
                    wingl -> clones[step][i].x,
                    wingl -> clones[step][i].y,
                    wingl -> clones[step][i].z, vertices);
+    pick_id = wingl -> atoms_to_be_picked + 2*i + 1;
     prepare_clone (style, to_pick, 0,
-                   proj_gl -> atoms[step][k],
-                   proj_gl -> atoms[step][j],
+                   & proj_gl -> atoms[step][k],
+                   & proj_gl -> atoms[step][j],
                   -wingl -> clones[step][i].x,
                   -wingl -> clones[step][i].y,
                   -wingl -> clones[step][i].z, vertices);
@@ -581,12 +623,100 @@ void setup_clone_vertices (int style, gboolean to_pick, float * vertices)
 void atom_positions_colors_and_sizes (int style, gboolean to_pick, float * instances)
 {
   setup_atom_vertices (style, to_pick, instances);
-  if (to_pick) wingl -> atoms_to_be_picked = wingl -> clones_to_be_picked = wingl -> to_be_picked;
-  if (plot -> draw_clones)
+  if (plot -> draw_clones) setup_clone_vertices (style, to_pick, instances);
+}
+
+/*!
+  \fn gboolean atom_style_is_sphere (int sty)
+
+  \brief are the atoms of this style rendered using spheres (1) or points (0)
+
+  \param sty the style index in 'all_styles', 0 for the picking / default style
+*/
+gboolean atom_style_is_sphere (int sty)
+{
+  int style = (sty) ? sty-1 : plot -> style;
+  return (style == WIREFRAME || style == PUNT) ? FALSE : TRUE;
+}
+
+/*!
+  \fn void free_atom_lists ()
+
+  \brief free the atom shaders, and their GPU buffers
+*/
+void free_atom_lists ()
+{
+  int i;
+  int s = wingl -> atom_stream_step;
+  if (s > -1 && s < proj_gl -> steps && wingl -> ogl_glsl[ATOMS][s] != NULL)
   {
-    setup_clone_vertices (style, to_pick, instances);
-    if (to_pick) wingl -> clones_to_be_picked = wingl -> to_be_picked;
+    for (i=0; i<wingl -> atom_stream_shaders; i++) free_glsl_program (wingl -> ogl_glsl[ATOMS][s][i]);
+    g_free (wingl -> ogl_glsl[ATOMS][s]);
+    wingl -> ogl_glsl[ATOMS][s] = NULL;
+    wingl -> n_shaders[ATOMS][s] = -1;
   }
+  wingl -> atom_stream_step = -1;
+  wingl -> atom_stream_shaders = 0;
+}
+
+/*!
+  \fn gboolean stream_atom_lists (int cells)
+
+  \brief reuse the atom shaders already built for an MD step to render the active step:
+  \brief the instance buffers are rewritten in place, and GPU memory does not grow with the number of steps visited
+
+  \param cells the number of cell replica(s) to render
+*/
+gboolean stream_atom_lists (int cells)
+{
+  int i, k;
+  int s = wingl -> atom_stream_step;
+  glsl_program * glsl;
+  float * instances;
+
+  if (s < 0 || s >= proj_gl -> steps || wingl -> ogl_glsl[ATOMS][s] == NULL) return FALSE;
+  if (wingl -> atom_stream_key[0] != plot -> quality) return FALSE;
+  if (wingl -> atom_stream_key[1] != plot -> l_ghtning.lights) return FALSE;
+  if (wingl -> atom_stream_key[2] != plot -> style) return FALSE;
+  // Same shaders, with the same number of instances, are required
+  k = 0;
+  for (i=0; i<NUM_STYLES; i++)
+  {
+    if (all_styles[i])
+    {
+      if (k == wingl -> atom_stream_shaders) return FALSE;
+      glsl = wingl -> ogl_glsl[ATOMS][s][k];
+      if (glsl == NULL || glsl -> obj -> num_instances != cells*all_styles[i]) return FALSE;
+      if (glsl -> draw_type != ((atom_style_is_sphere (i)) ? GLSL_SPHERES : GLSL_POINTS)) return FALSE;
+      if (glsl -> draw_type == GLSL_SPHERES && glsl -> impostor != use_impostors (glsl -> obj -> num_instances, sphere_indices (plot -> quality))) return FALSE;
+      k ++;
+    }
+  }
+  if (k != wingl -> atom_stream_shaders) return FALSE;
+
+  k = 0;
+  for (i=0; i<NUM_STYLES; i++)
+  {
+    if (all_styles[i])
+    {
+      glsl = wingl -> ogl_glsl[ATOMS][s][k];
+      instances = allocfloat (glsl -> obj -> num_instances*ATOM_BUFF_SIZE);
+      nbl = 0;
+      atom_positions_colors_and_sizes (i-1, FALSE, instances);
+      update_atom_instances (glsl, instances);
+      k ++;
+    }
+  }
+  if (s != step)
+  {
+    if (wingl -> ogl_glsl[ATOMS][step] != NULL) g_free (wingl -> ogl_glsl[ATOMS][step]);
+    wingl -> ogl_glsl[ATOMS][step] = wingl -> ogl_glsl[ATOMS][s];
+    wingl -> ogl_glsl[ATOMS][s] = NULL;
+    wingl -> n_shaders[ATOMS][s] = -1;
+    wingl -> atom_stream_step = step;
+  }
+  wingl -> n_shaders[ATOMS][step] = k;
+  return TRUE;
 }
 
 /*!
@@ -601,12 +731,9 @@ void create_atom_lists (gboolean to_pick)
   int i, j, k;
   object_3d * atos;
   gboolean sphere = TRUE;
+  gboolean impostor = FALSE;
 
-  if (! to_pick)
-  {
-    cleaning_shaders (wingl, ATOMS);
-    wingl -> create_shaders[ATOMS] = FALSE;
-  }
+  if (! to_pick) wingl -> create_shaders[ATOMS] = FALSE;
 
   for (i=0; i<NUM_STYLES; i++) all_styles[i] = 0;
   j = find_atom_vertices (to_pick);
@@ -614,31 +741,41 @@ void create_atom_lists (gboolean to_pick)
 #ifdef DEBUG
   g_debug ("Atom LIST:: to_pick= %s, Atom(s) to render= %d", (to_pick) ? "true" : "false", j);
 #endif
+  k = (plot -> abc -> extra_cell[0]+1)*(plot -> abc -> extra_cell[1]+1)*(plot -> abc -> extra_cell[2]+1);
+  if (! to_pick)
+  {
+    // A single set of atom shaders is kept, whatever the number of MD steps
+    if (j > 0 && stream_atom_lists (k)) return;
+    free_atom_lists ();
+    cleaning_shaders (wingl, ATOMS);
+  }
   if (j > 0)
   {
     // Render atom(s)
-    j = (plot -> abc -> extra_cell[0]+1)*(plot -> abc -> extra_cell[1]+1)*(plot -> abc -> extra_cell[2]+1);
+    j = k;
     if (! to_pick)
     {
       wingl -> n_shaders[ATOMS][step] = 0;
       for (i=0; i<NUM_STYLES; i++) if (all_styles[i]) wingl -> n_shaders[ATOMS][step] ++;
       wingl -> ogl_glsl[ATOMS][step] = g_malloc0 (wingl -> n_shaders[ATOMS][step]*sizeof*wingl -> ogl_glsl[ATOMS][step]);
+      wingl -> atom_stream_step = step;
+      wingl -> atom_stream_shaders = wingl -> n_shaders[ATOMS][step];
+      wingl -> atom_stream_key[0] = plot -> quality;
+      wingl -> atom_stream_key[1] = plot -> l_ghtning.lights;
+      wingl -> atom_stream_key[2] = plot -> style;
     }
     k = 0;
     for (i=0; i<NUM_STYLES; i++)
     {
-      sphere = TRUE;
       if (all_styles[i] || to_pick)
       {
-        if (! i)
-        {
-          if (plot -> style == WIREFRAME || plot -> style == PUNT) sphere = FALSE;
-        }
-        else
+        sphere = atom_style_is_sphere (i);
+        impostor = (sphere && ! to_pick) ? use_impostors (j*all_styles[i], sphere_indices (plot -> quality)) : FALSE;
+        if (impostor)
         {
-          if (i-1 == WIREFRAME || i-1 == PUNT) sphere = FALSE;
+          atos = draw_impostor_box ();
         }
-        if (sphere)
+        else if (sphere)
         {
           atos = draw_sphere (plot -> quality);
         }
@@ -657,7 +794,12 @@ void create_atom_lists (gboolean to_pick)
         atom_positions_colors_and_sizes (i-1, to_pick, atos -> instances);
         if (! to_pick)
         {
-          if (sphere)
+          if (impostor)
+          {
+            wingl -> ogl_glsl[ATOMS][step][k] = init_shader_program (ATOMS, GLSL_SPHERES, sphere_impostor_vertex, NULL, impostor_color(), GL_TRIANGLES, 4, 2, TRUE, atos);
+            glsl_set_impostor (wingl -> ogl_glsl[ATOMS][step][k]);
+          }
+          else if (sphere)
           {
             wingl -> ogl_glsl[ATOMS][step][k] = init_shader_program (ATOMS, GLSL_SPHERES, sphere_vertex, NULL, full_color, GL_TRIANGLE_STRIP, 4, 1, TRUE, atos);
           }
@@ -39,13 +39,20 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 
   float get_bond_radius (int sty, int ac, int at, int bt, int sel);
 
+  gboolean bond_style_is_cylinder (int sty);
+  gboolean use_atom_pairs ();
+  gboolean stream_bond_lists (int * nbds, int * ncap);
+
   void setup_line_vertice (float * vertices, vec3_t pos, ColRGBA col, float alpha);
   void setup_cylinder_vertice (float * vertices, vec3_t pos_a, vec3_t pos_b, ColRGBA col, float rad, float alpha, float delta);
   void setup_cap_vertice (float * vertices, vec3_t pos_a, vec3_t pos_b, ColRGBA col, float rad, float alpha);
-  void setup_this_bond (int sty, gboolean to_pick, gboolean picked, int cap, int bi, int pi, atom * at, atom * bt, float al, float * vertices);
+  void setup_pair_vertice (float * vertices, int a, int b, ColRGBA col, float rad, float alpha);
+  void setup_this_bond (int sty, gboolean to_pick, gboolean picked, int cap, int bi, int pi, gl_atom * at, gl_atom * bt, float al, float * vertices);
   void prepare_bond (int sty, gboolean to_pick, gboolean picked, int cap, int bi, int pi, int bid, atom * at, atom * bt, float * vertices);
   void setup_all_cylinder_vertices (int style, gboolean to_pick, int cap, int bi, float * vertices);
   void setup_line_vertices (int style, int cap, int bi, int sa, int sb, float * vertices);
+  void send_atom_positions ();
+  void free_bond_lists ();
 
   vec4_t rotate_bond (vec3_t a, vec3_t b);
 
@@ -339,10 +346,36 @@ void setup_cap_vertice (float * vertices, vec3_t pos_a, vec3_t pos_b, ColRGBA co
   nbs ++;
 }
 
+/*!
+  \fn void setup_pair_vertice (float * vertices, int a, int b, ColRGBA col, float rad, float alpha)
+
+  \brief fill the OpenGL data buffer for a cylinder bond (or cylinder cap) to build from the atom positions
+
+  \param vertices the OpenGL buffer to fill
+  \param a the atom the half bond starts from
+  \param b the other atom in the bond
+  \param col the color
+  \param rad the radius
+  \param alpha the opacity
+*/
+void setup_pair_vertice (float * vertices, int a, int b, ColRGBA col, float rad, float alpha)
+{
+  int s = nbs*PAIR_BUFF_SIZE;
+  vertices[s] = a;
+  vertices[s+1] = b;
+  vertices[s+2] = rad;
+  vertices[s+3] = col.red;
+  vertices[s+4] = col.green;
+  vertices[s+5] = col.blue;
+  vertices[s+6] = col.alpha * alpha;
+  nbs ++;
+}
+
 int vs_bid;
+gboolean pair_bonds = FALSE;
 
 /*!
-  \fn void setup_this_bond (int sty, gboolean to_pick, gboolean picked, int cap, int bi, int pi, atom * at, atom * bt, float al, float * vertices)
+  \fn void setup_this_bond (int sty, gboolean to_pick, gboolean picked, int cap, int bi, int pi, gl_atom * at, gl_atom * bt, float al, float * vertices)
 
   \brief prepare the OpenGL rendering data of a bond / clone bond
 
@@ -352,12 +385,12 @@ int vs_bid;
   \param cap draw cylinder cap (1/0)
   \param bi atom (0) or clone (1) visible
   \param pi atom (0) or clone (1) picked
-  \param at 1st atom
-  \param bt 2nd atom
+  \param at rendering view of the 1st atom
+  \param bt rendering view of the 2nd atom
   \param al the opacity (bond: 1.0, clone bond: 0.5)
   \param vertices the OpenGL buffer data to fill
 */
-void setup_this_bond (int sty, gboolean to_pick, gboolean picked, int cap, int bi, int pi, atom * at, atom * bt, float al, float * vertices)
+void setup_this_bond (int sty, gboolean to_pick, gboolean picked, int cap, int bi, int pi, gl_atom * at, gl_atom * bt, float al, float * vertices)
 {
   float alpha = 1.0;
   float delta = 0.0;
@@ -395,13 +428,15 @@ void setup_this_bond (int sty, gboolean to_pick, gboolean picked, int cap, int b
         shift[0]=p*box_gl -> vect[0][0]+q*box_gl -> vect[1][0]+r*box_gl -> vect[2][0];
         shift[1]=p*box_gl -> vect[0][1]+q*box_gl -> vect[1][1]+r*box_gl -> vect[2][1];
         shift[2]=p*box_gl -> vect[0][2]+q*box_gl -> vect[1][2]+r*box_gl -> vect[2][2];
-        at_shift (at, shift);
-        at_shift (bt, shift);
-        pos_a = vec3(at -> x, at -> y, at -> z);
-        pos_b = vec3((at -> x + bt -> x)/2.0, (at -> y + bt -> y)/2.0, (at -> z + bt -> z)/2.0);
+        pos_a = vec3(at -> x + shift[0], at -> y + shift[1], at -> z + shift[2]);
+        pos_b = vec3((at -> x + bt -> x)/2.0 + shift[0], (at -> y + bt -> y)/2.0 + shift[1], (at -> z + bt -> z)/2.0 + shift[2]);
         if (to_pick || ((sty == NONE && (plot -> style == BALL_AND_STICK || plot -> style == CYLINDERS)) || sty == BALL_AND_STICK || sty == CYLINDERS))
         {
-          if (cap)
+          if (pair_bonds)
+          {
+            setup_pair_vertice (vertices, at -> id, bt -> id, col, rad, alpha * al);
+          }
+          else if (cap)
           {
             setup_cap_vertice (vertices, pos_a, pos_b, col, rad, alpha * al);
           }
@@ -415,8 +450,6 @@ void setup_this_bond (int sty, gboolean to_pick, gboolean picked, int cap, int b
           setup_line_vertice (vertices, pos_a, col, alpha*al);
           setup_line_vertice (vertices, pos_b, col, alpha*al);
         }
-        at_unshift (at, shift);
-        at_unshift (bt, shift);
         alpha = 0.5;
       }
     }
@@ -441,13 +474,15 @@ void setup_this_bond (int sty, gboolean to_pick, gboolean picked, int cap, int b
 */
 void prepare_bond (int sty, gboolean to_pick, gboolean picked, int cap, int bi, int pi, int bid, atom * at, atom * bt, float * vertices)
 {
+  gl_atom va, vb;
   if (bi == 0)
   {
-    setup_this_bond (sty, to_pick, picked, cap, bi, pi, at, bt, 1.0, vertices);
+    gl_atom_view (& va, at);
+    gl_atom_view (& vb, bt);
+    setup_this_bond (sty, to_pick, picked, cap, bi, pi, & va, & vb, 1.0, vertices);
   }
   else
   {
-    atom * tmp_a, * tmp_b;
     float x, y, z;
     int sign;
     sign = 1;
@@ -455,32 +490,28 @@ void prepare_bond (int sty, gboolean to_pick, gboolean picked, int cap, int bi,
     x = wingl -> clones[step][bid].x;
     y = wingl -> clones[step][bid].y;
     z = wingl -> clones[step][bid].z;
-    tmp_a = duplicate_atom (at);
-    tmp_b = duplicate_atom (at);
-    tmp_a -> pick[pi] = bt -> pick[pi];
-    tmp_a -> style = bt -> style;
-    tmp_a -> sp = bt -> sp + proj_sp;
-    tmp_b -> sp += proj_sp;
-    tmp_a -> x += sign * x;
-    tmp_a -> y += sign * y;
-    tmp_a -> z += sign * z;
-    setup_this_bond (sty, to_pick, picked, cap, bi, pi, tmp_b, tmp_a, 0.5, vertices);
-    g_free (tmp_a);
-    g_free (tmp_b);
-
-    tmp_a = duplicate_atom (bt);
-    tmp_b = duplicate_atom (bt);
-    tmp_a -> pick[pi] = at -> pick[pi];
-    tmp_a -> style = at -> style;
-    tmp_a -> sp = at -> sp + proj_sp;
-    tmp_b -> sp += proj_sp;
-    tmp_a -> id = at -> id;
-    tmp_a -> x -= sign * x;
-    tmp_a -> y -= sign * y;
-    tmp_a -> z -= sign * z;
-    setup_this_bond (sty, to_pick, picked, cap, bi, pi, tmp_a, tmp_b, 0.5, vertices);
-    g_free (tmp_a);
-    g_free (tmp_b);
+    gl_atom_view (& va, at);
+    gl_atom_view (& vb, at);
+    va.pick[pi] = bt -> pick[pi];
+    va.style = bt -> style;
+    va.sp = bt -> sp + proj_sp;
+    vb.sp += proj_sp;
+    va.x += sign * x;
+    va.y += sign * y;
+    va.z += sign * z;
+    setup_this_bond (sty, to_pick, picked, cap, bi, pi, & vb, & va, 0.5, vertices);
+
+    gl_atom_view (& va, bt);
+    gl_atom_view (& vb, bt);
+    va.pick[pi] = at -> pick[pi];
+    va.style = at -> style;
+    va.sp = at -> sp + proj_sp;
+    vb.sp += proj_sp;
+    va.id = at -> id;
+    va.x -= sign * x;
+    va.y -= sign * y;
+    va.z -= sign * z;
+    setup_this_bond (sty, to_pick, picked, cap, bi, pi, & va, & vb, 0.5, vertices);
   }
 }
 
@@ -566,6 +597,9 @@ void setup_all_cylinder_vertices (int style, gboolean to_pick, int cap, int bi,
 {
   int i, j, k, l, m;
   gboolean show_a, show_b;
+  // Pick ids: 2 halves per bond, 2 halves of 2 cylinders per clone bond
+  int pick_base = (bi) ? wingl -> bonds_to_be_picked : wingl -> clones_to_be_picked;
+  int pick_step = (bi) ? 2 : 1;
   for (i=0; i < wingl -> bonds[step][bi]; i++)
   {
     j = wingl -> bondid[step][bi][i][0];
@@ -586,6 +620,7 @@ void setup_all_cylinder_vertices (int style, gboolean to_pick, int cap, int bi,
     }
     if (show_a && (l == style || to_pick))
     {
+      pick_id = pick_base + 2*pick_step*i;
       if (cap)
       {
         if (! show_b || m != style) prepare_bond (style, to_pick, FALSE, cap, bi, 0, i, & proj_gl -> atoms[step][j], & proj_gl -> atoms[step][k], vertices);
@@ -597,6 +632,7 @@ void setup_all_cylinder_vertices (int style, gboolean to_pick, int cap, int bi,
     }
     if (show_b && (m == style || to_pick))
     {
+      pick_id = pick_base + 2*pick_step*i + pick_step;
       if (cap)
       {
         if (! show_a || l != style) prepare_bond (style, to_pick, FALSE, cap, bi, 0, i, & proj_gl -> atoms[step][k], & proj_gl -> atoms[step][j], vertices);
@@ -660,6 +696,163 @@ void setup_line_vertices (int style, int cap, int bi, int sa, int sb, float * ve
   }
 }
 
+/*!
+  \fn gboolean bond_style_is_cylinder (int sty)
+
+  \brief are the bonds of this style rendered using cylinders (1) or lines (0)
+
+  \param sty the style index, 0 for the default style
+*/
+gboolean bond_style_is_cylinder (int sty)
+{
+  int style = (sty) ? sty-1 : plot -> style;
+  return (style == BALL_AND_STICK || style == CYLINDERS) ? TRUE : FALSE;
+}
+
+/*!
+  \fn gboolean use_atom_pairs ()
+
+  \brief can the cylinder bonds be built on the GPU, from atom pairs and the atom positions
+*/
+gboolean use_atom_pairs ()
+{
+  int i;
+  // Cell replicas and clone bonds are shifted copies of the atoms, those are computed here
+  for (i=0; i<3; i++) if (plot -> abc -> extra_cell[i]) return FALSE;
+  if (plot -> draw_clones && wingl -> bonds[step][1]) return FALSE;
+  // Atom ids are stored as floats in the instances
+  if (proj_at > 16777216) return FALSE;
+  if (epoxy_gl_version () < 31 && ! epoxy_has_gl_extension ("GL_ARB_texture_buffer_object")) return FALSE;
+  return TRUE;
+}
+
+/*!
+  \fn void send_atom_positions ()
+
+  \brief send the atom positions of the active MD step to the texture buffer read by the bond shaders built from atom pairs
+*/
+void send_atom_positions ()
+{
+  int i;
+  float * pos = allocfloat (4*proj_at);
+  for (i=0; i<proj_at; i++)
+  {
+    pos[4*i]   = proj_gl -> pos[step][0][i];
+    pos[4*i+1] = proj_gl -> pos[step][1][i];
+    pos[4*i+2] = proj_gl -> pos[step][2][i];
+  }
+  if (! wingl -> atom_positions[0])
+  {
+    glGenBuffers (1, & wingl -> atom_positions[0]);
+    glGenTextures (1, & wingl -> atom_positions[1]);
+  }
+  // 4 floats per atom: RGB32F texture buffers require OpenGL 4.0
+  glBindBuffer (GL_TEXTURE_BUFFER, wingl -> atom_positions[0]);
+  glBufferData (GL_TEXTURE_BUFFER, 4*proj_at*sizeof(GLfloat), pos, GL_STREAM_DRAW);
+  glBindTexture (GL_TEXTURE_BUFFER, wingl -> atom_positions[1]);
+  glTexBuffer (GL_TEXTURE_BUFFER, GL_RGBA32F, wingl -> atom_positions[0]);
+  glBindTexture (GL_TEXTURE_BUFFER, 0);
+  glBindBuffer (GL_TEXTURE_BUFFER, 0);
+  g_free (pos);
+}
+
+/*!
+  \fn void free_bond_lists ()
+
+  \brief free the bond shaders, and their GPU buffers
+*/
+void free_bond_lists ()
+{
+  int i;
+  int s = wingl -> bond_stream_step;
+  if (s > -1 && s < proj_gl -> steps && wingl -> ogl_glsl[BONDS][s] != NULL)
+  {
+    for (i=0; i<wingl -> bond_stream_shaders; i++) free_glsl_program (wingl -> ogl_glsl[BONDS][s][i]);
+    g_free (wingl -> ogl_glsl[BONDS][s]);
+    wingl -> ogl_glsl[BONDS][s] = NULL;
+    wingl -> n_shaders[BONDS][s] = -1;
+  }
+  wingl -> bond_stream_step = -1;
+  wingl -> bond_stream_shaders = 0;
+}
+
+/*!
+  \fn gboolean stream_bond_lists (int * nbds, int * ncap)
+
+  \brief reuse the bond shaders built from atom pairs for an MD step to render the active step:
+  \brief only the atom positions are sent, and the atom pairs if the bonds changed
+
+  \param nbds the number of bond vertices for each style
+  \param ncap the number of cap vertices for each style
+*/
+gboolean stream_bond_lists (int * nbds, int * ncap)
+{
+  int f, k, n;
+  int s = wingl -> bond_stream_step;
+  glsl_program * glsl;
+  float * instances;
+
+  if (s < 0 || s >= proj_gl -> steps || wingl -> ogl_glsl[BONDS][s] == NULL) return FALSE;
+  if (wingl -> bond_stream_key[0] != plot -> quality) return FALSE;
+  if (wingl -> bond_stream_key[1] != plot -> l_ghtning.lights) return FALSE;
+  if (wingl -> bond_stream_key[2] != plot -> style) return FALSE;
+  // Same shaders, all built from atom pairs, with the same number of instances, are required
+  k = 0;
+  for (f=0; f<NUM_STYLES; f++)
+  {
+    if (nbds[f])
+    {
+      if (! bond_style_is_cylinder (f) || k == wingl -> bond_stream_shaders) return FALSE;
+      glsl = wingl -> ogl_glsl[BONDS][s][k];
+      n = nbds[f]/2;
+      if (glsl == NULL || ! glsl -> atom_pairs || glsl -> draw_type != GLSL_CYLINDERS || glsl -> obj -> num_instances != n) return FALSE;
+      if (glsl -> impostor != use_impostors (n, cylinder_indices (plot -> quality))) return FALSE;
+      k ++;
+      if (ncap[f])
+      {
+        if (k == wingl -> bond_stream_shaders) return FALSE;
+        glsl = wingl -> ogl_glsl[BONDS][s][k];
+        if (glsl == NULL || ! glsl -> atom_pairs || glsl -> draw_type != GLSL_CAPS || glsl -> obj -> num_instances != ncap[f]/2) return FALSE;
+        k ++;
+      }
+    }
+  }
+  if (k != wingl -> bond_stream_shaders) return FALSE;
+
+  k = 0;
+  for (f=0; f<NUM_STYLES; f++)
+  {
+    if (nbds[f])
+    {
+      glsl = wingl -> ogl_glsl[BONDS][s][k];
+      instances = allocfloat (glsl -> obj -> num_instances*PAIR_BUFF_SIZE);
+      nbs = 0;
+      setup_all_cylinder_vertices (f-1, FALSE, 0, 0, instances);
+      update_pair_instances (glsl, instances);
+      k ++;
+      if (ncap[f])
+      {
+        glsl = wingl -> ogl_glsl[BONDS][s][k];
+        instances = allocfloat (glsl -> obj -> num_instances*PAIR_BUFF_SIZE);
+        nbs = 0;
+        setup_all_cylinder_vertices (f-1, FALSE, 1, 0, instances);
+        update_pair_instances (glsl, instances);
+        k ++;
+      }
+    }
+  }
+  send_atom_positions ();
+  if (s != step)
+  {
+    if (wingl -> ogl_glsl[BONDS][step] != NULL) g_free (wingl -> ogl_glsl[BONDS][step]);
+    wingl -> ogl_glsl[BONDS][step] = wingl -> ogl_glsl[BONDS][s];
+    wingl -> ogl_glsl[BONDS][s] = NULL;
+    wingl -> n_shaders[BONDS][s] = -1;
+    wingl -> bond_stream_step = step;
+  }
+  return TRUE;
+}
+
 /*!
   \fn int create_bond_lists (gboolean to_pick)
 
@@ -675,15 +868,13 @@ int create_bond_lists (gboolean to_pick)
   int nbds[7];
   int ncap[7];
   object_3d * cyl, * cap;
-  int f, g, h, i, j, k, l, m;
+  int f, g, h, i, j, k, l, m, n;
+  gboolean impostor;
 
-  if (! to_pick)
-  {
-    cleaning_shaders (wingl, BONDS);
-    wingl -> create_shaders[BONDS] = FALSE;
-  }
+  if (! to_pick) wingl -> create_shaders[BONDS] = FALSE;
 
   g = (plot -> draw_clones) ? 2 : 1;
+  pair_bonds = (! to_pick) ? use_atom_pairs () : FALSE;
 
   nbonds = allocqint (NUM_STYLES, g, proj_sp, proj_sp);
   if (! to_pick) ncaps = allocqint (NUM_STYLES, g, proj_sp, proj_sp);
@@ -703,7 +894,7 @@ int create_bond_lists (gboolean to_pick)
              nbonds[f][h][i][j] = find_bond_vertices (to_pick, f-1, i, j, h, 0);
              k += nbonds[f][h][i][j];
              if (nbonds[f][h][i][j] > 0) l ++;
-             if (! to_pick && ((! f && (plot -> style == BALL_AND_STICK || plot -> style == CYLINDERS)) || (f && (f-1 == BALL_AND_STICK || f-1 == CYLINDERS))))
+             if (! to_pick && bond_style_is_cylinder (f))
              {
                ncaps[f][h][i][j] = find_bond_vertices (to_pick, f-1, i, j, h, 1);
                m += ncaps[f][h][i][j];
@@ -713,7 +904,7 @@ int create_bond_lists (gboolean to_pick)
       }
       nbds[f] = k;
       ncap[f] = m;
-      if (to_pick || (((! f && (plot -> style == BALL_AND_STICK || plot -> style == CYLINDERS)) || (f && (f-1 == BALL_AND_STICK || f-1 == CYLINDERS)))))
+      if (to_pick || bond_style_is_cylinder (f))
       {
         if (k > 0)
         {
@@ -731,28 +922,90 @@ int create_bond_lists (gboolean to_pick)
 #ifdef DEBUG
   g_debug ("Bond LIST:: to_pick= %s, shaders= %d", (to_pick) ? "true" : "false", nshaders);
 #endif
-  if (nshaders == 0) return nshaders;
-  if (! to_pick) wingl -> ogl_glsl[BONDS][step] = g_malloc0 (nshaders*sizeof*wingl -> ogl_glsl[BONDS][step]);
+  if (! to_pick)
+  {
+    // A single set of bond shaders is kept, whatever the number of MD steps
+    if (nshaders && pair_bonds && stream_bond_lists (nbds, ncap))
+    {
+      g_free (nbonds);
+      g_free (ncaps);
+      pair_bonds = FALSE;
+      return nshaders;
+    }
+    free_bond_lists ();
+    cleaning_shaders (wingl, BONDS);
+  }
+  if (nshaders == 0)
+  {
+    pair_bonds = FALSE;
+    return nshaders;
+  }
+  if (! to_pick)
+  {
+    wingl -> ogl_glsl[BONDS][step] = g_malloc0 (nshaders*sizeof*wingl -> ogl_glsl[BONDS][step]);
+    wingl -> bond_stream_step = step;
+    wingl -> bond_stream_shaders = nshaders;
+    wingl -> bond_stream_key[0] = plot -> quality;
+    wingl -> bond_stream_key[1] = plot -> l_ghtning.lights;
+    wingl -> bond_stream_key[2] = plot -> style;
+    if (pair_bonds) send_atom_positions ();
+  }
   l = 0;
   for (f=0; f<NUM_STYLES; f++)
   {
     if (nbds[f])
     {
-      if (to_pick || (! f && (plot -> style == BALL_AND_STICK || plot -> style == CYLINDERS)) || (f && (f-1 == BALL_AND_STICK || f-1 == CYLINDERS)))
+      if (to_pick || bond_style_is_cylinder (f))
       {
-        cyl = draw_cylinder (plot -> quality, 1.0, 1.0);
-        cyl -> num_instances =  (nbds[f]/2) * (plot -> abc -> extra_cell[0]+1)*(plot -> abc -> extra_cell[1]+1)*(plot -> abc -> extra_cell[2]+1);
-        cyl -> inst_buffer_size = CYLI_BUFF_SIZE;
-        cyl -> instances = allocfloat (CYLI_BUFF_SIZE*cyl -> num_instances);
+        n = (nbds[f]/2) * (plot -> abc -> extra_cell[0]+1)*(plot -> abc -> extra_cell[1]+1)*(plot -> abc -> extra_cell[2]+1);
+        impostor = (! to_pick) ? use_impostors (n, cylinder_indices (plot -> quality)) : FALSE;
+        cyl = (impostor) ? draw_impostor_box () : draw_cylinder (plot -> quality, 1.0, 1.0);
+        cyl -> num_instances = n;
+        cyl -> inst_buffer_size = (pair_bonds) ? PAIR_BUFF_SIZE : CYLI_BUFF_SIZE;
+        cyl -> instances = allocfloat (cyl -> inst_buffer_size*cyl -> num_instances);
         nbs = 0;
         for (h=0; h<g; h++)
         {
           setup_all_cylinder_vertices (f-1, to_pick, 0, h, cyl -> instances);
-          if (to_pick && h==0) wingl -> bonds_to_be_picked = wingl -> to_be_picked;
         }
-        if (! to_pick)
+        if (pair_bonds)
+        {
+          // The cylinders are built on the GPU from the atom pairs
+          if (impostor)
+          {
+            wingl -> ogl_glsl[BONDS][step][l] = init_shader_program (BONDS, GLSL_CYLINDERS, pair_impostor_vertex, NULL, impostor_color(), GL_TRIANGLES, 4, 3, TRUE, cyl);
+            glsl_set_impostor (wingl -> ogl_glsl[BONDS][step][l]);
+          }
+          else
+          {
+            wingl -> ogl_glsl[BONDS][step][l] = init_shader_program (BONDS, GLSL_CYLINDERS, pair_cylinder_vertex, NULL, full_color, GL_TRIANGLE_STRIP, 4, 3, TRUE, cyl);
+          }
+          g_free (cyl);
+          l ++;
+          if (ncap[f] > 0)
+          {
+            cap = draw_cylinder_cap (plot -> quality, 1.0, FALSE);
+            cap -> num_instances = ncap[f]/2;
+            cap -> inst_buffer_size = PAIR_BUFF_SIZE;
+            cap -> instances = allocfloat (PAIR_BUFF_SIZE*cap -> num_instances);
+            nbs = 0;
+            setup_all_cylinder_vertices (f-1, FALSE, 1, 0, cap -> instances);
+            wingl -> ogl_glsl[BONDS][step][l] = init_shader_program (BONDS, GLSL_CAPS, pair_cap_vertex, NULL, full_color, GL_TRIANGLE_FAN, 4, 3, TRUE, cap);
+            g_free (cap);
+            l ++;
+          }
+        }
+        else if (! to_pick)
         {
-          wingl -> ogl_glsl[BONDS][step][l] = init_shader_program (BONDS, GLSL_CYLINDERS, cylinder_vertex, NULL, full_color, GL_TRIANGLE_STRIP, 6, 1, TRUE, cyl);
+          if (impostor)
+          {
+            wingl -> ogl_glsl[BONDS][step][l] = init_shader_program (BONDS, GLSL_CYLINDERS, cylinder_impostor_vertex, NULL, impostor_color(), GL_TRIANGLES, 6, 2, TRUE, cyl);
+            glsl_set_impostor (wingl -> ogl_glsl[BONDS][step][l]);
+          }
+          else
+          {
+            wingl -> ogl_glsl[BONDS][step][l] = init_shader_program (BONDS, GLSL_CYLINDERS, cylinder_vertex, NULL, full_color, GL_TRIANGLE_STRIP, 6, 1, TRUE, cyl);
+          }
           g_free (cyl);
           l ++;
           if (ncap[f] > 0)
@@ -807,5 +1060,6 @@ int create_bond_lists (gboolean to_pick)
   }
   g_free (nbonds);
   if (! to_pick) g_free (ncaps);
+  pair_bonds = FALSE;
   return nshaders;
 }
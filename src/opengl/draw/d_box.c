@@ -684,14 +684,14 @@ void cuboid_slab (mat4_t rot)
   for (i=0; i<proj_gl -> nspec; i++) wingl -> cell_win -> slab_lot[i] = 0;
   wingl -> cell_win -> slab_atoms = 0;
   float val, vbl;
-  atom slab_center;
+  atom_pos slab_center;
   distance at_slab;
   slab_center.x = cat.x;
   slab_center.y = cat.y;
   slab_center.z = cat.z;
   for (i=0; i<proj_gl->natomes; i++)
   {
-    at_slab = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, & proj_gl -> atoms[0][i], & slab_center);
+    at_slab = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, get_atom_pos (proj_gl, 0, i), slab_center);
     at = vec3(slab_center.x+at_slab.x, slab_center.y+at_slab.y, slab_center.z+at_slab.z);
     if (at.x <= pmax[0] && at.y <= pmax[1] && at.z <= pmax[2])
     {
@@ -803,15 +803,15 @@ void cylinder_slab (mat4_t rot)
   for (i=0; i<proj_gl -> nspec; i++) wingl -> cell_win -> slab_lot[i] = 0;
   wingl -> cell_win -> slab_atoms = 0;
   vec3_t atc, patc;
-  atom slab_center;
+  atom_pos slab_center;
   distance at_slab;
   slab_center.x = cat.x;
   slab_center.y = cat.y;
   slab_center.z = cat.z;
   for (i=0; i<proj_gl->natomes; i++)
   {
-    atc = vec3(proj_gl -> atoms[0][i].x, proj_gl -> atoms[0][i].y, proj_gl -> atoms[0][i].z);
-    at_slab = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, & proj_gl -> atoms[0][i], & slab_center);
+    atc = vec3(proj_gl -> pos[0][0][i], proj_gl -> pos[0][1][i], proj_gl -> pos[0][2][i]);
+    at_slab = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, get_atom_pos (proj_gl, 0, i), slab_center);
     if (wingl -> cell_win -> slab_pbc || ! at_slab.pbc)
     {
       atc = vec3(at_slab.x, at_slab.y, at_slab.z);
@@ -868,14 +868,14 @@ void spherical_slab ()
   vec3_t cat = vec3 (wingl -> cell_win -> cparam[6], wingl -> cell_win -> cparam[7], wingl -> cell_win -> cparam[8]);
   for (i=0; i<proj_gl -> nspec; i++) wingl -> cell_win -> slab_lot[i] = 0;
   wingl -> cell_win -> slab_atoms = 0;
-  atom slab_center;
+  atom_pos slab_center;
   distance at_slab;
   slab_center.x = cat.x;
   slab_center.y = cat.y;
   slab_center.z = cat.z;
   for (i=0; i<proj_gl->natomes; i++)
   {
-    at_slab = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, & proj_gl -> atoms[0][i], & slab_center);
+    at_slab = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, get_atom_pos (proj_gl, 0, i), slab_center);
     if (wingl -> cell_win -> slab_pbc || ! at_slab.pbc)
     {
       if (at_slab.length <= wingl -> cell_win -> cparam[14])
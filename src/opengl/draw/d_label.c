@@ -32,7 +32,7 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 
   int create_label_lists ();
 
-  void prepare_label (atom at, int id, double al);
+  void prepare_label (atom at, atom_pos pos, int id, double al);
   void clean_labels (int id);
 
   mat4_t create_label_matrices ();
@@ -59,15 +59,16 @@ mat4_t create_label_matrices ()
 }
 
 /*!
-  \fn void prepare_label (atom at, int id, double al)
+  \fn void prepare_label (atom at, atom_pos pos, int id, double al)
 
   \brief prepare an atomic label OpenGL rendering
 
   \param at the atom to label
+  \param pos the coordinates of the label
   \param id the label id
   \param al opacity
 */
-void prepare_label (atom at, int id, double al)
+void prepare_label (atom at, atom_pos pos, int id, double al)
 {
   int k, l;
   char * str = NULL;
@@ -130,7 +131,7 @@ void prepare_label (atom at, int id, double al)
     str = g_strdup_printf ("%s", tmp);
     g_free (tmp);
   }
-  prepare_string (str, id, lcol, vec3(at.x, at.y, at.z), shift, NULL, NULL, NULL);
+  prepare_string (str, id, lcol, vec3(pos.x, pos.y, pos.z), shift, NULL, NULL, NULL);
   g_free (str);
 }
 
@@ -143,9 +144,32 @@ void prepare_label (atom at, int id, double al)
 */
 void clean_labels (int id)
 {
+  screen_string * this_string, * prev_string;
+  gboolean head = FALSE;
+  if (plot -> labels[id].words != NULL)
+  {
+    g_hash_table_destroy (plot -> labels[id].words);
+    plot -> labels[id].words = NULL;
+  }
   if (plot -> labels[id].list != NULL)
   {
-    g_free (plot -> labels[id].list);
+    this_string = plot -> labels[id].list -> last;
+    while (this_string != NULL)
+    {
+      if (this_string == plot -> labels[id].list) head = TRUE;
+      prev_string = this_string -> prev;
+      g_free (this_string -> word);
+      g_free (this_string -> instances);
+      g_free (this_string);
+      this_string = prev_string;
+    }
+    // A copied list does not share its head with the chain of strings
+    if (! head)
+    {
+      g_free (plot -> labels[id].list -> word);
+      g_free (plot -> labels[id].list -> instances);
+      g_free (plot -> labels[id].list);
+    }
     plot -> labels[id].list = NULL;
   }
 }
@@ -161,6 +185,7 @@ int create_label_lists ()
   int i, j, k;
   float x, y, z;
   atom ato;
+  atom_pos ato_pos;
 
 #ifdef DEBUG
   g_debug ("Label LIST");
@@ -176,7 +201,7 @@ int create_label_lists ()
     {
       if (plot -> at_data[i].show[0] && plot -> at_data[i].label[0])
       {
-        prepare_label (proj_gl -> atoms[step][i], 0, 1.0);
+        prepare_label (proj_gl -> atoms[step][i], get_atom_pos (proj_gl, step, i), 0, 1.0);
       }
     }
     if (plot -> draw_clones)
@@ -188,24 +213,24 @@ int create_label_lists ()
         z = wingl -> clones[step][i].z;
         j = wingl -> bondid[step][1][i][0];
         k = wingl -> bondid[step][1][i][1];
-        ato.x = proj_gl -> atoms[step][j].x - x;
-        ato.y = proj_gl -> atoms[step][j].y - y;
-        ato.z = proj_gl -> atoms[step][j].z - z;
+        ato_pos.x = proj_gl -> pos[step][0][j] - x;
+        ato_pos.y = proj_gl -> pos[step][1][j] - y;
+        ato_pos.z = proj_gl -> pos[step][2][j] - z;
         ato.sp = proj_gl -> atoms[step][j].sp;
         ato.id = k;
         ato.pick[0] = plot -> at_data[k].pick[0];
         ato.pick[1] = plot -> at_data[k].pick[1];
         ato.style = plot -> at_data[k].style;
-        if (plot -> at_data[k].show[1] && plot -> at_data[k].label[1]) prepare_label (ato, 1, 0.75);
-        ato.x = proj_gl -> atoms[step][k].x + x;
-        ato.y = proj_gl -> atoms[step][k].y + y;
-        ato.z = proj_gl -> atoms[step][k].z + z;
+        if (plot -> at_data[k].show[1] && plot -> at_data[k].label[1]) prepare_label (ato, ato_pos, 1, 0.75);
+        ato_pos.x = proj_gl -> pos[step][0][k] + x;
+        ato_pos.y = proj_gl -> pos[step][1][k] + y;
+        ato_pos.z = proj_gl -> pos[step][2][k] + z;
         ato.sp = proj_gl -> atoms[step][k].sp;
         ato.id = j;
         ato.pick[0] = plot -> at_data[j].pick[0];
         ato.pick[1] = plot -> at_data[j].pick[1];
         ato.style = plot -> at_data[j].style;
-        if (plot -> at_data[j].show[1] && plot -> at_data[j].label[1]) prepare_label (ato, 1, 0.75);
+        if (plot -> at_data[j].show[1] && plot -> at_data[j].label[1]) prepare_label (ato, ato_pos, 1, 0.75);
       }
     }
   }
@@ -215,7 +240,7 @@ int create_label_lists ()
     {
       if (proj_gl -> atoms[step][i].show[0] && proj_gl -> atoms[step][i].label[0])
       {
-        prepare_label (proj_gl -> atoms[step][i], 0, 1.0);
+        prepare_label (proj_gl -> atoms[step][i], get_atom_pos (proj_gl, step, i), 0, 1.0);
       }
     }
     if (plot -> draw_clones)
@@ -227,24 +252,24 @@ int create_label_lists ()
         z = wingl -> clones[step][i].z;
         j = wingl -> bondid[step][1][i][0];
         k = wingl -> bondid[step][1][i][1];
-        ato.x = proj_gl -> atoms[step][j].x - x;
-        ato.y = proj_gl -> atoms[step][j].y - y;
-        ato.z = proj_gl -> atoms[step][j].z - z;
+        ato_pos.x = proj_gl -> pos[step][0][j] - x;
+        ato_pos.y = proj_gl -> pos[step][1][j] - y;
+        ato_pos.z = proj_gl -> pos[step][2][j] - z;
         ato.sp = proj_gl -> atoms[step][k].sp;
         ato.id = k;
         ato.pick[0] = proj_gl -> atoms[step][k].pick[0];
         ato.pick[1] = proj_gl -> atoms[step][k].pick[1];
         ato.style = proj_gl -> atoms[step][k].style;
-        if (proj_gl -> atoms[step][k].show[1] && proj_gl -> atoms[step][k].label[1]) prepare_label (ato, 1, 0.75);
-        ato.x = proj_gl -> atoms[step][k].x + x;
-        ato.y = proj_gl -> atoms[step][k].y + y;
-        ato.z = proj_gl -> atoms[step][k].z + z;
+        if (proj_gl -> atoms[step][k].show[1] && proj_gl -> atoms[step][k].label[1]) prepare_label (ato, ato_pos, 1, 0.75);
+        ato_pos.x = proj_gl -> pos[step][0][k] + x;
+        ato_pos.y = proj_gl -> pos[step][1][k] + y;
+        ato_pos.z = proj_gl -> pos[step][2][k] + z;
         ato.sp = proj_gl -> atoms[step][j].sp;
         ato.id = j;
         ato.pick[0] = proj_gl -> atoms[step][j].pick[0];
         ato.pick[1] = proj_gl -> atoms[step][j].pick[1];
         ato.style = proj_gl -> atoms[step][j].style;
-        if (proj_gl -> atoms[step][j].show[1] && proj_gl -> atoms[step][j].label[1]) prepare_label (ato, 1, 0.75);
+        if (proj_gl -> atoms[step][j].show[1] && proj_gl -> atoms[step][j].label[1]) prepare_label (ato, ato_pos, 1, 0.75);
       }
     }
   }
@@ -252,10 +277,10 @@ int create_label_lists ()
   if (plot -> labels[0].list != NULL || plot -> labels[1].list != NULL)
   {
     nshaders = 0;
-    if (plot -> labels[0].list != NULL) nshaders += (plot -> labels[0].render + 1) * (plot -> labels[0].list -> last -> id + 1);
+    nshaders += string_shaders (0);
     if (plot -> draw_clones && plot -> labels[1].list != NULL)
     {
-      nshaders += (plot -> labels[1].render + 1) * (plot -> labels[1].list -> last -> id + 1);
+      nshaders += string_shaders (1);
     }
     wingl -> ogl_glsl[LABEL][0] = g_malloc0 (nshaders*sizeof*wingl -> ogl_glsl[LABEL][0]);
     for (i=0; i<2; i++) render_all_strings (LABEL, i);
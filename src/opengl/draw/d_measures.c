@@ -32,12 +32,12 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 
   int prepare_measure_shaders (int type, int shaders);
 
-  void draw_angle_label (atom * at, atom * bt, atom * ct, int pi);
+  void draw_angle_label (atom_pos * at, atom_pos * bt, atom_pos * ct, int pi);
   void set_measure_color (int selected, int id, int num);
   void setup_this_measured_angle (int s, int sa, int sb, int sc, int pi);
   void angles_loop (glwin * view, int id, int pi, GtkTreeStore * store);
   void dihedrals_loop (glwin * view, int id, int pi, GtkTreeStore * store);
-  void draw_bond_label (atom * at, atom * bt, int pi);
+  void draw_bond_label (atom_pos * at, atom_pos * bt, int pi);
   void setup_this_measured_bond (int s, int sa, int sb, int pi);
   void bonds_loop (glwin * view, int id, int pi, GtkTreeStore * store);
   void create_measures_lists ();
@@ -78,7 +78,7 @@ ColRGBA col;
 ColRGBA col_gdk;
 
 /*!
-  \fn void draw_angle_label (atom * at, atom * bt, atom * ct, int pi)
+  \fn void draw_angle_label (atom_pos * at, atom_pos * bt, atom_pos * ct, int pi)
 
   \brief prepare an measured angle label OpenGL rendering
 
@@ -87,9 +87,9 @@ ColRGBA col_gdk;
   \param ct 3rd atom
   \param pi 0 = mouse analysis mode, 1 = mouse edition mode
 */
-void draw_angle_label (atom * at, atom * bt, atom * ct, int pi)
+void draw_angle_label (atom_pos * at, atom_pos * bt, atom_pos * ct, int pi)
 {
-  angle real_theta = angle_3d (cell_gl, (cell_gl -> npt) ? step : 0, at, bt, ct);
+  angle real_theta = angle_3d (cell_gl, (cell_gl -> npt) ? step : 0, * at, * bt, * ct);
   gchar * str;
   if (real_theta.pbc)
   {
@@ -146,10 +146,10 @@ void setup_this_measured_angle (int s, int sa, int sb, int sc, int pi)
   float shift[3];
   int p, q, r;
   vec3_t pos_a, pos_b, pos_c;
-  atom * at, * bt, * ct;
-  at = & proj_gl -> atoms[step][sa];
-  bt = & proj_gl -> atoms[step][sb];
-  ct = & proj_gl -> atoms[step][sc];
+  atom_pos at, bt, ct;
+  at = get_atom_pos (proj_gl, step, sa);
+  bt = get_atom_pos (proj_gl, step, sb);
+  ct = get_atom_pos (proj_gl, step, sc);
 
   for (p=0; p<plot -> abc -> extra_cell[0]+1;p++)
   {
@@ -160,12 +160,12 @@ void setup_this_measured_angle (int s, int sa, int sb, int sc, int pi)
         shift[0]=p*box_gl -> vect[0][0]+q*box_gl -> vect[1][0]+r*box_gl -> vect[2][0];
         shift[1]=p*box_gl -> vect[0][1]+q*box_gl -> vect[1][1]+r*box_gl -> vect[2][1];
         shift[2]=p*box_gl -> vect[0][2]+q*box_gl -> vect[1][2]+r*box_gl -> vect[2][2];
-        at_shift (at, shift);
-        at_shift (bt, shift);
-        at_shift (ct, shift);
-        pos_a = vec3(at -> x, at -> y, at -> z);
-        pos_b = vec3(bt -> x, bt -> y, bt -> z);
-        pos_c = vec3(ct -> x, ct -> y, ct -> z);
+        at_shift (& at, shift);
+        at_shift (& bt, shift);
+        at_shift (& ct, shift);
+        pos_a = vec3(at.x, at.y, at.z);
+        pos_b = vec3(bt.x, bt.y, bt.z);
+        pos_c = vec3(ct.x, ct.y, ct.z);
         if (s == 0)
         {
           setup_line_vertice (measure -> vertices, pos_a, col, alpha);
@@ -175,11 +175,11 @@ void setup_this_measured_angle (int s, int sa, int sb, int sc, int pi)
         else
         {
           // Text location for the instances !
-          draw_angle_label (at, bt, ct, pi);
+          draw_angle_label (& at, & bt, & ct, pi);
         }
-        at_unshift (at, shift);
-        at_unshift (bt, shift);
-        at_unshift (ct, shift);
+        at_unshift (& at, shift);
+        at_unshift (& bt, shift);
+        at_unshift (& ct, shift);
         alpha = 0.5;
       }
     }
@@ -427,7 +427,7 @@ void dihedrals_loop (glwin * view, int id, int pi, GtkTreeStore * store)
 }
 
 /*!
-  \fn void draw_bond_label (atom * at, atom * bt, int pi)
+  \fn void draw_bond_label (atom_pos * at, atom_pos * bt, int pi)
 
   \brief prepare a measured distance OpenGL rendering
 
@@ -435,9 +435,9 @@ void dihedrals_loop (glwin * view, int id, int pi, GtkTreeStore * store)
   \param bt 2nd atom
   \param pi 0 = mouse analysis mode, 1 = mouse edition mode
 */
-void draw_bond_label (atom * at, atom * bt, int pi)
+void draw_bond_label (atom_pos * at, atom_pos * bt, int pi)
 {
-  distance dist = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, at, bt);
+  distance dist = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, * at, * bt);
   vec3_t pos;
   if (dist.pbc)
   {
@@ -477,9 +477,9 @@ void setup_this_measured_bond (int s, int sa, int sb, int pi)
   float shift[3];
   int p, q, r;
   vec3_t pos_a, pos_b;
-  atom * at, * bt;
-  at = & proj_gl -> atoms[step][sa];
-  bt = & proj_gl -> atoms[step][sb];
+  atom_pos at, bt;
+  at = get_atom_pos (proj_gl, step, sa);
+  bt = get_atom_pos (proj_gl, step, sb);
 
   for (p=0; p<plot -> abc -> extra_cell[0]+1;p++)
   {
@@ -490,10 +490,10 @@ void setup_this_measured_bond (int s, int sa, int sb, int pi)
         shift[0]=p*box_gl -> vect[0][0]+q*box_gl -> vect[1][0]+r*box_gl -> vect[2][0];
         shift[1]=p*box_gl -> vect[0][1]+q*box_gl -> vect[1][1]+r*box_gl -> vect[2][1];
         shift[2]=p*box_gl -> vect[0][2]+q*box_gl -> vect[1][2]+r*box_gl -> vect[2][2];
-        at_shift (at, shift);
-        at_shift (bt, shift);
-        pos_a = vec3(at -> x, at -> y, at -> z);
-        pos_b = vec3(bt -> x, bt -> y, bt -> z);
+        at_shift (& at, shift);
+        at_shift (& bt, shift);
+        pos_a = vec3(at.x, at.y, at.z);
+        pos_b = vec3(bt.x, bt.y, bt.z);
         if (s == 0)
         {
           setup_line_vertice (measure -> vertices, pos_a, col, alpha);
@@ -502,10 +502,10 @@ void setup_this_measured_bond (int s, int sa, int sb, int pi)
         else
         {
           // Text location for the instances !
-          draw_bond_label (at, bt, pi);
+          draw_bond_label (& at, & bt, pi);
         }
-        at_unshift (at, shift);
-        at_unshift (bt, shift);
+        at_unshift (& at, shift);
+        at_unshift (& bt, shift);
         alpha = 0.5;
       }
     }
@@ -703,7 +703,7 @@ void create_measures_lists ()
       if (plot -> labels[3+j].list != NULL)
       {
         // shaders for the labels if any
-        wingl -> n_shaders[MEASU][j] += (plot -> labels[3+j].render+1) * (plot -> labels[3+j].list -> last -> id + 1);
+        wingl -> n_shaders[MEASU][j] += string_shaders (3+j);
       }
     }
   }
@@ -30,20 +30,22 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 *
 * List of functions:
 
-  int is_atom_cloned (int at);
+  int convex_hull (int s, vec3_t * p, int * faces);
 
-  gboolean is_inside (vec3_t p, float * mi, float * ma);
-  gboolean is_in_triangle (vec3_t p, vec3_t a, vec3_t b, vec3_t c);
-  gboolean check_it (int i, int j, int k, int l);
+  static int planar_hull (int s, vec3_t * p, vec3_t u, vec3_t n, int * faces);
+
+  static float face_distance (vec3_t * p, int * face, int i);
+  static float turn_2d (float * x, float * y, int a, int b, int c);
 
   void setup_summit (float * vertices, vec3_t s, vec3_t n);
   void setup_triangles (float * vertices, vec3_t sa, vec3_t sb, vec3_t sc);
-  void setup_polyhedron (float * vertices, GLfloat ** xyz, int s);
+  void setup_polyhedron (float * vertices, GLfloat ** xyz, int triangles, int * faces);
   void setup_tetra (float * vertices, vec3_t a, vec3_t b, vec3_t c, vec3_t d);
   void setup_tetrahedron (float * vertices, GLfloat ** xyz);
   void get_centroid (GLfloat ** xyz, int id);
-  void check_triangles (int s, GLfloat ** xyz);
-  void prepare_poly_gl (float * vertices, atom at, int c);
+  void free_poly_hulls (glwin * view);
+  void update_poly_hull (poly_hull * hull, atom * at);
+  void prepare_poly_gl (float * vertices, atom at, int c, poly_hull * hull);
   void create_poly_lists ();
 
   vec3_t get_triangle_normal (vec3_t v1, vec3_t v2, vec3_t v3);
@@ -55,7 +57,10 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 #include "color_box.h"
 #include "dlp_field.h"
 
-gboolean * do_gl;
+#ifdef OPENMP
+#  include <omp.h>
+#endif
+
 vec3_t centroid;
 ColRGBA pcol;
 
@@ -141,17 +146,18 @@ void setup_triangles (float * vertices, vec3_t sa, vec3_t sb, vec3_t sc)
 }*/
 
 /*!
-  \fn void setup_polyhedron (float * vertices, GLfloat ** xyz, int s)
+  \fn void setup_polyhedron (float * vertices, GLfloat ** xyz, int triangles, int * faces)
 
   \brief fill the OpenGL data buffer for a polyhedron to render
 
   \param vertices the OpenGL buffer data to fill
   \param xyz the summits coordinates
-  \param s the number of summits
+  \param triangles the number of triangles
+  \param faces the summits of each triangle, as given by 'convex_hull'
 */
-void setup_polyhedron (float * vertices, GLfloat ** xyz, int s)
+void setup_polyhedron (float * vertices, GLfloat ** xyz, int triangles, int * faces)
 {
-  int i, j, k, l, n, o, p, q, r;
+  int i, j, k, l, n, o, p;
   vec3_t a, b, c;
   float shift[3];
   poly_alpha = 1.0;
@@ -164,34 +170,17 @@ void setup_polyhedron (float * vertices, GLfloat ** xyz, int s)
         shift[0]=n*box_gl -> vect[0][0]+o*box_gl -> vect[1][0]+p*box_gl -> vect[2][0];
         shift[1]=n*box_gl -> vect[0][1]+o*box_gl -> vect[1][1]+p*box_gl -> vect[2][1];
         shift[2]=n*box_gl -> vect[0][2]+o*box_gl -> vect[1][2]+p*box_gl -> vect[2][2];
-        for (q=0; q<s; q++)
+        for (l=0; l<triangles; l++)
         {
-          for (r=0; r<3; r++) xyz[q][r] += shift[r];
-        }
-
-        l = 0;
-        for (i=0; i<s-2; i++)
-        {
-          for (j=i+1; j<s-1; j++)
-          {
-            for (k=j+1; k<s; k++)
-            {
-              if (do_gl[l])
-              {
-                a = vec3 (xyz[i][0], xyz[i][1], xyz[i][2]);
-                b = vec3 (xyz[j][0], xyz[j][1], xyz[j][2]);
-                c = vec3 (xyz[k][0], xyz[k][1], xyz[k][2]);
-                setup_triangles (vertices, a, b ,c);
-              }
-              l ++;
-            }
-          }
+          i = faces[3*l];
+          j = faces[3*l+1];
+          k = faces[3*l+2];
+          a = vec3 (xyz[i][0]+shift[0], xyz[i][1]+shift[1], xyz[i][2]+shift[2]);
+          b = vec3 (xyz[j][0]+shift[0], xyz[j][1]+shift[1], xyz[j][2]+shift[2]);
+          c = vec3 (xyz[k][0]+shift[0], xyz[k][1]+shift[1], xyz[k][2]+shift[2]);
+          setup_triangles (vertices, a, b ,c);
         }
         poly_alpha = 0.5;
-        for (q=0; q<s; q++)
-        {
-          for (r=0; r<3; r++) xyz[q][r] -= shift[r];
-        }
       }
     }
   }
@@ -278,354 +267,405 @@ void get_centroid (GLfloat ** xyz, int id)
 }
 
 /*!
-  \fn gboolean is_inside (vec3_t p, float * mi, float * ma)
+  \fn static float face_distance (vec3_t * p, int * face, int i)
 
-  \brief is this point inside the polyhedron ?
+  \brief signed distance from a point to the plane of a triangle, positive outside of the hull
 
-  \param p the position to test
-  \param mi the min values in the summits coordinates on each axis
-  \param ma the max values in the summits coordinates on each axis
+  \param p the points
+  \param face the 3 summits of the triangle
+  \param i the point to test
 */
-gboolean is_inside (vec3_t p, float * mi, float * ma)
+static float face_distance (vec3_t * p, int * face, int i)
 {
-  if (p.x > mi[0] && p.x < ma[0])
-  {
-    if (p.y > mi[1] && p.y < ma[1])
-    {
-      if (p.z > mi[2] && p.z < ma[2])
-      {
-        return TRUE;
-      }
-    }
-  }
-  return FALSE;
+  vec3_t n = v3_norm (v3_cross (v3_sub (p[face[1]], p[face[0]]), v3_sub (p[face[2]], p[face[0]])));
+  return v3_dot (n, v3_sub (p[i], p[face[0]]));
 }
 
 /*!
-  \fn gboolean is_in_triangle (vec3_t p, vec3_t a, vec3_t b, vec3_t c)
+  \fn static float turn_2d (float * x, float * y, int a, int b, int c)
 
-  \brief is this point inside a triangle ?
+  \brief orientation of 3 points in a plane: > 0 if counter-clockwise
 
-  \param p the position to test
-  \param a 1st summit of the triangle
-  \param b 2nd summit of the triangle
-  \param c 3rd summit of the triangle
+  \param x the x coordinates
+  \param y the y coordinates
+  \param a 1st point
+  \param b 2nd point
+  \param c 3rd point
 */
-gboolean is_in_triangle (vec3_t p, vec3_t a, vec3_t b, vec3_t c)
+static float turn_2d (float * x, float * y, int a, int b, int c)
 {
-  float area = 0.5 * v3_length(v3_cross(v3_sub(a, b), v3_sub(a, c)));
-  float alpha = v3_length(v3_cross(v3_sub(p, b), v3_sub(p, c))) / (2.0*area);
-  float beta = v3_length(v3_cross(v3_sub(p, c), v3_sub(p, a))) / (2.0*area);
-  float gamma = 1 - alpha - beta;
-  if ((alpha >= 0.0 && alpha <= 1.0) && (beta >= 0.0 && beta <= 1.0) && (gamma >= 0.0 && gamma <= 1.0))
-  {
-    return TRUE;
-  }
-  else
-  {
-    return FALSE;
-  }
+  return (x[b]-x[a])*(y[c]-y[a]) - (y[b]-y[a])*(x[c]-x[a]);
 }
 
 /*!
-  \fn gboolean check_it (int i, int j, int k, int l)
+  \fn static int planar_hull (int s, vec3_t * p, vec3_t u, vec3_t n, int * faces)
 
-  \brief test this atom id ?
+  \brief triangles of the convex hull of coplanar points: a fan over the 2D hull, returns the number of triangles
 
-  \param i 1st summit atom id
-  \param j 2nd summit atom id
-  \param k 3rd summit atom id
-  \param l atom id to test
+  \param s the number of points
+  \param p the points
+  \param u a unit vector in the plane
+  \param n the unit normal of the plane
+  \param faces the summits of each triangle, to fill
 */
-gboolean check_it (int i, int j, int k, int l)
+static int planar_hull (int s, vec3_t * p, vec3_t u, vec3_t n, int * faces)
 {
-  if (l != i && l != j && l != k)
+  int i, j, k, l;
+  int * order = allocint (s);
+  int * hull = allocint (2*s);
+  float * x = allocfloat (s);
+  float * y = allocfloat (s);
+  vec3_t v = v3_cross (n, u);
+  for (i=0; i<s; i++)
   {
-    return TRUE;
+    x[i] = v3_dot (v3_sub (p[i], p[0]), u);
+    y[i] = v3_dot (v3_sub (p[i], p[0]), v);
+    // Sorted by x then y
+    for (j=i; j>0; j--)
+    {
+      k = order[j-1];
+      if (x[k] < x[i] || (x[k] == x[i] && y[k] <= y[i])) break;
+      order[j] = k;
+    }
+    order[j] = i;
   }
-  else
+  // Monotone chain, lower then upper hull
+  k = 0;
+  for (i=0; i<s; i++)
   {
-    return FALSE;
+    l = order[i];
+    while (k >= 2 && turn_2d (x, y, hull[k-2], hull[k-1], l) <= 0.0) k --;
+    hull[k] = l;
+    k ++;
   }
+  j = k + 1;
+  for (i=s-2; i>-1; i--)
+  {
+    l = order[i];
+    while (k >= j && turn_2d (x, y, hull[k-2], hull[k-1], l) <= 0.0) k --;
+    hull[k] = l;
+    k ++;
+  }
+  // The last point is the first one
+  k --;
+  l = 0;
+  for (i=1; i<k-1; i++)
+  {
+    faces[3*l] = hull[0];
+    faces[3*l+1] = hull[i];
+    faces[3*l+2] = hull[i+1];
+    l ++;
+  }
+  g_free (order);
+  g_free (hull);
+  g_free (x);
+  g_free (y);
+  return l;
 }
 
 /*!
-  \fn void check_triangles (int s, GLfloat ** xyz)
+  \fn int convex_hull (int s, vec3_t * p, int * faces)
 
-  \brief check triangle intersection
+  \brief compute the triangles of the convex hull of a set of points, returns the number of triangles:
+  \brief incremental construction, faces are oriented outward, coplanar points give a flat polygon
 
-  \param s number of summits for the polygon
-  \param xyz the coordinates of the summits
+  \param s the number of points
+  \param p the points
+  \param faces the summits of each triangle, to fill, room for 2*s triangles
 */
-void check_triangles (int s, GLfloat ** xyz)
+int convex_hull (int s, vec3_t * p, int * faces)
 {
-  int h, i, j, k, l, m, n;
-  float d, r;
-  float vd, v0;
-  vec3_t vi, vj, vk, vl, vm;
-  vec3_t u, v, w;
-  vec3_t p, pt;
-  float min_c[3], min_p[3];
-  float max_c[3], max_p[3];
-
-  i = s*(s-1)*(s-2)/6;
-  do_gl = allocbool (i);
-
-  for (i=0; i<3; i++)
+  int i, j, k, l, m;
+  int nf, ne;
+  int ids[4];
+  int * edges;
+  gboolean * visible;
+  gboolean shared;
+  float d, dmax, eps;
+  vec3_t u, n, c;
+
+  if (s < 3) return 0;
+  // Initial tetrahedron: the farthest point from the first one,
+  // then the farthest from that line, then the farthest from that plane
+  ids[0] = 0;
+  ids[1] = ids[2] = ids[3] = 0;
+  dmax = 0.0;
+  for (i=1; i<s; i++)
+  {
+    d = v3_length (v3_sub (p[i], p[0]));
+    if (d > dmax)
+    {
+      dmax = d;
+      ids[1] = i;
+    }
+  }
+  eps = 1e-4 * dmax;
+  if (dmax == 0.0) return 0;
+  u = v3_norm (v3_sub (p[ids[1]], p[0]));
+  dmax = 0.0;
+  for (i=1; i<s; i++)
   {
-    min_c[i] = max_c[i] = xyz[0][i];
+    d = v3_length (v3_cross (u, v3_sub (p[i], p[0])));
+    if (d > dmax)
+    {
+      dmax = d;
+      ids[2] = i;
+    }
   }
+  if (dmax < eps) return 0;
+  n = v3_norm (v3_cross (u, v3_sub (p[ids[2]], p[0])));
+  dmax = 0.0;
   for (i=1; i<s; i++)
   {
-    for (j=0; j<3; j++)
+    d = fabs (v3_dot (n, v3_sub (p[i], p[0])));
+    if (d > dmax)
     {
-      min_c[j] = min (min_c[j], xyz[i][j]);
-      max_c[j] = max (max_c[j], xyz[i][j]);
+      dmax = d;
+      ids[3] = i;
     }
   }
-  // We will build the polygon using triangles
-  // to ensure that we need to draw a particular triangle
-  // we need to check:
-  // 1) that the planes to be selected do not contains (cover) any atom or summit,
-  //    ie. that the projection of the atom coordinates onto the plane do not belong
-  //    to the triangle defined by the 3 points.
-  // 2) that the planes already selected and described by the 3 points
-  // do not intersect with any other couple of edges inside the entire polygon
-
-  // 1)
-  /*h = -1;
-  for (i=0; i<s-2; i++)
+  if (dmax < eps) return planar_hull (s, p, u, n, faces);
+
+  c = v3_divs (v3_add (v3_add (p[ids[0]], p[ids[1]]), v3_add (p[ids[2]], p[ids[3]])), 4.0);
+  nf = 0;
+  for (i=0; i<2; i++)
   {
-    for (j=i+1; j<s-1; j++)
+    for (j=i+1; j<3; j++)
     {
-      for (k=j+1; k<s; k++)
+      for (k=j+1; k<4; k++)
       {
-        h ++;
-        do_gl[h] = TRUE;
-        if (j-i > 1 && k-j > 1)
+        faces[3*nf] = ids[i];
+        faces[3*nf+1] = ids[j];
+        faces[3*nf+2] = ids[k];
+        if (v3_dot (v3_cross (v3_sub (p[ids[j]], p[ids[i]]), v3_sub (p[ids[k]], p[ids[i]])), v3_sub (c, p[ids[i]])) > 0.0)
         {
+          faces[3*nf+1] = ids[k];
+          faces[3*nf+2] = ids[j];
+        }
+        nf ++;
+      }
+    }
+  }
 
-
-        // check the plane defined by the 3 points i, j and k
-        vi = vec3(xyz[i][0], xyz[i][1], xyz[i][2]);
-        vj = vec3(xyz[j][0], xyz[j][1], xyz[j][2]);
-        vk = vec3(xyz[k][0], xyz[k][1], xyz[k][2]);
-        u = v3_sub (vi, vj);
-        v = v3_sub (vi, vk);
-        p = v3_norm(v3_cross (u, v));
-        for (l=0; l<s; l++)
+  visible = allocbool (2*s);
+  edges = allocint (12*s);
+  for (i=0; i<s; i++)
+  {
+    if (i == ids[0] || i == ids[1] || i == ids[2] || i == ids[3]) continue;
+    m = 0;
+    for (j=0; j<nf; j++)
+    {
+      visible[j] = (face_distance (p, & faces[3*j], i) > eps) ? TRUE : FALSE;
+      if (visible[j]) m ++;
+    }
+    // Inside the hull
+    if (! m) continue;
+    // The horizon: edges of the visible faces shared with a hidden face
+    ne = 0;
+    for (j=0; j<nf; j++)
+    {
+      if (! visible[j]) continue;
+      for (k=0; k<3; k++)
+      {
+        shared = FALSE;
+        for (l=0; l<nf; l++)
         {
-          if (check_it (i, j, k, l))
+          if (l == j || ! visible[l]) continue;
+          for (m=0; m<3; m++)
           {
-            vl = vec3(xyz[l][0], xyz[l][1], xyz[l][2]);
-            w = v3_sub (vl, vi);
-            pt = v3_sub (vl, v3_muls (p, v3_dot (w, p)));
-            if (is_in_triangle (pt, vi, vj, vk))
+            if (faces[3*l+m] == faces[3*j+(k+1)%3] && faces[3*l+(m+1)%3] == faces[3*j+k])
             {
-              do_gl[h] = FALSE;
+              shared = TRUE;
               break;
             }
           }
+          if (shared) break;
         }
+        if (! shared)
+        {
+          edges[2*ne] = faces[3*j+k];
+          edges[2*ne+1] = faces[3*j+(k+1)%3];
+          ne ++;
         }
       }
     }
-  }*/
-  // 2)
-  h = -1;
-  for (i=0; i<s-2; i++)
+    m = 0;
+    for (j=0; j<nf; j++)
+    {
+      if (! visible[j])
+      {
+        for (k=0; k<3; k++) faces[3*m+k] = faces[3*j+k];
+        m ++;
+      }
+    }
+    nf = m;
+    for (j=0; j<ne; j++)
+    {
+      faces[3*nf] = edges[2*j];
+      faces[3*nf+1] = edges[2*j+1];
+      faces[3*nf+2] = i;
+      nf ++;
+    }
+  }
+  g_free (visible);
+  g_free (edges);
+  return nf;
+}
+
+/*!
+  \fn void free_poly_hulls (glwin * view)
+
+  \brief free the coordination polyhedra cached for all MD steps
+
+  \param view the target glwin
+*/
+void free_poly_hulls (glwin * view)
+{
+  int i, j;
+  if (view -> poly_hulls)
   {
-    for (j=i+1; j<s-1; j++)
+    for (i=0; i<view -> poly_hull_steps; i++)
     {
-      for (k=j+1; k<s; k++)
+      if (view -> poly_hulls[i])
       {
-        h ++;
-        do_gl[h] = TRUE;
-        if (do_gl[h])
+        for (j=0; j<view -> poly_hull_atoms; j++)
         {
-          // check the plane defined by the 3 points i, j and k
-          vi = vec3(xyz[i][0], xyz[i][1], xyz[i][2]);
-          vj = vec3(xyz[j][0], xyz[j][1], xyz[j][2]);
-          vk = vec3(xyz[k][0], xyz[k][1], xyz[k][2]);
-
-          u = v3_sub (vi, vj);
-          v = v3_sub (vi, vk);
-          p = v3_cross (u, v);
-          d = - v3_dot (p, vi);
-
-          // Now lets look for the intersections with all the other couple of edges that are not i, j and k
-          for (l=0; l<s-1; l++)
-          {
-            if (check_it (i, j, k, l))
-            {
-              vl = vec3(xyz[l][0], xyz[l][1], xyz[l][2]);
-              for (m=l+1; m<s; m++)
-              {
-                if (check_it (i, j, k, m))
-                {
-                  vm = vec3(xyz[m][0], xyz[m][1], xyz[m][2]);
-                  w = v3_sub (vl, vm);
-                  vd = - (v3_dot (p, vm) + d);
-                  v0 = v3_dot (p, w);
-                  r = vd / v0;
-                  if (r != 0.0)
-                  {
-                    // Now we know where the plane (i, j, k) and the ray (l, m) intersect
-                    // We do not want to draw the plane (i, j, k) only if
-                    // the intersection is located somewhere inside the polygon
-                    pt = v3_add (v3_muls(w, r), vm);
-                    if (is_inside (pt, min_c, max_c))
-                    {
-                      for (n=0; n<3; n++)
-                      {
-                        min_p[n] = min(xyz[l][n], xyz[m][n]);
-                        max_p[n] = max(xyz[l][n], xyz[m][n]);
-                      }
-                      if (is_inside(pt, min_p, max_p))
-                      {
-                        //g_debug ("DISCARD:: i= %d, summit[%d]= %d, j= %d, summit[%d]= %d, k= %d, summit[%d]= %d",
-                        //         i, i, summit[i], j, j, summit[j], k, k, summit[k]);
-                        //g_debug ("BECAUSE OF:: l= %d, summit[%d]= %d, m= %d, summit[%d]= %d",
-                        //                l, l, summit[l], m, m, summit[m]);
-                        do_gl[h] = FALSE;
-                        break;
-                      }
-                    }
-                  }
-                }
-              }
-              if (! do_gl[h]) break;
-            }
-          }
+          if (view -> poly_hulls[i][j].xyz) g_free (view -> poly_hulls[i][j].xyz);
+          if (view -> poly_hulls[i][j].faces) g_free (view -> poly_hulls[i][j].faces);
         }
+        g_free (view -> poly_hulls[i]);
       }
     }
+    g_free (view -> poly_hulls);
+    view -> poly_hulls = NULL;
   }
+  view -> poly_hull_atoms = view -> poly_hull_steps = 0;
 }
 
 /*!
-  \fn void prepare_poly_gl (float * vertices, atom at, int c)
+  \fn void update_poly_hull (poly_hull * hull, atom * at)
 
-  \brief prepare the OpenGL rendering of a polyhedron
+  \brief compute the coordination polyhedron of an atom, unless the one cached is up to date
 
-  \param vertices the OpenGL data buffer to fill
-  \param at the atom origin of the polyhedron
-  \param c the coordination (0= total, 1= partial)
+  \param hull the cached polyhedron
+  \param at the atom, in the project being drawn
 */
-void prepare_poly_gl (float * vertices, atom at, int c)
+void update_poly_hull (poly_hull * hull, atom * at)
 {
-  int j, k, l;
+  int i, j, s;
   gboolean clones;
-  GLfloat ** xyz;
   distance d;
-  xyz = allocdfloat (at.numv+1, 3);
+  float * xyz;
+  vec3_t * p;
+  atom_pos ap = get_atom_pos (proj_gl, step, at -> id);
+
+  // +1 if only a coord 3 to include the central atom
+  s = (at -> numv == 3) ? 4 : at -> numv;
+  xyz = allocfloat (3*s);
   clones = FALSE;
-  for (l=0; l < at.numv; l++)
+  for (i=0; i<at -> numv; i++)
   {
-    j = at.vois[l];
-    d = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, & at, & proj_gl -> atoms[step][j]);
-    xyz[l][0] = at.x - d.x;
-    xyz[l][1] = at.y - d.y;
-    xyz[l][2] = at.z - d.z;
+    j = at -> vois[i];
+    d = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, ap, get_atom_pos (proj_gl, step, j));
+    xyz[3*i] = ap.x - d.x;
+    xyz[3*i+1] = ap.y - d.y;
+    xyz[3*i+2] = ap.z - d.z;
     if (d.pbc) clones = TRUE;
   }
-  j = at.numv;
-  if (j > 1)
+  if (at -> numv == 3)
+  {
+    xyz[9] = ap.x;
+    xyz[10] = ap.y;
+    xyz[11] = ap.z;
+  }
+  if (hull -> summits == s && memcmp (hull -> xyz, xyz, 3*s*sizeof*xyz) == 0)
+  {
+    g_free (xyz);
+    return;
+  }
+  if (hull -> xyz) g_free (hull -> xyz);
+  if (hull -> faces) g_free (hull -> faces);
+  hull -> summits = s;
+  hull -> clones = clones;
+  hull -> xyz = xyz;
+  hull -> faces = allocint (6*s);
+  p = g_malloc (s*sizeof*p);
+  for (i=0; i<s; i++) p[i] = vec3 (xyz[3*i], xyz[3*i+1], xyz[3*i+2]);
+  hull -> triangles = convex_hull (s, p, hull -> faces);
+  g_free (p);
+}
+
+/*!
+  \fn void prepare_poly_gl (float * vertices, atom at, int c, poly_hull * hull)
+
+  \brief prepare the OpenGL rendering of a polyhedron
+
+  \param vertices the OpenGL data buffer to fill
+  \param at the atom origin of the polyhedron
+  \param c the coordination (0= total, 1= partial)
+  \param hull the polyhedron, as computed by 'update_poly_hull'
+*/
+void prepare_poly_gl (float * vertices, atom at, int c, poly_hull * hull)
+{
+  int i, k, l;
+  GLfloat ** xyz;
+  float * summits;
+  if (hull -> triangles && (plot -> draw_clones || ! hull -> clones || plot -> cloned_poly))
   {
-    if (j == 3)
+    k = at.sp;
+    // Set color
+    if (pcolorm == 0)
     {
-      xyz[j][0] = at.x;
-      xyz[j][1] = at.y;
-      xyz[j][2] = at.z;
+      pcol = plot -> at_color[k];
+      l = at.coord[c];
+      pcol.alpha = plot -> spcolor[c][k][l].alpha;
     }
-    if (plot -> draw_clones || ! clones || plot -> cloned_poly)
+    else if (pcolorm < 5)
     {
-      k = at.sp;
-      // Set color
-      if (pcolorm == 0)
-      {
-        pcol = plot -> at_color[k];
-        l = at.coord[c];
-        pcol.alpha = plot -> spcolor[c][k][l].alpha;
-      }
-      else if (pcolorm < 5)
+      l = at.coord[pcolorm - 1];
+      if (pcolorm > 2)
       {
-        l = at.coord[pcolorm - 1];
-        if (pcolorm > 2)
-        {
-          k = 0;
-        }
-        pcol = plot -> spcolor[pcolorm - 1][k][l];
+        k = 0;
       }
-      else if (pcolorm == 5)
+      pcol = plot -> spcolor[pcolorm - 1][k][l];
+    }
+    else if (pcolorm == 5)
+    {
+      field_molecule * fmol = get_active_field_molecule_from_model_id (proj_gl, at.id);
+      if (fmol)
       {
-        field_molecule * fmol = get_active_field_molecule_from_model_id (proj_gl, at.id);
-        if (fmol)
-        {
-          l = proj_gl -> atoms[0][at.id].fid;
-          k = fmol -> mol -> natoms;
-        }
-        else
-        {
-          l = 0;
-          k = 1;
-        }
-        pcol = init_color (l, k);
-        pcol.alpha = 0.5;
+        l = proj_gl -> atoms[0][at.id].fid;
+        k = fmol -> mol -> natoms;
       }
       else
       {
-        pcol = wingl -> custom_map -> colors[step][at.id];
-        l = at.coord[1];
-        pcol.alpha = plot -> spcolor[1][k][l].alpha;
-      }
-      /*color[0] = pcol.red;
-      color[1] = pcol.green;
-      color[2] = pcol.blue;
-      color[3] = pcol.alpha;*/
-      switch (j)
-      {
-        case 3:
-          // Tetrahedral unit
-          // Tétraèdre, assemblage de triangles
-          get_centroid (xyz, 4);
-          setup_tetrahedron (vertices, xyz);
-          break;
-        default:
-          get_centroid (xyz, j);
-          check_triangles (j, xyz);
-          setup_polyhedron (vertices, xyz, j);
-          break;
+        l = 0;
+        k = 1;
       }
+      pcol = init_color (l, k);
+      pcol.alpha = 0.5;
     }
+    else
+    {
+      pcol = wingl -> custom_map -> colors[step][at.id];
+      l = at.coord[1];
+      pcol.alpha = plot -> spcolor[1][k][l].alpha;
+    }
+    summits = duplicate_float (3*hull -> summits, hull -> xyz);
+    xyz = g_malloc (hull -> summits*sizeof*xyz);
+    for (i=0; i<hull -> summits; i++) xyz[i] = summits + 3*i;
+    get_centroid (xyz, hull -> summits);
+    setup_polyhedron (vertices, xyz, hull -> triangles, hull -> faces);
+    g_free (xyz);
+    g_free (summits);
   }
-  g_free (xyz);
-  xyz = NULL;
-}
-
-/*!
-  \fn int is_atom_cloned (int at)
-
-  \brief does this atom have clone(s) ?
-
-  \param at the atom id to test
-*/
-int is_atom_cloned (int at)
-{
-  int i, j, k;
-  i=0;
-  for (j=0; j<proj_gl -> atoms[step][at].numv; j++)
-  {
-    k = proj_gl -> atoms[step][at].vois[j];
-    if (distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, & proj_gl -> atoms[step][at], & proj_gl -> atoms[step][k]).pbc) i ++;
-  }
-  return i;
 }
 
 /*!
   \fn void create_poly_lists ()
 
-  \brief prepare coordination polyhedra(s) OpenGL rendering
+  \brief prepare coordination polyhedra(s) OpenGL rendering:
+  \brief the polyhedra are computed in parallel, then cached for each MD step
 */
 void create_poly_lists ()
 {
@@ -634,7 +674,7 @@ void create_poly_lists ()
   // However a better way is to used the neighbor list, if 3 atoms are linked thru bonds
   // and that all 3 of them are involved in polyhedra then the one at
   // the center is to be drawn first ... yet to be implemented
-  int h, i, j, k, l, m, n, o, p, q;
+  int h, i, j, k, l, m;
 #ifdef DEBUG
   g_debug ("Poly LIST");
 #endif
@@ -657,39 +697,51 @@ void create_poly_lists ()
     }
     if (h)
     {
-      int * npoly[2];
+      // The coordination of each atom, and the atoms with a polyhedron to render
+      int * ptype[2];
+      gboolean * show = allocbool (proj_at);
+      for (i=0; i<2; i++)
+      {
+        ptype[i] = allocint (proj_at);
+        for (k=0; k < proj_at; k++)
+        {
+          l = 0;
+          for (m=0; m<proj_gl -> atoms[step][k].sp; m++)
+          {
+            l += coord_gl -> ntg[i][m];
+          }
+          ptype[i][k] = l + proj_gl -> atoms[step][k].coord[i];
+          if (plot -> show_poly[i] && plot -> show_poly[i][ptype[i][k]] && proj_gl -> atoms[step][k].numv > 1) show[k] = TRUE;
+        }
+      }
+      if (wingl -> poly_hull_atoms != proj_at || wingl -> poly_hull_steps != proj_gl -> steps)
+      {
+        free_poly_hulls (wingl);
+        wingl -> poly_hull_atoms = proj_at;
+        wingl -> poly_hull_steps = proj_gl -> steps;
+        wingl -> poly_hulls = g_malloc0 (proj_gl -> steps*sizeof*wingl -> poly_hulls);
+      }
+      if (! wingl -> poly_hulls[step]) wingl -> poly_hulls[step] = g_malloc0 (proj_at*sizeof*wingl -> poly_hulls[step]);
+      poly_hull * hulls = wingl -> poly_hulls[step];
+      // Each atom owns its polyhedron, only the ones not cached, or out of date, are computed
+#ifdef OPENMP
+      int numth = omp_get_max_threads ();
+      #pragma omp parallel for num_threads(numth) private(k) shared(hulls,show,proj_gl,step)
+#endif
+      for (k=0; k<proj_at; k++)
+      {
+        if (show[k]) update_poly_hull (& hulls[k], & proj_gl -> atoms[step][k]);
+      }
+
       int ptot = 0;
       for (i=0; i<2; i++)
       {
-        npoly[i] = allocint (coord_gl -> totcoord[i]);
-        for (j=0; j<coord_gl -> totcoord[i]; j++)
+        for (k=0; k<proj_at; k++)
         {
-          for (k=0; k < proj_at; k++)
+          if (show[k] && plot -> show_poly[i] && plot -> show_poly[i][ptype[i][k]])
           {
-            l = 0;
-            for (m=0; m<proj_gl -> atoms[step][k].sp; m++)
-            {
-              l += coord_gl -> ntg[i][m];
-            }
-            n = l + proj_gl -> atoms[step][k].coord[i];
-            if (n == j && plot -> show_poly[i] && plot -> show_poly[i][n])
-            {
-              m = proj_gl -> atoms[step][k].coord[1];
-              n = proj_gl -> atoms[step][k].sp;
-              o = 0;
-              for (p=0; p<proj_sp; p++)
-              {
-                 o += coord_gl -> partial_geo[n][m][p];
-              }
-              p = (plot -> draw_clones) ? 1 + is_atom_cloned (k) : 1;
-              // q is the number of summit of the polyhedra
-              // +1 if only a coord 3 to include the central atom
-              q = (o == 3) ? o+1: o;
-              // Then we need the max number of triangle for this polyedron
-              npoly[i][j] += p*(q*(q-1)*(q-2)/6);
-            }
+            if (plot -> draw_clones || ! hulls[k].clones || plot -> cloned_poly) ptot += 3*hulls[k].triangles;
           }
-          ptot += npoly[i][j]*3;
         }
       }
       if (ptot > 0)
@@ -705,28 +757,23 @@ void create_poly_lists ()
         {
           for (j=0; j<coord_gl -> totcoord[i]; j++)
           {
-            if (npoly[i][j] > 0)
+            if (plot -> show_poly[i] && plot -> show_poly[i][j])
             {
               for (m=0; m < proj_at; m++)
               {
-                n = 0;
-                for (o=0; o<proj_gl -> atoms[step][m].sp; o++)
-                {
-                  n += coord_gl -> ntg[i][o];
-                }
-                o = n + proj_gl -> atoms[step][m].coord[i];
-                if (o == j && plot -> show_poly[i] && plot -> show_poly[i][o] &&  proj_gl -> atoms[step][m].numv > 1)
+                if (show[m] && ptype[i][m] == j)
                 {
-                  prepare_poly_gl (poly -> vertices, proj_gl -> atoms[step][m], i);
+                  prepare_poly_gl (poly -> vertices, proj_gl -> atoms[step][m], i, & hulls[m]);
                 }
               }
             }
           }
-          g_free (npoly[i]);
         }
         wingl -> ogl_glsl[POLYS][step][0] = init_shader_program (POLYS, GLSL_POLYEDRA, full_vertex, NULL, full_color, GL_TRIANGLES, 3, 1, TRUE, poly);
         g_free (poly);
       }
+      for (i=0; i<2; i++) g_free (ptype[i]);
+      g_free (show);
     }
   }
   wingl -> create_shaders[POLYS] = FALSE;
@@ -43,9 +43,9 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 extern ColRGBA pcol;
 extern int nbs, nbl, nba;
 extern void setup_tetrahedron (float * vertices, GLfloat ** xyz);
-extern void setup_polyhedron (float * vertices, GLfloat ** xyz, int s);
+extern void setup_polyhedron (float * vertices, GLfloat ** xyz, int triangles, int * faces);
 extern void get_centroid (GLfloat ** xyz, int id);
-extern void check_triangles (int s, GLfloat ** xyz);
+extern int convex_hull (int s, vec3_t * p, int * faces);
 
 /*!
   \fn int prepare_rings_gl (float * vertices, int se, int ge, int ta, int id, gboolean go)
@@ -67,7 +67,7 @@ int prepare_rings_gl (float * vertices, int se, int ge, int ta, int id, gboolean
   gboolean old_pbc;
   GLfloat *** xyz;
   distance d;
-  atom at, bt;
+  atom_pos at, bt;
 
   xyz = alloctfloat (ta, ta, 3);
   j = -1;
@@ -75,17 +75,17 @@ int prepare_rings_gl (float * vertices, int se, int ge, int ta, int id, gboolean
   clones = FALSE;
   j = wingl -> all_rings[se][step][ta-1][id][0];
   l = 0;
-  xyz[0][l][0] = proj_gl -> atoms[step][j].x;
-  xyz[0][l][1] = proj_gl -> atoms[step][j].y;
-  xyz[0][l][2] = proj_gl -> atoms[step][j].z;
+  xyz[0][l][0] = proj_gl -> pos[step][0][j];
+  xyz[0][l][1] = proj_gl -> pos[step][1][j];
+  xyz[0][l][2] = proj_gl -> pos[step][2][j];
   for (i=1; i < ta; i++)
   {
     j = wingl -> all_rings[se][step][ta-1][id][i];
-    at = proj_gl -> atoms[step][j];
+    at = get_atom_pos (proj_gl, step, j);
     bt.x = xyz[0][i-1][0];
     bt.y = xyz[0][i-1][1];
     bt.z = xyz[0][i-1][2];
-    d = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, & at, & bt);
+    d = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, at, bt);
     if (d.pbc) clones = TRUE;
     xyz[0][i][0] = xyz[0][i-1][0] + d.x;
     xyz[0][i][1] = xyz[0][i-1][1] + d.y;
@@ -103,14 +103,14 @@ int prepare_rings_gl (float * vertices, int se, int ge, int ta, int id, gboolean
       for (i=0; i<ta; i++)
       {
         j = wingl -> all_rings[se][step][ta-1][id][i];
-        at = proj_gl -> atoms[step][j];
+        at = get_atom_pos (proj_gl, step, j);
         add_poly = TRUE;
         for (k=0; k<m+1; k++)
         {
           bt.x = xyz[k][i][0];
           bt.y = xyz[k][i][1];
           bt.z = xyz[k][i][2];
-          d = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, & at, & bt);
+          d = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, at, bt);
           if (d.length < 0.01)
           {
             add_poly = FALSE;
@@ -125,7 +125,7 @@ int prepare_rings_gl (float * vertices, int se, int ge, int ta, int id, gboolean
         bt.x = xyz[0][i][0];
         bt.y = xyz[0][i][1];
         bt.z = xyz[0][i][2];
-        d = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, & at, & bt);
+        d = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, at, bt);
         for (j=0; j<ta; j++)
         {
           xyz[m][j][0] = xyz[0][j][0] + d.x;
@@ -151,8 +151,12 @@ int prepare_rings_gl (float * vertices, int se, int ge, int ta, int id, gboolean
       }
       else
       {
-        check_triangles (l, xyz[i]);
-        setup_polyhedron (vertices, xyz[i], l);
+        vec3_t * summits = g_malloc (l*sizeof*summits);
+        int * faces = allocint (6*l);
+        for (j=0; j<l; j++) summits[j] = vec3 (xyz[i][j][0], xyz[i][j][1], xyz[i][j][2]);
+        setup_polyhedron (vertices, xyz[i], convex_hull (l, summits, faces), faces);
+        g_free (faces);
+        g_free (summits);
       }
     }
   }
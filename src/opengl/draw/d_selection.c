@@ -65,9 +65,9 @@ extern void setup_sphere_vertice (float * vertices, vec3_t pos, ColRGBA col, flo
 extern void setup_cylinder_vertice (float * vertices, vec3_t pos_a, vec3_t pos_b, ColRGBA col, float rad, float alpha);
 extern void setup_triangles (float * vertices, vec3_t sa, vec3_t sb, vec3_t sc);
 extern float get_bond_radius (int sty, int ac, int at, int b, int sel);
-extern void setup_this_atom (int style, gboolean to_pick, int picked, atom * at, int ac, float * vert, float al);
-extern void prepare_clone (int style, gboolean to_pick, int picked, atom at, atom bt, float x, float y, float z, float * vertices);
-extern void setup_this_bond (int sty, gboolean to_pick, gboolean picked, int cap, int bi, int pi, atom * at, atom * bt, float al, float * vertices);
+extern void setup_this_atom (int style, gboolean to_pick, int picked, gl_atom * at, int ac, float * vert, float al);
+extern void prepare_clone (int style, gboolean to_pick, int picked, atom * at, atom * bt, float x, float y, float z, float * vertices);
+extern void setup_this_bond (int sty, gboolean to_pick, gboolean picked, int cap, int bi, int pi, gl_atom * at, gl_atom * bt, float al, float * vertices);
 
 /*!
   \fn void setup_selected_clone_vertices (int style, int at, int pi, float * vertices)
@@ -87,7 +87,7 @@ void setup_selected_clone_vertices (int style, int at, int pi, float * vertices)
   for (i=0; i < proj_gl -> atoms[step][at].numv; i++)
   {
     j = proj_gl -> atoms[step][at].vois[i];
-    d = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, & proj_gl -> atoms[step][at], & proj_gl -> atoms[step][j]);
+    d = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, get_atom_pos (proj_gl, step, at), get_atom_pos (proj_gl, step, j));
     if (d.pbc)
     {
       if (in_movie_encoding && plot -> at_data != NULL)
@@ -101,8 +101,8 @@ void setup_selected_clone_vertices (int style, int at, int pi, float * vertices)
       if (doit)
       {
         prepare_clone (style, FALSE, pi+1,
-                       proj_gl -> atoms[step][at],
-                       proj_gl -> atoms[step][j],
+                       & proj_gl -> atoms[step][at],
+                       & proj_gl -> atoms[step][j],
                        d.x,
                        d.y,
                        d.z, vertices);
@@ -138,7 +138,7 @@ int find_selected_clone_vertices (int style, int at)
     for (i=0; i < proj_gl -> atoms[step][at].numv; i++)
     {
       j = proj_gl -> atoms[step][at].vois[i];
-      d = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, & proj_gl -> atoms[step][at], & proj_gl -> atoms[step][j]);
+      d = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, get_atom_pos (proj_gl, step, at), get_atom_pos (proj_gl, step, j));
       if (d.pbc)  k ++;
     }
   }
@@ -196,7 +196,7 @@ int find_selected_bond_vertices (int sty, int at, int sp, int bi, int pi, int ca
       }
       if (sp == -1 || k == sp)
       {
-        dist = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, & proj_gl -> atoms[step][at], & proj_gl -> atoms[step][j]);
+        dist = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, get_atom_pos (proj_gl, step, at), get_atom_pos (proj_gl, step, j));
         if ((bi && dist.pbc) ||(! bi && ! dist.pbc))
         {
           if (cap)
@@ -249,41 +249,39 @@ int get_clone_id (int at, int bt)
 */
 void prepare_selected_bond (int sty, int cap, int bi, int pi, atom * at, atom * bt, float * vertices)
 {
+  gl_atom va, vb;
   if (bi == 0)
   {
-    setup_this_bond (sty, FALSE, TRUE, cap, bi, pi, at, bt, 1.0, vertices);
+    gl_atom_view (& va, at);
+    gl_atom_view (& vb, bt);
+    setup_this_bond (sty, FALSE, TRUE, cap, bi, pi, & va, & vb, 1.0, vertices);
   }
   else
   {
-    atom * tmp_a, * tmp_b;
-    distance d = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, at, bt);
-
-    tmp_a = duplicate_atom (at);
-    tmp_b = duplicate_atom (at);
-    tmp_a -> pick[pi] = bt -> pick[pi];
-    tmp_a -> style = bt -> style;
-    tmp_a -> sp = bt -> sp + proj_sp;
-    tmp_b -> sp += proj_sp;
-    tmp_a -> x -= d.x;
-    tmp_a -> y -= d.y;
-    tmp_a -> z -= d.z;
-    setup_this_bond (sty, FALSE, TRUE, cap, bi, pi, tmp_b, tmp_a, 0.5, vertices);
-    g_free (tmp_a);
-    g_free (tmp_b);
-
-    tmp_a = duplicate_atom (bt);
-    tmp_b = duplicate_atom (bt);
-    tmp_a -> pick[pi] = at -> pick[pi];
-    tmp_a -> style = at -> style;
-    tmp_a -> sp = at -> sp + proj_sp;
-    tmp_b -> sp += proj_sp;
-    tmp_a -> id = at -> id;
-    tmp_a -> x += d.x;
-    tmp_a -> y += d.y;
-    tmp_a -> z += d.z;
-    setup_this_bond (sty, FALSE, TRUE, cap, bi, pi, tmp_a, tmp_b, 0.5, vertices);
-    g_free (tmp_a);
-    g_free (tmp_b);
+    distance d = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, get_atom_pos (proj_gl, step, at -> id), get_atom_pos (proj_gl, step, bt -> id));
+
+    gl_atom_view (& va, at);
+    gl_atom_view (& vb, at);
+    va.pick[pi] = bt -> pick[pi];
+    va.style = bt -> style;
+    va.sp = bt -> sp + proj_sp;
+    vb.sp += proj_sp;
+    va.x -= d.x;
+    va.y -= d.y;
+    va.z -= d.z;
+    setup_this_bond (sty, FALSE, TRUE, cap, bi, pi, & vb, & va, 0.5, vertices);
+
+    gl_atom_view (& va, bt);
+    gl_atom_view (& vb, bt);
+    va.pick[pi] = at -> pick[pi];
+    va.style = at -> style;
+    va.sp = at -> sp + proj_sp;
+    vb.sp += proj_sp;
+    va.id = at -> id;
+    va.x += d.x;
+    va.y += d.y;
+    va.z += d.z;
+    setup_this_bond (sty, FALSE, TRUE, cap, bi, pi, & va, & vb, 0.5, vertices);
   }
 }
 
@@ -338,7 +336,7 @@ void setup_all_selected_bond_vertices (int sty, int cap, int bi, int at, int sb,
       }
       if (sb == -1 || k == sb)
       {
-        dist = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, & proj_gl -> atoms[step][at], & proj_gl -> atoms[step][j]);
+        dist = distance_3d (cell_gl, (cell_gl -> npt) ? step : 0, get_atom_pos (proj_gl, step, at), get_atom_pos (proj_gl, step, j));
         if ((bi && dist.pbc) ||(! bi && ! dist.pbc))
         {
           if (cap)
@@ -690,6 +688,7 @@ int prepare_selection_shaders (int style, int shaders, int clone, int type, gboo
   int nshaders = 0;
   atom_in_selection * sel;
   gboolean doit;
+  gl_atom va;
   gboolean sphere = TRUE;
   gboolean cylinder = FALSE;
   object_3d * atos;
@@ -747,7 +746,8 @@ int prepare_selection_shaders (int style, int shaders, int clone, int type, gboo
       }
       if (doit)
       {
-        setup_this_atom (style-1, FALSE, type+1, & proj_gl -> atoms[step][sel -> id], 0, atos -> instances, 0.75);
+        gl_atom_view (& va, & proj_gl -> atoms[step][sel -> id]);
+        setup_this_atom (style-1, FALSE, type+1, & va, 0, atos -> instances, 0.75);
       }
       if (sel -> next != NULL) sel = sel -> next;
     }
@@ -780,7 +780,8 @@ int prepare_selection_shaders (int style, int shaders, int clone, int type, gboo
       }
       if (doit)
       {
-        setup_this_atom (style-1, FALSE, type+1, & proj_gl -> atoms[step][j], 0, atos -> instances, 0.75);
+        gl_atom_view (& va, & proj_gl -> atoms[step][j]);
+        setup_this_atom (style-1, FALSE, type+1, & va, 0, atos -> instances, 0.75);
       }
     }
     if (plot -> draw_clones)
@@ -975,34 +976,35 @@ int create_pick_lists ()
   int nshaders = 1;
   gboolean bonds = FALSE;
 
-  i = proj_at;
-  if (plot -> draw_clones) i += 2 * wingl -> bonds[step][1];
+  // Pick id ranges, the pick id is computed from the object id, and decoded the same way
+  wingl -> atoms_to_be_picked = proj_at;
+  wingl -> clones_to_be_picked = wingl -> atoms_to_be_picked;
+  if (plot -> draw_clones) wingl -> clones_to_be_picked += 2 * wingl -> bonds[step][1];
+  wingl -> bonds_to_be_picked = wingl -> to_be_picked = wingl -> clones_to_be_picked;
   j = wingl -> bonds[step][0] + wingl -> bonds[step][1];
   if (plot -> style != SPHERES && plot -> style != PUNT && j > 0)
   {
-    bonds = TRUE;
-    nshaders ++;
-    i += 2 * wingl -> bonds[step][0];
-    if (plot -> draw_clones) i += 4 * wingl -> bonds[step][1];
+    wingl -> bonds_to_be_picked += 2 * wingl -> bonds[step][0];
+    wingl -> to_be_picked = wingl -> bonds_to_be_picked;
+    if (plot -> draw_clones) wingl -> to_be_picked += 4 * wingl -> bonds[step][1];
+    // Bonds are only pickable if all pick ids can be encoded in the RGB color
+    if (wingl -> to_be_picked <= PICK_MAX)
+    {
+      bonds = TRUE;
+      nshaders ++;
+    }
+    else
+    {
+      wingl -> bonds_to_be_picked = wingl -> to_be_picked = wingl -> clones_to_be_picked;
+    }
   }
   int tmp_style = plot -> style;
   plot -> style = BALL_AND_STICK;
 
-  if (wingl -> color_to_pick != NULL)
-  {
-    g_free (wingl -> color_to_pick);
-    wingl -> color_to_pick = NULL;
-  }
-  wingl -> to_be_picked = 0;
-  wingl -> color_to_pick = allocint(i);
-
   wingl -> n_shaders[PICKS][0] = nshaders;
   wingl -> ogl_glsl[PICKS][0] = g_malloc0 (nshaders*sizeof*wingl -> ogl_glsl[PICKS][0]);
 
-  gColorID[0] = gColorID[1] = gColorID[2] = 0;
   create_atom_lists (TRUE);
-
-  wingl -> bonds_to_be_picked = 0;
   if (bonds) create_bond_lists (TRUE);
 
   plot -> style = tmp_style;
@@ -40,15 +40,23 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
   void close_frame_buffer ();
   void save_movie (glwin * view, video_options * vopts);
 
-  static void ffmpeg_encoder_set_frame_yuv_from_rgb (uint8_t * rgb, VideoStream * vs);
-  static void write_video_frame (AVFormatContext * f_context, VideoStream * vs, int frame_id, glwin * view);
+  static void ffmpeg_encoder_set_frame_yuv_from_rgb (uint8_t * rgb, VideoStream * vs, gboolean flip);
+  static void encode_video_frame (AVFormatContext * f_context, VideoStream * vs, int frame_id);
   static void close_stream (AVFormatContext * fc, VideoStream * vs);
+  static void read_movie_slot (movie_pipeline * mp, movie_slot * slot);
+  static void release_movie_slot (movie_pipeline * mp, movie_slot * slot);
+  static void render_movie_frame (movie_pipeline * mp, int frame_id, glwin * view);
+  static void close_movie_pipeline (movie_pipeline * mp);
 
   G_MODULE_EXPORT void run_save_movie (GtkNativeDialog * info, gint response_id, gpointer data);
   G_MODULE_EXPORT void run_save_movie (GtkDialog * info, gint response_id, gpointer data);
 
   static GLubyte * capture_opengl_image (unsigned int width, unsigned int height);
 
+  static gpointer movie_encoder (gpointer data);
+
+  static movie_pipeline * init_movie_pipeline (AVFormatContext * fc, VideoStream * vs);
+
   AVCodecContext * add_codec_context (AVFormatContext * fc, const AVCodec * vc, video_options * vopts);
   static AVFrame * alloc_video_frame (AVCodecContext * cc);
 
@@ -219,20 +227,27 @@ void convert_rgb_pixbuf_to_yuv (GdkPixbuf * pixbuf, AVFrame * picture, int w, in
 }
 
 /*!
-  \fn static void ffmpeg_encoder_set_frame_yuv_from_rgb (uint8_t * rgb, VideoStream * vs)
+  \fn static void ffmpeg_encoder_set_frame_yuv_from_rgb (uint8_t * rgb, VideoStream * vs, gboolean flip)
 
   \brief set an encoder YUV frame from an RGB image
 
   \param rgb the RGB data to convert
   \param vs the video stream to encode the data
+  \param flip the RGB data is bottom-up, as read from OpenGL (1), or top-down (0)
 */
-static void ffmpeg_encoder_set_frame_yuv_from_rgb (uint8_t * rgb, VideoStream * vs)
+static void ffmpeg_encoder_set_frame_yuv_from_rgb (uint8_t * rgb, VideoStream * vs, gboolean flip)
 {
-  const int in_linesize = 4 * vs -> cc -> width;
+  int in_linesize = 4 * vs -> cc -> width;
   vs -> sws_ctx = sws_getCachedContext (vs -> sws_ctx,
                                         vs -> cc -> width, vs -> cc -> height, AV_PIX_FMT_BGRA,
                                         vs -> cc -> width, vs -> cc -> height, PIXEL_FORMAT,
                                         0, NULL, NULL, NULL);
+  if (flip)
+  {
+    // Start from the last row, with a negative stride: the image is flipped without copy
+    rgb += (size_t)in_linesize * (vs -> cc -> height - 1);
+    in_linesize = - in_linesize;
+  }
   sws_scale (vs -> sws_ctx, (const uint8_t * const *)&rgb,
              & in_linesize, 0, vs -> cc -> height,
              vs -> frame -> data, vs -> frame -> linesize);
@@ -246,16 +261,19 @@ static void ffmpeg_encoder_set_frame_yuv_from_rgb (uint8_t * rgb, VideoStream *
 static GLubyte * capture_opengl_image (unsigned int width, unsigned int height)
 {
   size_t i, nvals;
+  size_t row = 4 * width;
   nvals = width * height * 4;
-  GLubyte * pixels = g_malloc (nvals * sizeof(GLubyte));
   GLubyte * rgb = g_malloc (nvals * sizeof(GLubyte));
-  glReadPixels (0, 0, width, height, GL_BGRA, GL_UNSIGNED_BYTE, pixels);
-  // Flip data veritcally
-  for (i = 0; i < height; i++)
+  GLubyte * tmp = g_malloc (row * sizeof(GLubyte));
+  glReadPixels (0, 0, width, height, GL_BGRA, GL_UNSIGNED_BYTE, rgb);
+  // Flip data vertically, in place
+  for (i = 0; i < height/2; i++)
   {
-    memcpy (rgb + 4 * width * i, pixels  + 4 * width * (height - i - 1), 4 * width);
+    memcpy (tmp, rgb + row * i, row);
+    memcpy (rgb + row * i, rgb + row * (height - i - 1), row);
+    memcpy (rgb + row * (height - i - 1), tmp, row);
   }
-  g_free (pixels);
+  g_free (tmp);
   return rgb;
 }
 //#endif
@@ -280,7 +298,7 @@ void fill_image (VideoStream * vs, int width, int height, glwin * view)
   if (vs != NULL)
   {
     //if (movie) convert_rgb_pixbuf_to_yuv (pixbuf, frame, width, height);
-    ffmpeg_encoder_set_frame_yuv_from_rgb (image, vs);
+    ffmpeg_encoder_set_frame_yuv_from_rgb (image, vs, FALSE);
   }
   else
   {
@@ -293,70 +311,226 @@ void fill_image (VideoStream * vs, int width, int height, glwin * view)
 }
 
 /*!
-  \fn static void write_video_frame (AVFormatContext * f_context, VideoStream * vs, int frame_id, glwin * view)
+  \fn static void encode_video_frame (AVFormatContext * f_context, VideoStream * vs, int frame_id)
 
-  \brief write a video frame from an OpenGL render
+  \brief encode the frame of a video stream, and write the packet(s) available
 
   \param f_context the format context to use
   \param vs the video stream
-  \param frame_id the frame id number
-  \param view the target glwin
+  \param frame_id the frame id number, -1 to flush the encoder
 */
-static void write_video_frame (AVFormatContext * f_context, VideoStream * vs, int frame_id, glwin * view)
+static void encode_video_frame (AVFormatContext * f_context, VideoStream * vs, int frame_id)
 {
-  int out_size = 0;
-
-  fill_image (vs, vs -> cc -> width, vs -> cc -> height, view);
+  int error;
+  AVPacket * packet;
 
-  AVPacket packet;
-#if LIBAVCODEC_VERSION_MAJOR > 57
-  out_size = av_new_packet (& packet, 0);
-  if (out_size != 0)
+  if (frame_id > -1) vs -> frame -> pts = frame_id + 1;
+  error = avcodec_send_frame (vs -> cc, (frame_id > -1) ? vs -> frame : NULL);
+  if (error < 0)
   {
     // "Error while encoding video frame"
-    g_warning ("MOVIE_ENCODING:: VIDEO_FRAME:: error:: %s", av_err2str(out_size));
+    g_warning ("MOVIE_ENCODING:: VIDEO_FRAME:: error:: %s", av_err2str (error));
+    return;
   }
-  // get_packet_defaults (& packet);
-#else
-  av_init_packet (& packet);
-#endif
-
-  if (! out_size)
+  packet = av_packet_alloc ();
+  if (packet == NULL)
   {
-    packet.dts = packet.pts = AV_NOPTS_VALUE;
-    packet.data = NULL;
-    packet.size = 0;
-
-    vs -> frame -> pts = frame_id + 1;
-    out_size = avcodec_send_frame (vs -> cc, vs -> frame);
-    if (out_size < 0)
+    g_warning ("MOVIE_ENCODING:: VIDEO_FRAME:: error:: could not allocate packet");
+    return;
+  }
+  // With B-frames and frame threading the encoder can return 0 or several packets
+  while ((error = avcodec_receive_packet (vs -> cc, packet)) == 0)
+  {
+    av_packet_rescale_ts (packet, vs -> cc -> time_base, vs -> st -> time_base);
+    packet -> stream_index = vs -> st -> index;
+    error = av_interleaved_write_frame (f_context, packet);
+    if (error != 0)
     {
       // "Error while encoding video frame"
-      g_warning ("MOVIE_ENCODING:: VIDEO_FRAME:: error:: %s", av_err2str (out_size));
+      g_warning ("MOVIE_ENCODING:: VIDEO_FRAME:: error:: %s", av_err2str(error));
     }
-    else
+    av_packet_unref (packet);
+  }
+  if (error != AVERROR(EAGAIN) && error != AVERROR_EOF)
+  {
+    g_warning ("MOVIE_ENCODING:: VIDEO_FRAME:: error:: %s", av_err2str(error));
+  }
+  av_packet_free (& packet);
+}
+
+/*!
+  \fn static gpointer movie_encoder (gpointer data)
+
+  \brief movie encoder thread: convert to YUV and encode the frames read back, in order
+
+  \param data the associated data pointer, the movie pipeline
+*/
+static gpointer movie_encoder (gpointer data)
+{
+  movie_pipeline * mp = (movie_pipeline *)data;
+  movie_slot * slot;
+
+  while ((slot = g_async_queue_pop (mp -> to_encode)) != & mp -> stop)
+  {
+    if (slot -> pixels != NULL)
     {
-      if (avcodec_receive_packet (vs -> cc, & packet) < 0)
+      // The encoder might still reference the previous frame
+      if (av_frame_make_writable (mp -> vs -> frame) < 0)
       {
-        // "Error while encoding video frame"
-         if (frame_id + 1 > frame_start) g_warning ("MOVIE_ENCODING:: VIDEO_FRAME:: warning:: packet empty, ignoring frame= %d", frame_id);
+        g_warning ("MOVIE_ENCODING:: VIDEO_FRAME:: error:: frame not writable, ignoring frame= %d", slot -> frame_id);
       }
       else
       {
-        av_packet_rescale_ts (& packet, vs -> cc -> time_base, vs -> st -> time_base);
-
-        packet.stream_index = vs -> st -> index;
-        packet.flags |= AV_PKT_FLAG_KEY;
-        out_size = av_interleaved_write_frame (f_context, & packet);
-        if (out_size != 0)
-        {
-          // "Error while encoding video frame"
-          g_warning ("MOVIE_ENCODING:: VIDEO_FRAME:: error:: %s", av_err2str(out_size));
-        }
-        av_packet_unref(& packet);
+        ffmpeg_encoder_set_frame_yuv_from_rgb (slot -> pixels, mp -> vs, TRUE);
+        encode_video_frame (mp -> fc, mp -> vs, slot -> frame_id);
       }
     }
+    g_async_queue_push (mp -> encoded, slot);
+  }
+  // Delayed packets
+  encode_video_frame (mp -> fc, mp -> vs, -1);
+  return NULL;
+}
+
+/*!
+  \fn static movie_pipeline * init_movie_pipeline (AVFormatContext * fc, VideoStream * vs)
+
+  \brief create the movie pipeline: pixel buffer objects ring and encoder thread
+
+  \param fc the format context
+  \param vs the video stream
+*/
+static movie_pipeline * init_movie_pipeline (AVFormatContext * fc, VideoStream * vs)
+{
+  int i;
+  movie_pipeline * mp = g_malloc0 (sizeof*mp);
+  mp -> fc = fc;
+  mp -> vs = vs;
+  mp -> width = vs -> cc -> width;
+  mp -> height = vs -> cc -> height;
+  mp -> stop.frame_id = -1;
+  for (i=0; i<MOVIE_PBOS; i++)
+  {
+    glGenBuffers (1, & mp -> slot[i].pbo);
+    glBindBuffer (GL_PIXEL_PACK_BUFFER, mp -> slot[i].pbo);
+    glBufferData (GL_PIXEL_PACK_BUFFER, 4 * mp -> width * mp -> height, NULL, GL_STREAM_READ);
+  }
+  glBindBuffer (GL_PIXEL_PACK_BUFFER, 0);
+  mp -> to_encode = g_async_queue_new ();
+  mp -> encoded = g_async_queue_new ();
+  mp -> encoder = g_thread_new ("movie_encoder", movie_encoder, mp);
+  return mp;
+}
+
+/*!
+  \fn static void read_movie_slot (movie_pipeline * mp, movie_slot * slot)
+
+  \brief wait for the read back of a frame, map its pixel buffer, and send it to the encoder
+
+  \param mp the movie pipeline
+  \param slot the slot to read
+*/
+static void read_movie_slot (movie_pipeline * mp, movie_slot * slot)
+{
+  GLenum res;
+  do
+  {
+    res = glClientWaitSync (slot -> fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+  } while (res == GL_TIMEOUT_EXPIRED);
+  glDeleteSync (slot -> fence);
+  glBindBuffer (GL_PIXEL_PACK_BUFFER, slot -> pbo);
+  slot -> pixels = glMapBufferRange (GL_PIXEL_PACK_BUFFER, 0, 4 * mp -> width * mp -> height, GL_MAP_READ_BIT);
+  glBindBuffer (GL_PIXEL_PACK_BUFFER, 0);
+  if (slot -> pixels == NULL) g_warning ("MOVIE_ENCODING:: VIDEO_FRAME:: error:: read back failed, ignoring frame= %d", slot -> frame_id);
+  slot -> pending = FALSE;
+  slot -> encoding = TRUE;
+  g_async_queue_push (mp -> to_encode, slot);
+}
+
+/*!
+  \fn static void release_movie_slot (movie_pipeline * mp, movie_slot * slot)
+
+  \brief wait for the encoder to be done with a slot, then unmap its pixel buffer
+
+  \param mp the movie pipeline
+  \param slot the slot to release
+*/
+static void release_movie_slot (movie_pipeline * mp, movie_slot * slot)
+{
+  movie_slot * done;
+  // Slots are encoded in order
+  do
+  {
+    done = g_async_queue_pop (mp -> encoded);
+    if (done -> pixels != NULL)
+    {
+      glBindBuffer (GL_PIXEL_PACK_BUFFER, done -> pbo);
+      glUnmapBuffer (GL_PIXEL_PACK_BUFFER);
+      done -> pixels = NULL;
+    }
+    done -> encoding = FALSE;
+  } while (done != slot);
+  glBindBuffer (GL_PIXEL_PACK_BUFFER, 0);
+}
+
+/*!
+  \fn static void render_movie_frame (movie_pipeline * mp, int frame_id, glwin * view)
+
+  \brief render a video frame, and start its asynchronous read back:
+  \brief frame N is rendered while frames N-1, N-2 are read back and frame N-2 is encoded
+
+  \param mp the movie pipeline
+  \param frame_id the frame id number
+  \param view the target glwin
+*/
+static void render_movie_frame (movie_pipeline * mp, int frame_id, glwin * view)
+{
+  movie_slot * slot = & mp -> slot[mp -> next];
+
+  if (slot -> encoding) release_movie_slot (mp, slot);
+  // opengl call is here !!!
+  reshape (view, mp -> width, mp -> height, FALSE);
+  draw (view);
+  glBindBuffer (GL_PIXEL_PACK_BUFFER, slot -> pbo);
+  glReadPixels (0, 0, mp -> width, mp -> height, GL_BGRA, GL_UNSIGNED_BYTE, 0);
+  glBindBuffer (GL_PIXEL_PACK_BUFFER, 0);
+  slot -> fence = glFenceSync (GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  slot -> frame_id = frame_id;
+  slot -> pending = TRUE;
+  mp -> next = (mp -> next + 1) % MOVIE_PBOS;
+
+  // Read back started MOVIE_PBOS-2 frames ago
+  slot = & mp -> slot[(mp -> next + 1) % MOVIE_PBOS];
+  if (slot -> pending) read_movie_slot (mp, slot);
+}
+
+/*!
+  \fn static void close_movie_pipeline (movie_pipeline * mp)
+
+  \brief encode the frames still in the pipeline, stop the encoder and free the pipeline
+
+  \param mp the movie pipeline
+*/
+static void close_movie_pipeline (movie_pipeline * mp)
+{
+  int i, j;
+  // Remaining frames, oldest first
+  for (i=0; i<MOVIE_PBOS; i++)
+  {
+    j = (mp -> next + i) % MOVIE_PBOS;
+    if (mp -> slot[j].pending) read_movie_slot (mp, & mp -> slot[j]);
+  }
+  g_async_queue_push (mp -> to_encode, & mp -> stop);
+  g_thread_join (mp -> encoder);
+  for (i=0; i<MOVIE_PBOS; i++)
+  {
+    j = (mp -> next + i) % MOVIE_PBOS;
+    if (mp -> slot[j].encoding) release_movie_slot (mp, & mp -> slot[j]);
   }
+  for (i=0; i<MOVIE_PBOS; i++) glDeleteBuffers (1, & mp -> slot[i].pbo);
+  g_async_queue_unref (mp -> to_encode);
+  g_async_queue_unref (mp -> encoded);
+  g_free (mp);
 }
 
 /*!
@@ -425,6 +599,8 @@ AVCodecContext * add_codec_context (AVFormatContext * fc, const AVCodec * vc, vi
 
   cc -> gop_size = vopts -> extraframes; /* emit one intra frame every n frames */
   cc -> pix_fmt = PIXEL_FORMAT;
+  // Let the codec use its own threads, if supported
+  cc -> thread_count = 0;
 
   if (vopts -> codec == 2) av_opt_set (cc -> priv_data, "preset", "slow", 0);
   /*
@@ -1006,6 +1182,7 @@ gboolean create_movie (glwin * view, video_options * vopts, gchar * videofile)
   AVFormatContext * format_context = NULL;
   VideoStream * video_stream = NULL;
   const AVCodec * video_codec = NULL;
+  movie_pipeline * pipeline;
 
   int error;
 
@@ -1089,18 +1266,19 @@ gboolean create_movie (glwin * view, video_options * vopts, gchar * videofile)
   }
 
   int frame_id;
+  pipeline = init_movie_pipeline (format_context, video_stream);
   frame_start = 0;
   if (vopts -> codec == 0)
   {
     frame_start = 1;
-    write_video_frame (format_context, video_stream, 0, view);
+    render_movie_frame (pipeline, 0, view);
   }
   else if (vopts -> codec == 2)
   {
     frame_start = 24;
     for (frame_id = 0; frame_id < frame_start; frame_id ++)
     {
-      write_video_frame (format_context, video_stream, frame_id, view);
+      render_movie_frame (pipeline, frame_id, view);
     }
   }
   re_create_all_md_shaders (view);
@@ -1121,13 +1299,16 @@ gboolean create_movie (glwin * view, video_options * vopts, gchar * videofile)
     {
       view -> anim -> last -> img -> quality = vopts -> oglquality;
     }
-    write_video_frame (format_context, video_stream, frame_id, view);
+    render_movie_frame (pipeline, frame_id, view);
     if (frame_id-frame_start > 0 && frame_id-frame_start - 10*((frame_id-frame_start)/10) == 0)
     {
       fraction = (double)(frame_id-frame_start+1)/num_frames;
-      gtk_progress_bar_set_fraction (GTK_PROGRESS_BAR(encoding_pb), fraction);
+      if (encoding_pb) gtk_progress_bar_set_fraction (GTK_PROGRESS_BAR(encoding_pb), fraction);
 #ifdef GTK3
-      while (gtk_events_pending()) gtk_main_iteration();
+      if (! atomes_batch)
+      {
+        while (gtk_events_pending()) gtk_main_iteration();
+      }
 #else
       // while (g_main_context_pending (context)) g_main_context_iteration (context, TRUE);
 #endif
@@ -1141,6 +1322,7 @@ gboolean create_movie (glwin * view, video_options * vopts, gchar * videofile)
       view -> anim -> last = view -> anim -> last -> next;
     }
   }
+  close_movie_pipeline (pipeline);
   if (vopts -> oglquality != 0)
   {
     view -> anim -> last -> img -> quality = q;
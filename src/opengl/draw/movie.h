@@ -57,6 +57,39 @@ struct VideoStream
     struct SwsContext * sws_ctx;
 };
 
+/*! \def MOVIE_PBOS
+  \brief Number of pixel buffer objects in the movie read back ring
+*/
+#define MOVIE_PBOS 4
+
+// a frame read back from the GPU, then converted and encoded
+typedef struct movie_slot movie_slot;
+struct movie_slot
+{
+  GLuint pbo;          // pixel buffer object
+  GLsync fence;        // signaled when the read back is complete
+  GLubyte * pixels;    // mapped pixel buffer, BGRA, bottom-up
+  int frame_id;        // frame id, -1 to stop the encoder
+  gboolean pending;    // read back requested, not yet sent to the encoder
+  gboolean encoding;   // sent to the encoder, still mapped
+};
+
+// render / read back on the OpenGL thread, convert and encode on a worker thread
+typedef struct movie_pipeline movie_pipeline;
+struct movie_pipeline
+{
+  AVFormatContext * fc;
+  VideoStream * vs;
+  int width;
+  int height;
+  int next;                        // slot to use for the next frame
+  movie_slot slot[MOVIE_PBOS];
+  movie_slot stop;                 // end of stream marker
+  GAsyncQueue * to_encode;         // slots to encode, in frame order
+  GAsyncQueue * encoded;           // slots encoded, that can be unmapped and reused
+  GThread * encoder;
+};
+
 typedef struct video_options video_options;
 struct video_options
 {
@@ -30,22 +30,27 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 *
 * List of functions:
 
-  int * paint_bitmap (vec4_t color, GLfloat a, int cw, int ch, unsigned char * buff);
+  int string_shaders (int id);
 
-  void render_string (int glsl, int id, screen_string * this_string);
+  void resize_glyph_atlas (glyph_atlas * atlas, int width, int height);
+  void upload_glyph_atlas (glyph_atlas * atlas);
+  void free_glyph_atlas (glyph_atlas * atlas);
   void debug_string (screen_string  * this_string);
   void render_all_strings (int glsl, int id);
-  void add_string (char * text, int id, ColRGBA col, vec3_t pos, float lshift[3], atom * at, atom * bt, atom * ct);
-  void prepare_string (char * text, int id, ColRGBA col, vec3_t pos, float lshift[3], atom * at, atom * bt, atom * ct);
+  void add_string_instance (screen_string * string, vec3_t pos, atom_pos * at, atom_pos * bt, atom_pos * ct);
+  void add_string (char * text, int id, ColRGBA col, vec3_t pos, float lshift[3], atom_pos * at, atom_pos * bt, atom_pos * ct);
+  void prepare_string (char * text, int id, ColRGBA col, vec3_t pos, float lshift[3], atom_pos * at, atom_pos * bt, atom_pos * ct);
 
-  static void normalize_text_size (GLenum texture,  int * width, int * height);
+  static void outline_glyph (int cwidth, int cheight, GLubyte * pixels, GLubyte * outline);
 
-  screen_string * was_not_rendered_already (char * word, screen_string * list);
+  const GLchar * glyph_vertex (int type);
+  const GLchar * glyph_color ();
 
   ColRGBA * opposite_color (ColRGBA col);
 
-  object_3d * create_string_texture (int cwidth, int cheight, int * pixels);
-  object_3d * gl_pango_render_layout (PangoLayout * layout, GLenum texture, int id, screen_string * this_string);
+  glyph * add_glyph (glyph_atlas * atlas, PangoLayout * layout, gunichar c);
+
+  glyph_atlas * get_glyph_atlas (int id, int size);
 
 */
 
@@ -54,6 +59,9 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 
 #define PANGO_TEXT_SIZE 500
 #define OUTLINE_WIDTH 3
+#define ATLAS_WIDTH 1024
+#define ATLAS_HEIGHT 64
+#define ATLAS_CACHE 8
 
 #ifndef GL_CLAMP_TO_EDGE
 #  define GL_CLAMP_TO_EDGE 0x812F
@@ -65,9 +73,21 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 
 extern int measures_drawing;
 extern int type_of_measure;
-extern void update_string_instances (glsl_program * glsl, object_3d * obj);
+extern gchar * substitute_string (gchar * init, gchar * o_motif, gchar * n_motif);
 
-GLuint textures_id[2];
+/*! \typedef glyph
+
+  \brief a character in a glyph atlas
+*/
+typedef struct glyph glyph;
+struct glyph
+{
+  int x;                          /*!< Position in the atlas, in pixels: x */
+  int y;                          /*!< Position in the atlas, in pixels: y */
+  int width;                      /*!< Width in the atlas, including the outline margins, 0 if nothing to draw */
+  int height;                     /*!< Height in the atlas, including the outline margins */
+  int advance;                    /*!< Horizontal advance to the next character */
+};
 
 const int OUTLINE_BRUSH[2*OUTLINE_WIDTH+1][2*OUTLINE_WIDTH+1]
 = {{ 10, 30,  45,  50,  45,  30,  10 },
@@ -79,145 +99,40 @@ const int OUTLINE_BRUSH[2*OUTLINE_WIDTH+1][2*OUTLINE_WIDTH+1]
    { 10, 30,  45,  50,  45,  30,  10 }};
 
 /*!
-  \fn static void normalize_text_size (GLenum texture,  int * width, int * height)
-
-  \brief normalize the text size
-
-  \param texture the texture type
-  \param width image width
-  \param height image height
-*/
-static void normalize_text_size (GLenum texture,  int * width, int * height)
-{
-  // if the texture target is GL_TEXTURE_2D, that means that
-  // the texture_rectangle OpenGL extension is unsupported and we must
-  // use only square, power-of-two textures.
-  if (texture == GL_TEXTURE_2D)
-  {
-    int x = max (* width, * height);
-    // find next power of two
-    int n;
-    for (n = 1; n < x; n = n << 1);
-    // the texture must be square, and its size must be a power of two.
-    * width = * height = n;
-  }
-}
-
-/*!
-  \fn int * paint_bitmap (vec4_t color, GLfloat a, int cw, int ch, unsigned char * buff)
+  \fn static void outline_glyph (int cwidth, int cheight, GLubyte * pixels, GLubyte * outline)
 
-  \brief paint bitmap data using color
-
-  \param color the color
-  \param a opacity
-  \param cw width
-  \param ch height
-  \param buff the data to paint
-*/
-int * paint_bitmap (vec4_t color, GLfloat a, int cw, int ch, unsigned char * buff)
-{
-  int i;
-  guint8 * row, * row_end;
-  guint32 rgb;
-  guint32 * p;
-  int * bitmap;
-
-#if ! defined(GL_VERSION_1_2) && G_BYTE_ORDER == G_LITTLE_ENDIAN
-  rgb = ((guint32) (color.x* 255.0))         |
-        (((guint32) (color.y * 255.0)) << 8) |
-        (((guint32) (color.z * 255.0)) << 16);
-#else
-  rgb = (((guint32) (color.x * 255.0)) << 24) |
-        (((guint32) (color.y * 255.0)) << 16) |
-        (((guint32) (color.z * 255.0)) << 8);
-#endif
-  bitmap = allocint (cw * ch * 4);
-  p = (guint32 *) bitmap;
-  row = buff + cw*ch;          /* past-the-end */
-  row_end = buff;              /* beginning */
-  if (a == 1.0)
-  {
-    while (row != row_end)
-    {
-       row -= cw;
-       for (i = 0; i < cw; i++)
-       {
-#if ! defined(GL_VERSION_1_2) && G_BYTE_ORDER == G_LITTLE_ENDIAN
-         * p++ = rgb | (((guint32) row[i]) << 24);
-#else
-         * p++ = rgb | ((guint32) row[i]);
-#endif
-       }
-    }
-  }
-  else
-  {
-    while (row != row_end)
-    {
-      row -= cw;
-      for (i = 0; i < cw; i++)
-      {
-#if ! defined(GL_VERSION_1_2) && G_BYTE_ORDER == G_LITTLE_ENDIAN
-         * p++ = rgb | (((guint32) (a * row[i])) << 24);
-#else
-         * p++ = rgb | ((guint32) (a * row[i]));
-#endif
-      }
-    }
-  }
-
-  return bitmap;
-}
-
-gboolean render_format;
-
-/*!
-  \fn object_3d * create_string_texture (int cwidth, int cheight, int * pixels)
-
-  \brief OpenGL 3D string object rendering
+  \brief compute the outline of a glyph, and adjust the glyph intensity
 
   \param cwidth width
   \param cheight height
-  \param pixels the data to render
+  \param pixels the glyph data, modified on output
+  \param outline the outline data to compute
 */
-object_3d * create_string_texture (int cwidth, int cheight, int * pixels)
+static void outline_glyph (int cwidth, int cheight, GLubyte * pixels, GLubyte * outline)
 {
   int i, j, n;
   int di, dj;
   int fi, fj, fn;
   double x, y;
-  object_3d * new_string;
-
-  new_string = g_malloc0 (sizeof*new_string);
-  if (! new_string) return NULL;
-
   int csize = cwidth * cheight;
 
   int * rawbitmap;
   rawbitmap = allocint(csize);
-  if (! rawbitmap) return NULL;
-
-  n = 0;
-  for (j = 0; j < cheight; j++)
+  for (n = 0; n < csize; n++)
   {
-    for (i = 0; i < cwidth; i++)
-    {
-      x = (GLubyte)(pixels [n])/255.0;
-      y = pow(x, 0.75);
-      rawbitmap[n] = (int)(255.0 * y);
-      n++;
-    }
+    x = pixels[n]/255.0;
+    y = pow(x, 0.75);
+    rawbitmap[n] = (int)(255.0 * y);
   }
 
   int * neighborhood;
   neighborhood = allocint (csize);
-  if (! neighborhood) return NULL;
-
   for (i = 0; i < cheight; i++)
   {
     for (j = 0; j < cwidth; j++)
     {
       n = j + i * cwidth;
+      if (! rawbitmap[n]) continue;
       for (di = -OUTLINE_WIDTH; di <= OUTLINE_WIDTH; di++)
       {
         for (dj = -OUTLINE_WIDTH; dj <= OUTLINE_WIDTH; dj++)
@@ -237,107 +152,148 @@ object_3d * create_string_texture (int cwidth, int cheight, int * pixels)
     }
   }
 
-  // Two channels, for the outline and the glyph
-  GLubyte * channels[2];
-  for (i=0; i<2; i++)
-  {
-    channels[i] = g_malloc (csize*sizeof*channels[i]);
-    if (! channels[i]) return NULL;
-  }
-
   for (n = 0; n < csize; n++)
   {
-    channels[1][n] = (GLubyte)rawbitmap[n];
+    pixels[n] = (GLubyte)rawbitmap[n];
     i = (neighborhood[n] >> 8) + rawbitmap[n];
     if (i > 255)
     {
       i = 255;
     }
-    channels[0][n] = (GLubyte)i;
+    outline[n] = (GLubyte)i;
   }
-
+  g_free (rawbitmap);
   g_free (neighborhood);
+}
 
-  glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
+/*!
+  \fn void resize_glyph_atlas (glyph_atlas * atlas, int width, int height)
 
-  for (i=0; i<2; i++)
-  {
-    glGenTextures (1, & textures_id[i]);
-    if (! textures_id[i]) return NULL;
-    glBindTexture (ogl_texture, textures_id[i]);
-    glTexImage2D (ogl_texture,
-                  0,
-                  GL_RED,
-                  cwidth,
-                  cheight,
-                  0,
-                  GL_RED,
-                  GL_UNSIGNED_BYTE,
-                  channels[i]);
+  \brief resize the data of a glyph atlas, the glyphs already in the atlas keep their position
 
-    glTexParameteri (ogl_texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri (ogl_texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri (ogl_texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri (ogl_texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri (ogl_texture, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-    glBindTexture (ogl_texture, 0);
+  \param atlas the glyph atlas
+  \param width the new width
+  \param height the new height
+*/
+void resize_glyph_atlas (glyph_atlas * atlas, int width, int height)
+{
+  int i, j;
+  GLubyte * pixels;
+  for (i=0; i<atlas -> render+1; i++)
+  {
+    pixels = g_malloc0 (width*height*sizeof*pixels);
+    if (atlas -> pixels[i])
+    {
+      for (j=0; j<atlas -> height; j++)
+      {
+        memcpy (pixels + j*width, atlas -> pixels[i] + j*atlas -> width, atlas -> width*sizeof*pixels);
+      }
+      g_free (atlas -> pixels[i]);
+    }
+    atlas -> pixels[i] = pixels;
   }
-  return new_string;
+  atlas -> width = width;
+  atlas -> height = height;
+  atlas -> update = TRUE;
 }
 
 /*!
-  \fn object_3d * gl_pango_render_layout (PangoLayout * layout, GLenum texture, int id, screen_string * this_string)
+  \fn glyph * add_glyph (glyph_atlas * atlas, PangoLayout * layout, gunichar c)
 
-  \brief OpenGL 3D pango layout object rendering
+  \brief render a character, then pack it in a glyph atlas
 
-  \param layout the Pango layout
-  \param texture the OpenGL texture type
-  \param id the label id
-  \param this_string the screen string
+  \param atlas the glyph atlas
+  \param layout the Pango layout, using the font of the atlas
+  \param c the character to render
 */
-object_3d * gl_pango_render_layout (PangoLayout * layout, GLenum texture, int id, screen_string * this_string)
+glyph * add_glyph (glyph_atlas * atlas, PangoLayout * layout, gunichar c)
 {
   FT_Bitmap bitmap;
   PangoRectangle prect;
-  object_3d * new_string;
+  gchar text[8];
+  GLubyte * outline = NULL;
+  int i, j, k, w, h;
+  glyph * new_glyph = g_malloc0 (sizeof*new_glyph);
+
+  g_hash_table_insert (atlas -> glyphs, GUINT_TO_POINTER(c), new_glyph);
+  i = g_unichar_to_utf8 (c, text);
+  pango_layout_set_text (layout, text, i);
+  pango_layout_get_extents (layout, NULL, & prect);
+  // Nothing to draw, ex: line feed
+  if (prect.width == 0 || prect.height == 0) return new_glyph;
+
+  new_glyph -> advance = PANGO_PIXELS (prect.width);
+  w = new_glyph -> width = PANGO_PIXELS (prect.width) + 2*OUTLINE_WIDTH;
+  h = new_glyph -> height = PANGO_PIXELS (prect.height) + 2*OUTLINE_WIDTH;
+  bitmap.rows = h;
+  bitmap.width = w;
+  bitmap.pitch = w;
+  bitmap.buffer = g_malloc0 (w*h);
+  bitmap.num_grays = 256;
+  bitmap.pixel_mode = ft_pixel_mode_grays;
+  pango_ft2_render_layout (& bitmap, layout, PANGO_PIXELS (-prect.x)+OUTLINE_WIDTH, OUTLINE_WIDTH);
+  if (atlas -> render)
+  {
+    outline = g_malloc0 (w*h);
+    outline_glyph (w, h, bitmap.buffer, outline);
+  }
 
-  int * pixels;
-  int cwidth, cheight;
-  int csize;
+  // Next row of the atlas, then more room if needed
+  if (atlas -> pen[0] + w > atlas -> width)
+  {
+    atlas -> pen[0] = 0;
+    atlas -> pen[1] += atlas -> pen[2];
+    atlas -> pen[2] = 0;
+  }
+  i = atlas -> width;
+  while (w > i) i *= 2;
+  j = atlas -> height;
+  while (atlas -> pen[1] + h > j) j *= 2;
+  if (i != atlas -> width || j != atlas -> height) resize_glyph_atlas (atlas, i, j);
+
+  new_glyph -> x = atlas -> pen[0];
+  new_glyph -> y = atlas -> pen[1];
+  // Bitmap rows are top to bottom, texture rows are bottom to top
+  for (i=0; i<h; i++)
+  {
+    k = (new_glyph -> y + h - 1 - i) * atlas -> width + new_glyph -> x;
+    memcpy (atlas -> pixels[0] + k, bitmap.buffer + i*w, w);
+    if (outline) memcpy (atlas -> pixels[1] + k, outline + i*w, w);
+  }
+  atlas -> pen[0] += w;
+  atlas -> pen[2] = max (atlas -> pen[2], h);
+  atlas -> update = TRUE;
 
-  pango_layout_get_extents (layout, NULL, & prect);
-  if (prect.width == 0 || prect.height == 0) return NULL;
-  cheight = bitmap.rows = PANGO_PIXELS (prect.height) + 2*OUTLINE_WIDTH;
-  cwidth = bitmap.width = PANGO_PIXELS (prect.width) + 2*OUTLINE_WIDTH;
+  g_free (bitmap.buffer);
+  if (outline) g_free (outline);
+  return new_glyph;
+}
 
-  normalize_text_size (ogl_texture, & cwidth, & cheight);
+/*!
+  \fn void upload_glyph_atlas (glyph_atlas * atlas)
 
-  bitmap.pitch = cwidth;
-  csize = cheight*cwidth;
-  bitmap.buffer = g_malloc (csize);
-  memset (bitmap.buffer, 0, csize);
+  \brief send the data of a glyph atlas to the GPU, the textures are created if needed
 
-  bitmap.num_grays = 256;
-  bitmap.pixel_mode = ft_pixel_mode_grays;
-  pango_ft2_render_layout (& bitmap, layout, PANGO_PIXELS (-prect.x)+OUTLINE_WIDTH, OUTLINE_WIDTH);
-  pixels = paint_bitmap (vec4(1.0,0.0,0.0,0.0), 1.0, cwidth, cheight, bitmap.buffer);
-  if (! plot -> labels[id].render)
-  {
-    new_string = g_malloc0 (sizeof*new_string);
-    new_string -> texture = -1;
-    glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
-    glGenTextures (1, & new_string -> texture);
-    if (! new_string -> texture) return NULL;
-    glBindTexture (ogl_texture,  new_string -> texture);
+  \param atlas the glyph atlas
+*/
+void upload_glyph_atlas (glyph_atlas * atlas)
+{
+  int i;
+  glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
+  for (i=0; i<atlas -> render+1; i++)
+  {
+    // The texture name is kept when the atlas grows, shaders using it remain valid
+    if (! atlas -> texture[i]) glGenTextures (1, & atlas -> texture[i]);
+    glBindTexture (ogl_texture, atlas -> texture[i]);
     glTexImage2D (ogl_texture,
                   0,
-                  GL_RGBA,
-                  cwidth,
-                  cheight,
+                  GL_RED,
+                  atlas -> width,
+                  atlas -> height,
                   0,
-                  GL_RGBA,
+                  GL_RED,
                   GL_UNSIGNED_BYTE,
-                  pixels);
+                  atlas -> pixels[i]);
 
     glTexParameteri (ogl_texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri (ogl_texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -346,173 +302,194 @@ object_3d * gl_pango_render_layout (PangoLayout * layout, GLenum texture, int id
     glTexParameteri (ogl_texture, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
     glBindTexture (ogl_texture, 0);
   }
-  else
-  {
-    new_string = create_string_texture (cwidth, cheight, pixels);
-  }
-
-  g_free (pixels);
-
-  new_string -> num_vertices = 4;
-  new_string -> vert_buffer_size = CHAR_BUFF_SIZE;
-  new_string -> vertices = allocfloat (new_string -> num_vertices*CHAR_BUFF_SIZE);
-  float x = (float) cwidth;
-  float y = (float) cheight;
-  float twidth = (ogl_texture == GL_TEXTURE_2D) ? 1.0 : x;
-  float theight = (ogl_texture == GL_TEXTURE_2D) ? 1.0 : y;
-  // 0
-  new_string -> vertices[0] = -x;
-  new_string -> vertices[1] =  y;
-  new_string -> vertices[2] = 0.0;
-  new_string -> vertices[3] = theight;
-  // 1
-  new_string -> vertices[4] = -x;
-  new_string -> vertices[5] = -y;
-  new_string -> vertices[6] = 0.0;
-  new_string -> vertices[7] = 0.0;
-  // 2
-  new_string -> vertices[8] = x;
-  new_string -> vertices[9] = y;
-  new_string -> vertices[10] = twidth;
-  new_string -> vertices[11] = theight;
-  // 3
-  new_string -> vertices[12] =  x;
-  new_string -> vertices[13] = -y;
-  new_string -> vertices[14] = twidth;
-  new_string -> vertices[15] = 0.0;
-
-  new_string -> num_instances = this_string -> num_instances;
-  int i = (this_string -> type == 3) ? 1 : (this_string -> type == 4) ? 3 : 4;
-  new_string -> inst_buffer_size = 3*i;
-  new_string -> instances = duplicate_float (this_string -> num_instances*3*i, this_string -> instances);
-
-  return new_string;
+  atlas -> update = FALSE;
 }
 
 /*!
-  \fn ColRGBA * opposite_color (ColRGBA col)
+  \fn void free_glyph_atlas (glyph_atlas * atlas)
 
-  \brief compute the opposite color
+  \brief free a glyph atlas, and its textures
 
-  \param col input color
+  \param atlas the glyph atlas to free
 */
-ColRGBA * opposite_color (ColRGBA col)
+void free_glyph_atlas (glyph_atlas * atlas)
 {
-  ColRGBA * ocol = g_malloc0 (sizeof*ocol);
-  ocol -> red   = (1.0-col.red)/2.5;
-  ocol -> green = (1.0-col.green)/2.5;
-  ocol -> blue  = (1.0-col.blue)/2.5;
-  ocol -> alpha = 1.0;
-  return ocol;
+  int i;
+  for (i=0; i<2; i++)
+  {
+    if (atlas -> texture[i]) glDeleteTextures (1, & atlas -> texture[i]);
+    if (atlas -> pixels[i]) g_free (atlas -> pixels[i]);
+  }
+  g_hash_table_destroy (atlas -> glyphs);
+  g_free (atlas -> font);
+  g_free (atlas);
 }
 
 /*!
-  \fn void render_string (int glsl, int id, screen_string * this_string)
+  \fn glyph_atlas * get_glyph_atlas (int id, int size)
 
-  \brief render a screen string
+  \brief get the glyph atlas for a label list, it is created if needed,
+  \brief the least recently used atlases not in use are freed
 
-  \param glsl the shader id
   \param id the label id
-  \param this_string the screen string to render
+  \param size the absolute font size, in Pango units
 */
-void render_string (int glsl, int id, screen_string * this_string)
+glyph_atlas * get_glyph_atlas (int id, int size)
 {
-  int j, k, l;
-  double font_size;
-  // Pango elements for labels
-  PangoContext * pcontext;
-  PangoLayout * playout;
-  PangoFontDescription * pfont;
-  object_3d * string_to_render = NULL;
-  int arr_size = (this_string -> type == 4) ? 5 : (this_string -> type == 5) ? 6 : this_string -> type;
-  int shid = (id == 4) ? 1 : 0;
-  //pcontext = pango_ft2_get_context (PANGO_TEXT_SIZE, PANGO_TEXT_SIZE);
-  pcontext = pango_font_map_create_context (pango_ft2_font_map_new ());
-  playout = pango_layout_new (pcontext);
-  pango_layout_set_alignment (playout, PANGO_ALIGN_CENTER);
-  pfont = pango_font_description_from_string (plot -> labels[id].font);
-  j = pango_font_description_get_size (pfont);
-  font_size = j / PANGO_SCALE;
+  int i, j;
+  glyph_atlas * atlas, * prev;
 
-  //g_debug ("Zoom = %f, gnear= %f, p_moy= %f, p_depth= %f", plot -> zoom, plot -> gnear, wingl -> p_moy, plot -> p_depth);
-  if (plot -> labels[id].scale) font_size *= ((ZOOM/plot -> zoom)*(plot -> gnear/6.0)*(wingl -> p_moy/plot -> p_depth));
-  if (in_movie_encoding)
+  prev = NULL;
+  atlas = wingl -> atlas;
+  while (atlas != NULL)
   {
-    l = (wingl -> pixels[0] > wingl -> pixels[1]) ? 1 : 0;
-    font_size *= ((float)wingl -> pixels[l]/(float)tmp_pixels[l]);
+    if (atlas -> size == size && atlas -> render == plot -> labels[id].render && g_strcmp0 (atlas -> font, plot -> labels[id].font) == 0) break;
+    prev = atlas;
+    atlas = atlas -> next;
   }
-  pango_font_description_set_absolute_size (pfont, font_size*PANGO_SCALE);
-  pango_layout_set_font_description (playout, pfont);
-  pango_layout_set_text (playout, this_string -> word, strlen(this_string -> word));
-  string_to_render = gl_pango_render_layout (playout, ogl_texture, id, this_string);
-  if (string_to_render == NULL)
+  if (atlas == NULL)
   {
-    g_warning ("TEXT_RENDER:: For some reason it is impossible to render");
-    g_warning ("TEXT_RENDER:: this string: '%s', using this font: %s", this_string -> word, plot -> labels[id].font);
+    atlas = g_malloc0 (sizeof*atlas);
+    atlas -> font = g_strdup_printf ("%s", plot -> labels[id].font);
+    atlas -> size = size;
+    atlas -> render = plot -> labels[id].render;
+    atlas -> glyphs = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+    resize_glyph_atlas (atlas, ATLAS_WIDTH, ATLAS_HEIGHT);
   }
-  else
+  else if (prev != NULL)
   {
-    for (k=0; k<3; k++) string_to_render -> shift[k] = this_string -> shift[k];
-    string_to_render -> shift[3] = (float) plot -> labels[id].position;
-    string_to_render -> quality = this_string -> type;
-    j = this_string -> id;
-    j *= (plot -> labels[id].render + 1);
-    if (id == 1 && plot -> labels[0].list != NULL)
-    {
-      j += (plot -> labels[0].render + 1) * (plot -> labels[0].list -> last -> id + 1);
-    }
-    if (id == 2)
+    prev -> next = atlas -> next;
+  }
+  // Most recently used first
+  if (atlas != wingl -> atlas)
+  {
+    atlas -> next = wingl -> atlas;
+    wingl -> atlas = atlas;
+  }
+  wingl -> label_atlas[id] = atlas;
+
+  i = 0;
+  prev = atlas;
+  atlas = atlas -> next;
+  while (atlas != NULL)
+  {
+    i ++;
+    for (j=0; j<5; j++) if (wingl -> label_atlas[j] == atlas) break;
+    if (i >= ATLAS_CACHE && j == 5)
     {
-      j += (plot -> xyz -> axis == WIREFRAME) ? 2 : 4;
+      prev -> next = atlas -> next;
+      free_glyph_atlas (atlas);
+      atlas = prev -> next;
     }
-    else if (id == 3 || id == 4)
+    else
     {
-      j += measures_drawing;
+      prev = atlas;
+      atlas = atlas -> next;
     }
-    if (! plot -> labels[id].render)
+  }
+  return wingl -> atlas;
+}
+
+/*!
+  \fn const GLchar * glyph_vertex (int type)
+
+  \brief get the vertex shader to render the characters of a type of string:
+  \brief the string shader, with the quad, texture coordinates, shift and color set for each character
+
+  \param type the type of string (3= labels, 4 = bonds, 5= angles)
+*/
+const GLchar * glyph_vertex (int type)
+{
+  static gchar * glyph_shaders[3] = {NULL, NULL, NULL};
+  gchar * in_vars[4] = {"uniform vec4 pos_shift;", "in vec2 vert;", "in vec2 tcoord;", "void main()"};
+  gchar * out_vars[4] = {"vec4 pos_shift;", "vec2 vert;", "vec2 tcoord;", "void string_main ()"};
+  gchar * str_a, * str_b;
+  int i, j;
+  j = type - 3;
+  if (glyph_shaders[j] == NULL)
+  {
+    str_a = g_strdup_printf ("%s", (type == 3) ? string_vertex : (type == 4) ? angstrom_vertex : degree_vertex);
+    for (i=0; i<4; i++)
     {
-      if (ogl_texture == GL_TEXTURE_RECTANGLE_ARB)
-      {
-        wingl -> ogl_glsl[glsl][shid][j] = init_shader_program (glsl, GLSL_STRING, (this_string -> type == 3) ? string_vertex : (this_string -> type == 4) ? angstrom_vertex : degree_vertex,
-                                                                NULL, string_color, GL_TRIANGLE_STRIP, arr_size, (this_string -> type == 3) ? 7 : 8, FALSE, string_to_render);
-      }
-      else
-      {
-        wingl -> ogl_glsl[glsl][shid][j] = init_shader_program (glsl, GLSL_STRING, (this_string -> type == 3) ? string_vertex : (this_string -> type == 4) ? angstrom_vertex : degree_vertex,
-                                                                NULL, string_color_2d, GL_TRIANGLE_STRIP, arr_size, (this_string -> type == 3) ? 7 : 8, FALSE, string_to_render);
-      }
-      wingl -> ogl_glsl[glsl][shid][j] -> col = duplicate_color(1, & (this_string -> col));
+      str_b = substitute_string (str_a, in_vars[i], out_vars[i]);
+      g_free (str_a);
+      str_a = str_b;
     }
-    else
+    glyph_shaders[j] = g_strdup_printf ("%s\n%s", str_a, glyph_main);
+    g_free (str_a);
+  }
+  return glyph_shaders[j];
+}
+
+/*!
+  \fn const GLchar * glyph_color ()
+
+  \brief get the fragment shader to render the characters of a string:
+  \brief the string shader, with the color set for each character
+*/
+const GLchar * glyph_color ()
+{
+  static gchar * glyph_shaders[2] = {NULL, NULL};
+  gchar * in_vars[3] = {"uniform vec4 vert_color;", "uniform sampler2DRect tex;", "texture (tex, text_coords)"};
+  gchar * out_vars[3] = {"in vec4 vert_color;", "uniform sampler2D tex;", "texture (tex, text_coords/vec2(textureSize (tex, 0)))"};
+  gchar * str_a, * str_b;
+  int i, j;
+  // Texture coordinates are in pixels, normalized for 2D textures
+  j = (ogl_texture == GL_TEXTURE_RECTANGLE_ARB) ? 0 : 1;
+  if (glyph_shaders[j] == NULL)
+  {
+    str_a = g_strdup_printf ("%s", (j) ? string_color_2d : string_color);
+    for (i=0; i<1+2*j; i++)
     {
-      if (ogl_texture == GL_TEXTURE_RECTANGLE_ARB)
-      {
-        string_to_render -> texture = textures_id[0];
-        wingl -> ogl_glsl[glsl][shid][j] = init_shader_program (glsl, GLSL_STRING, (this_string -> type == 3) ? string_vertex : (this_string -> type == 4) ? angstrom_vertex : degree_vertex,
-                                                                NULL, string_color, GL_TRIANGLE_STRIP, arr_size, (this_string -> type == 3) ? 7 : 8, FALSE, string_to_render);
-        wingl -> ogl_glsl[glsl][shid][j] -> col = opposite_color(this_string -> col);
-        string_to_render -> texture = textures_id[1];
-        wingl -> ogl_glsl[glsl][shid][j+1] = init_shader_program (glsl, GLSL_STRING, (this_string -> type == 3) ? string_vertex : (this_string -> type == 4) ? angstrom_vertex : degree_vertex,
-                                                                  NULL, string_color, GL_TRIANGLE_STRIP, arr_size, (this_string -> type == 3) ? 7 : 8, FALSE, string_to_render);
-        wingl -> ogl_glsl[glsl][shid][j+1] -> col = duplicate_color(1, & (this_string -> col));
-      }
-      else
-      {
-        string_to_render -> texture = textures_id[0];
-        wingl -> ogl_glsl[glsl][shid][j] = init_shader_program (glsl, GLSL_STRING, (this_string -> type == 3) ? string_vertex : (this_string -> type == 4) ? angstrom_vertex : degree_vertex,
-                                                                NULL, string_color_2d, GL_TRIANGLE_STRIP, arr_size, (this_string -> type == 3) ? 7 : 8, FALSE, string_to_render);
-        wingl -> ogl_glsl[glsl][shid][j] -> col = opposite_color(this_string -> col);
-        string_to_render -> texture = textures_id[1];
-        wingl -> ogl_glsl[glsl][shid][j+1] = init_shader_program (glsl, GLSL_STRING, (this_string -> type == 3) ? string_vertex : (this_string -> type == 4) ? angstrom_vertex : degree_vertex,
-                                                                  NULL, string_color_2d, GL_TRIANGLE_STRIP, arr_size, (this_string -> type == 3) ? 7 : 8, FALSE, string_to_render);
-        wingl -> ogl_glsl[glsl][shid][j+1] -> col = duplicate_color(1, & (this_string -> col));
-      }
+      str_b = substitute_string (str_a, in_vars[i], out_vars[i]);
+      g_free (str_a);
+      str_a = str_b;
     }
-    g_free (string_to_render);
+    glyph_shaders[j] = str_a;
   }
-  pango_font_description_free (pfont);
-  g_object_unref (G_OBJECT(pcontext));
-  g_object_unref (G_OBJECT(playout));
+  return glyph_shaders[j];
+}
+
+/*!
+  \fn ColRGBA * opposite_color (ColRGBA col)
+
+  \brief compute the opposite color
+
+  \param col input color
+*/
+ColRGBA * opposite_color (ColRGBA col)
+{
+  ColRGBA * ocol = g_malloc0 (sizeof*ocol);
+  ocol -> red   = (1.0-col.red)/2.5;
+  ocol -> green = (1.0-col.green)/2.5;
+  ocol -> blue  = (1.0-col.blue)/2.5;
+  ocol -> alpha = 1.0;
+  return ocol;
+}
+
+/*!
+  \fn int string_shaders (int id)
+
+  \brief get the number of shaders required to render a label list:
+  \brief one for each type of string, or two if the characters are outlined
+
+  \param id the label id
+*/
+int string_shaders (int id)
+{
+  int i, j;
+  gboolean type[3] = {FALSE, FALSE, FALSE};
+  screen_string * this_string;
+  if (plot -> labels[id].list == NULL) return 0;
+  this_string = plot -> labels[id].list -> last;
+  while (this_string != NULL)
+  {
+    type[this_string -> type - 3] = TRUE;
+    this_string = this_string -> prev;
+  }
+  j = 0;
+  for (i=0; i<3; i++) if (type[i]) j += plot -> labels[id].render + 1;
+  return j;
 }
 
 /*!
@@ -541,82 +518,232 @@ void debug_string (screen_string  * this_string)
 /*!
   \fn void render_all_strings (int glsl, int id)
 
-  \brief render all string to be rendered for a label list
+  \brief render all string to be rendered for a label list:
+  \brief the missing characters are added to the glyph atlas, then each character is an instance of a textured quad
 
   \param glsl shader id
   \param id label id
 */
 void render_all_strings (int glsl, int id)
 {
-  if (plot -> labels[id].list != NULL)
+  int i, j, k, l, m, n, o;
+  int size, shid, type;
+  int width, height;
+  double font_size;
+  gchar * c;
+  gunichar u;
+  // Pango elements for labels
+  PangoContext * pcontext = NULL;
+  PangoLayout * playout = NULL;
+  PangoFontDescription * pfont;
+  glyph_atlas * atlas;
+  glyph * this_glyph;
+  ColRGBA scol;
+  ColRGBA * col;
+  float * inst;
+  object_3d * glyphs;
+  screen_string * this_string;
+
+  if (plot -> labels[id].list == NULL) return;
+
+  pfont = pango_font_description_from_string (plot -> labels[id].font);
+  j = pango_font_description_get_size (pfont);
+  font_size = j / PANGO_SCALE;
+  //g_debug ("Zoom = %f, gnear= %f, p_moy= %f, p_depth= %f", plot -> zoom, plot -> gnear, wingl -> p_moy, plot -> p_depth);
+  if (plot -> labels[id].scale) font_size *= ((ZOOM/plot -> zoom)*(plot -> gnear/6.0)*(wingl -> p_moy/plot -> p_depth));
+  if (in_movie_encoding)
   {
-    screen_string  * this_string = plot -> labels[id].list -> last;
-    while (this_string != NULL)
+    l = (wingl -> pixels[0] > wingl -> pixels[1]) ? 1 : 0;
+    font_size *= ((float)wingl -> pixels[l]/(float)tmp_pixels[l]);
+  }
+  size = (int) (font_size*PANGO_SCALE);
+  atlas = get_glyph_atlas (id, size);
+
+  // Each character is rendered once, then re-used for any label using the same font
+  this_string = plot -> labels[id].list -> last;
+  while (this_string != NULL)
+  {
+    for (c = this_string -> word; * c; c = g_utf8_next_char (c))
     {
-      //if (glsl == MEASU) debug_string (this_string);
-      render_string (glsl, id, this_string);
-      this_string = this_string -> prev;
+      u = g_utf8_get_char (c);
+      if (! g_hash_table_contains (atlas -> glyphs, GUINT_TO_POINTER(u)))
+      {
+        if (playout == NULL)
+        {
+          pcontext = pango_font_map_create_context (pango_ft2_font_map_new ());
+          playout = pango_layout_new (pcontext);
+          pango_layout_set_alignment (playout, PANGO_ALIGN_CENTER);
+          pango_font_description_set_absolute_size (pfont, size);
+          pango_layout_set_font_description (playout, pfont);
+        }
+        add_glyph (atlas, playout, u);
+      }
     }
+    this_string = this_string -> prev;
   }
-}
-
-/*!
-  \fn screen_string * was_not_rendered_already (char * word, screen_string * list)
-
-  \brief check if a string was not already rendered and the corresponding screen string created
+  if (playout != NULL)
+  {
+    g_object_unref (G_OBJECT(pcontext));
+    g_object_unref (G_OBJECT(playout));
+  }
+  pango_font_description_free (pfont);
+  if (atlas -> update) upload_glyph_atlas (atlas);
 
-  \param word the string to render
-  \param list the screen string list
-*/
-screen_string * was_not_rendered_already (char * word, screen_string * list)
-{
-  if (list != NULL)
+  shid = (id == 4) ? 1 : 0;
+  j = 0;
+  if (id == 1)
+  {
+    j = string_shaders (0);
+  }
+  else if (id == 2)
+  {
+    j = (plot -> xyz -> axis == WIREFRAME) ? 2 : 4;
+  }
+  else if (id == 3 || id == 4)
+  {
+    j = measures_drawing;
+  }
+  for (type=3; type<6; type++)
   {
-    screen_string * tmp_string = list -> last;
-    while (tmp_string != NULL)
+    // Number of characters to draw
+    n = o = 0;
+    this_string = plot -> labels[id].list -> last;
+    while (this_string != NULL)
+    {
+      if (this_string -> type == type)
+      {
+        o = 1;
+        for (c = this_string -> word; * c; c = g_utf8_next_char (c))
+        {
+          this_glyph = g_hash_table_lookup (atlas -> glyphs, GUINT_TO_POINTER(g_utf8_get_char (c)));
+          if (this_glyph -> width) n += this_string -> num_instances;
+        }
+      }
+      this_string = this_string -> prev;
+    }
+    if (! o) continue;
+    if (! n)
     {
-      if (g_strcmp0 (tmp_string -> word, word) == 0)
+      j += plot -> labels[id].render + 1;
+      continue;
+    }
+    k = (type == 3) ? 1 : (type == 4) ? 3 : 4;
+    glyphs = g_malloc0 (sizeof*glyphs);
+    glyphs -> num_vertices = 4;
+    glyphs -> vert_buffer_size = CHAR_BUFF_SIZE;
+    glyphs -> vertices = allocfloat (glyphs -> num_vertices*CHAR_BUFF_SIZE);
+    // Quad corners: 0 = (0,1), 1 = (0,0), 2 = (1,1), 3 = (1,0)
+    glyphs -> vertices[1] = glyphs -> vertices[4] = glyphs -> vertices[5] = 1.0;
+    glyphs -> num_instances = n;
+    glyphs -> inst_buffer_size = GLYPH_BUFF_SIZE + 3*k;
+    glyphs -> instances = allocfloat (n*glyphs -> inst_buffer_size);
+    m = 0;
+    this_string = plot -> labels[id].list -> last;
+    while (this_string != NULL)
+    {
+      if (this_string -> type == type)
+      {
+        // Size of the string, as it was rendered in a single texture
+        width = height = 0;
+        for (c = this_string -> word; * c; c = g_utf8_next_char (c))
+        {
+          this_glyph = g_hash_table_lookup (atlas -> glyphs, GUINT_TO_POINTER(g_utf8_get_char (c)));
+          width += this_glyph -> advance;
+          height = max (height, this_glyph -> height);
+        }
+        width += 2*OUTLINE_WIDTH;
+        for (i=0; i<this_string -> num_instances; i++)
+        {
+          l = 0;
+          for (c = this_string -> word; * c; c = g_utf8_next_char (c))
+          {
+            this_glyph = g_hash_table_lookup (atlas -> glyphs, GUINT_TO_POINTER(g_utf8_get_char (c)));
+            if (this_glyph -> width)
+            {
+              inst = glyphs -> instances + m*glyphs -> inst_buffer_size;
+              for (o=0; o<3; o++) inst[o] = this_string -> shift[o];
+              inst[3] = (float) plot -> labels[id].position;
+              // The quad, centered on the string, the texture coordinates in the atlas
+              inst[4] = 2.0*l - width;
+              inst[5] = - height;
+              inst[6] = inst[4] + 2.0*this_glyph -> width;
+              inst[7] = height;
+              inst[8] = this_glyph -> x;
+              inst[9] = this_glyph -> y;
+              inst[10] = this_glyph -> x + this_glyph -> width;
+              inst[11] = this_glyph -> y + this_glyph -> height;
+              inst[12] = this_string -> col.red;
+              inst[13] = this_string -> col.green;
+              inst[14] = this_string -> col.blue;
+              inst[15] = this_string -> col.alpha;
+              for (o=0; o<3*k; o++) inst[GLYPH_BUFF_SIZE+o] = this_string -> instances[3*k*i+o];
+              m ++;
+            }
+            l += this_glyph -> advance;
+          }
+        }
+      }
+      this_string = this_string -> prev;
+    }
+    for (l=0; l<plot -> labels[id].render+1; l++)
+    {
+      if (plot -> labels[id].render && ! l)
+      {
+        // The outline first, using the opposite color
+        inst = glyphs -> instances;
+        glyphs -> instances = duplicate_float (n*glyphs -> inst_buffer_size, inst);
+        for (m=0; m<n; m++)
+        {
+          i = m*glyphs -> inst_buffer_size + 12;
+          scol.red = inst[i];
+          scol.green = inst[i+1];
+          scol.blue = inst[i+2];
+          scol.alpha = inst[i+3];
+          col = opposite_color (scol);
+          glyphs -> instances[i] = col -> red;
+          glyphs -> instances[i+1] = col -> green;
+          glyphs -> instances[i+2] = col -> blue;
+          glyphs -> instances[i+3] = col -> alpha;
+          g_free (col);
+        }
+        glyphs -> texture = atlas -> texture[1];
+      }
+      else
       {
-        return tmp_string;
+        glyphs -> texture = atlas -> texture[0];
       }
-      tmp_string = tmp_string -> prev;
+      wingl -> ogl_glsl[glsl][shid][j] = init_shader_program (glsl, GLSL_STRING, glyph_vertex (type), NULL, glyph_color (),
+                                                              GL_TRIANGLE_STRIP, 5+k, (type == 3) ? 7 : 8, FALSE, glyphs);
+      if (plot -> labels[id].render && ! l)
+      {
+        g_free (glyphs -> instances);
+        glyphs -> instances = inst;
+      }
+      j ++;
     }
-    tmp_string = NULL;
-    g_free (tmp_string);
+    g_free (glyphs -> vertices);
+    g_free (glyphs -> instances);
+    g_free (glyphs);
   }
-  return NULL;
 }
 
 /*!
-  \fn void add_string_instance (screen_string * string, vec3_t pos, atom * at, atom * bt, atom * ct)
+  \fn void add_string_instance (screen_string * string, vec3_t pos, atom_pos * at, atom_pos * bt, atom_pos * ct)
 
   \brief add an instance to a screen string
 
   \param string the screen string to increase
   \param pos the position
-  \param at the 1st atom, if any (bond or angle measure string)
-  \param bt the 2nd atom, if any (bond or angle measure string)
-  \param ct the 3rd atom, if any (angle measure string)
+  \param at the coordinates of the 1st atom, if any (bond or angle measure string)
+  \param bt the coordinates of the 2nd atom, if any (bond or angle measure string)
+  \param ct the coordinates of the 3rd atom, if any (angle measure string)
 */
-void add_string_instance (screen_string * string, vec3_t pos, atom * at, atom * bt, atom * ct)
+void add_string_instance (screen_string * string, vec3_t pos, atom_pos * at, atom_pos * bt, atom_pos * ct)
 {
   int i, j;
-  i = 0;
   j = (string -> type == 3) ? 1 : (type_of_measure == 6) ? 3 : 4;
-  if (string -> num_instances > 0)
-  {
-    float * instances = duplicate_float (3*j*string -> num_instances, string -> instances);
-    g_free (string -> instances);
-    string -> instances = allocfloat (3*j*(string -> num_instances+1));
-    for (i=0; i<3*j*string -> num_instances; i++)
-    {
-      string -> instances[i] = instances[i];
-    }
-  }
-  else
-  {
-    string -> instances = allocfloat (3*j);
-  }
+  i = 3*j*string -> num_instances;
+  string -> instances = g_realloc (string -> instances, 3*j*(string -> num_instances+1)*sizeof*string -> instances);
   string -> num_instances ++;
   string -> instances[i] = pos.x;
   string -> instances[i+1] = pos.y;
@@ -639,7 +766,7 @@ void add_string_instance (screen_string * string, vec3_t pos, atom * at, atom *
 }
 
 /*!
-  \fn void add_string (char * text, int id, ColRGBA col, vec3_t pos, float lshift[3], atom * at, atom * bt, atom * ct)
+  \fn void add_string (char * text, int id, ColRGBA col, vec3_t pos, float lshift[3], atom_pos * at, atom_pos * bt, atom_pos * ct)
 
   \brief Add a screen string to the list of screen string to render
 
@@ -648,11 +775,11 @@ void add_string_instance (screen_string * string, vec3_t pos, atom * at, atom *
   \param col the color
   \param pos the position
   \param lshift label position shift on x, y and z, if any
-  \param at the 1st atom, if any (bond or angle measure string)
-  \param bt the 2nd atom, if any (bond or angle measure string)
-  \param ct the 3rd atom, if any (angle measure string)
+  \param at the coordinates of the 1st atom, if any (bond or angle measure string)
+  \param bt the coordinates of the 2nd atom, if any (bond or angle measure string)
+  \param ct the coordinates of the 3rd atom, if any (angle measure string)
 */
-void add_string (char * text, int id, ColRGBA col, vec3_t pos, float lshift[3], atom * at, atom * bt, atom * ct)
+void add_string (char * text, int id, ColRGBA col, vec3_t pos, float lshift[3], atom_pos * at, atom_pos * bt, atom_pos * ct)
 {
   if (plot -> labels[id].list == NULL)
   {
@@ -675,7 +802,7 @@ void add_string (char * text, int id, ColRGBA col, vec3_t pos, float lshift[3],
 }
 
 /*!
-  \fn void prepare_string (char * text, int id, ColRGBA col, vec3_t pos, float lshift[3], atom * at, atom * bt, atom * ct)
+  \fn void prepare_string (char * text, int id, ColRGBA col, vec3_t pos, float lshift[3], atom_pos * at, atom_pos * bt, atom_pos * ct)
 
   \brief prepare a screen string to be rendered
 
@@ -684,16 +811,25 @@ void add_string (char * text, int id, ColRGBA col, vec3_t pos, float lshift[3],
   \param col the color
   \param pos the position
   \param lshift label position shift on x, y and z, if any
-  \param at the 1st atom, if any (bond or angle measure string)
-  \param bt the 2nd atom, if any (bond or angle measure string)
-  \param ct the 3rd atom, if any (angle measure string)
+  \param at the coordinates of the 1st atom, if any (bond or angle measure string)
+  \param bt the coordinates of the 2nd atom, if any (bond or angle measure string)
+  \param ct the coordinates of the 3rd atom, if any (angle measure string)
 */
-void prepare_string (char * text, int id, ColRGBA col, vec3_t pos, float lshift[3], atom * at, atom * bt, atom * ct)
+void prepare_string (char * text, int id, ColRGBA col, vec3_t pos, float lshift[3], atom_pos * at, atom_pos * bt, atom_pos * ct)
 {
-  screen_string * this_string = was_not_rendered_already (text, plot -> labels[id].list);
+  screen_string * this_string = NULL;
+  if (plot -> labels[id].words == NULL)
+  {
+    plot -> labels[id].words = g_hash_table_new (g_str_hash, g_str_equal);
+  }
+  else
+  {
+    this_string = g_hash_table_lookup (plot -> labels[id].words, text);
+  }
   if (this_string == NULL)
   {
     add_string (text, id, col, pos, lshift, at, bt, ct);
+    g_hash_table_insert (plot -> labels[id].words, plot -> labels[id].list -> last -> word, plot -> labels[id].list -> last);
   }
   else
   {
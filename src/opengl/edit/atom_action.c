@@ -316,9 +316,9 @@ int action_atoms_from_project (project * this_proj, atom_search * asearch, gbool
           tmp_add -> id = this_proj -> natomes + extra - remove;
           l = object -> at_list[k].sp;
           tmp_add -> type = find_spec_id (edit -> coord -> species, object -> old_z[l], edit -> new_z);
-          tmp_add -> xyz[0] = object -> at_list[k].x + object -> baryc[0];
-          tmp_add -> xyz[1] = object -> at_list[k].y + object -> baryc[1];
-          tmp_add -> xyz[2] = object -> at_list[k].z + object -> baryc[2];
+          tmp_add -> xyz[0] = object -> at_pos[k].x + object -> baryc[0];
+          tmp_add -> xyz[1] = object -> at_pos[k].y + object -> baryc[1];
+          tmp_add -> xyz[2] = object -> at_pos[k].z + object -> baryc[2];
           for (m=0; m<2; m++)
           {
             tmp_add -> coord[m] = find_this_geo_id (m, object -> coord, object -> old_z, object -> at_list[k].coord[m],
@@ -492,6 +492,8 @@ int action_atoms_from_project (project * this_proj, atom_search * asearch, gbool
 
   atom * new_list = NULL;
   atom * tmp_new = NULL;
+  atom_pos * new_pos = NULL;
+  int npos = 0;
   gboolean * showfrag;
   int ** tmpgeo[2];
   int new_atoms = 0;
@@ -499,6 +501,8 @@ int action_atoms_from_project (project * this_proj, atom_search * asearch, gbool
   if (this_proj -> natomes)
   {
     old_id = allocint (this_proj -> natomes);
+    // The coordinates of the atoms in 'new_list', in the same order
+    new_pos = g_malloc (this_proj -> natomes*sizeof*new_pos);
     tmp_rem = to_rem;
     for (i=0; i<this_proj -> natomes; i++)
     {
@@ -518,6 +522,8 @@ int action_atoms_from_project (project * this_proj, atom_search * asearch, gbool
             new_list = duplicate_atom (& this_proj -> atoms[0][i]);
             tmp_new = new_list;
           }
+          new_pos[npos] = get_atom_pos (this_proj, 0, i);
+          npos ++;
           new_atoms ++;
         }
         if (tmp_rem -> next != NULL) tmp_rem = tmp_rem -> next;
@@ -536,6 +542,8 @@ int action_atoms_from_project (project * this_proj, atom_search * asearch, gbool
           new_list = duplicate_atom (& this_proj -> atoms[0][i]);
           tmp_new = new_list;
         }
+        new_pos[npos] = get_atom_pos (this_proj, 0, i);
+        npos ++;
         new_atoms ++;
       }
     }
@@ -676,9 +684,11 @@ int action_atoms_from_project (project * this_proj, atom_search * asearch, gbool
       }
       tmp_new -> sp = tmp_add -> type;
       tmp_new -> show[0] = tmp_new -> show[1] = TRUE;
-      tmp_new -> x = tmp_add -> xyz[0];
-      tmp_new -> y = tmp_add -> xyz[1];
-      tmp_new -> z = tmp_add -> xyz[2];
+      new_pos = g_realloc (new_pos, (npos+1)*sizeof*new_pos);
+      new_pos[npos].x = tmp_add -> xyz[0];
+      new_pos[npos].y = tmp_add -> xyz[1];
+      new_pos[npos].z = tmp_add -> xyz[2];
+      npos ++;
       for (i=0; i<4; i++) tmp_new -> coord[i] = tmp_add -> coord[i];
       i = tmp_new -> sp;
       for (j=0; j<2; j++)
@@ -749,6 +759,7 @@ int action_atoms_from_project (project * this_proj, atom_search * asearch, gbool
 
   if (this_proj -> nspec)
   {
+    free_step_neighbors (this_proj, 0);
     g_free (this_proj -> atoms[0]);
   }
   else
@@ -763,11 +774,13 @@ int action_atoms_from_project (project * this_proj, atom_search * asearch, gbool
   int * atid = allocint (new_atoms);
   this_proj -> atoms[0] = g_malloc0 (new_atoms*sizeof*this_proj -> atoms[0]);
   tmp_new = new_list;
-  i = 0;
+  i = npos = 0;
   while (tmp_new)
   {
     if (asearch -> action != REMOVE || old_id[tmp_new -> id] > 0)
     {
+      // i <= npos: the coordinates of the atoms kept can be packed in place
+      new_pos[i] = new_pos[npos];
       this_proj -> atoms[0][i] = * duplicate_atom (tmp_new);
       this_proj -> atoms[0][i].id = i;
       spid[this_proj -> atoms[0][i].sp] ++;
@@ -775,6 +788,7 @@ int action_atoms_from_project (project * this_proj, atom_search * asearch, gbool
       this_proj -> atoms[0][i].pick[0] = this_proj -> atoms[0][i].pick[1] = FALSE;
       i ++;
     }
+    npos ++;
     if (tmp_new -> next)
     {
       tmp_new = tmp_new -> next;
@@ -876,15 +890,17 @@ int action_atoms_from_project (project * this_proj, atom_search * asearch, gbool
   g_free (atid);
 
   i = activep;
-  if (! this_proj -> natomes)
+  gboolean to_center = (! this_proj -> natomes && ! this_proj -> cell.crystal) ? TRUE : FALSE;
+  this_proj -> natomes = new_atoms;
+  alloc_project_pos (this_proj);
+  for (j=0; j<new_atoms; j++)
   {
-    this_proj -> natomes = new_atoms;
-    if (! this_proj -> cell.crystal) center_molecule (this_proj);
-  }
-  else
-  {
-    this_proj -> natomes = new_atoms;
+    this_proj -> pos[0][0][j] = new_pos[j].x;
+    this_proj -> pos[0][1][j] = new_pos[j].y;
+    this_proj -> pos[0][2][j] = new_pos[j].z;
   }
+  if (new_pos) g_free (new_pos);
+  if (to_center) center_molecule (this_proj);
 
   // Active project changes in the next call
   recover_opengl_data (this_proj, nmols, edit -> add_spec, rem_spec, spid, spdel, tmpgeo, showfrag);
@@ -111,6 +111,7 @@ extern void correct_pos_and_get_dim (atomic_object * object, gboolean adjust);
 extern atomic_object * duplicate_atomic_object (atomic_object * old_obj);
 extern atomic_object * create_object_from_species (project * this_proj, int sid, atom_search * remove);
 extern void reconstruct_bonds (project * this_proj, int ifcl, int * bcid);
+extern gboolean update_distance_matrix ();
 extern void reconstruct_coordinates_for_object (project * this_proj, atomic_object * this_object, gboolean upcoord);
 extern atomic_object * create_object_from_selection (project * this_proj);
 extern atomic_object * create_object_from_atom_coordination (project * this_proj, int coord, int aid, atom_search * remove);
@@ -111,9 +111,9 @@ double ** save_coordinates (project * this_proj, int status)
   {
     for (i=0; i<this_proj -> natomes; i++)
     {
-      coords[i][0] = this_proj -> atoms[0][i].x;
-      coords[i][1] = this_proj -> atoms[0][i].y;
-      coords[i][2] = this_proj -> atoms[0][i].z;
+      coords[i][0] = this_proj -> pos[0][0][i];
+      coords[i][1] = this_proj -> pos[0][1][i];
+      coords[i][2] = this_proj -> pos[0][2][i];
     }
   }
   else
@@ -122,9 +122,9 @@ double ** save_coordinates (project * this_proj, int status)
     {
       if (this_proj -> atoms[0][j].pick[0] == status)
       {
-        coords[i][0] = this_proj -> atoms[0][j].x;
-        coords[i][1] = this_proj -> atoms[0][j].y;
-        coords[i][2] = this_proj -> atoms[0][j].z;
+        coords[i][0] = this_proj -> pos[0][0][j];
+        coords[i][1] = this_proj -> pos[0][1][j];
+        coords[i][2] = this_proj -> pos[0][2][j];
         i ++;
       }
     }
@@ -150,9 +150,9 @@ void reset_coordinates (project * this_proj, int status)
     {
       if (this_proj -> atoms[0][j].pick[0] == status || status > 1)
       {
-        this_proj -> atoms[0][j].x = this_proj -> modelgl -> saved_coord[status][i][0];
-        this_proj -> atoms[0][j].y = this_proj -> modelgl -> saved_coord[status][i][1];
-        this_proj -> atoms[0][j].z = this_proj -> modelgl -> saved_coord[status][i][2];
+        this_proj -> pos[0][0][j] = this_proj -> modelgl -> saved_coord[status][i][0];
+        this_proj -> pos[0][1][j] = this_proj -> modelgl -> saved_coord[status][i][1];
+        this_proj -> pos[0][2][j] = this_proj -> modelgl -> saved_coord[status][i][2];
         i ++;
       }
     }
@@ -177,7 +177,7 @@ vec3_t get_bary (project * this_proj, int status)
     if (this_proj -> atoms[0][j].pick[0] == status || status == 2)
     {
       i += 1.0;
-      bar = v3_add (bar, vec3(this_proj -> atoms[0][j].x, this_proj -> atoms[0][j].y, this_proj -> atoms[0][j].z));
+      bar = v3_add (bar, vec3(this_proj -> pos[0][0][j], this_proj -> pos[0][1][j], this_proj -> pos[0][2][j]));
     }
   }
   if (i > 0.0) bar = v3_divs (bar, i);
@@ -237,7 +237,7 @@ void translate (project * this_proj, int status, int axis, vec3_t trans)
     {
       if (this_proj -> atoms[i][j].pick[0] == status || status < 0)
       {
-        c_old = vec3(this_proj -> atoms[i][j].x, this_proj -> atoms[i][j].y, this_proj -> atoms[i][j].z);
+        c_old = vec3(this_proj -> pos[i][0][j], this_proj -> pos[i][1][j], this_proj -> pos[i][2][j]);
         if (axis)
         {
           c_new = m4_mul_pos (this_proj -> modelgl -> view_matrix, c_old);
@@ -248,9 +248,9 @@ void translate (project * this_proj, int status, int axis, vec3_t trans)
         {
           c_new = v3_add (c_old, trans);
         }
-        this_proj -> atoms[i][j].x = c_new.x;
-        this_proj -> atoms[i][j].y = c_new.y;
-        this_proj -> atoms[i][j].z = c_new.z;
+        this_proj -> pos[i][0][j] = c_new.x;
+        this_proj -> pos[i][1][j] = c_new.y;
+        this_proj -> pos[i][2][j] = c_new.z;
       }
     }
   }
@@ -275,7 +275,7 @@ void rotate_quat (project * this_proj, vec4_t q, int status, int axis)
   {
     if (this_proj -> atoms[0][j].pick[0] == status)
     {
-      c_old = vec3(this_proj -> atoms[0][j].x, this_proj -> atoms[0][j].y, this_proj -> atoms[0][j].z);
+      c_old = vec3(this_proj -> pos[0][0][j], this_proj -> pos[0][1][j], this_proj -> pos[0][2][j]);
       c_new = v3_sub(c_old, this_proj -> modelgl -> baryc[status]);
       if (axis)
       {
@@ -288,9 +288,9 @@ void rotate_quat (project * this_proj, vec4_t q, int status, int axis)
         c_old = m4_mul_pos (rot, c_new);
       }
       c_new = v3_add (c_old, this_proj -> modelgl -> baryc[status]);
-      this_proj -> atoms[0][j].x = c_new.x;
-      this_proj -> atoms[0][j].y = c_new.y;
-      this_proj -> atoms[0][j].z = c_new.z;
+      this_proj -> pos[0][0][j] = c_new.x;
+      this_proj -> pos[0][1][j] = c_new.y;
+      this_proj -> pos[0][2][j] = c_new.z;
     }
   }
 }
@@ -342,13 +342,13 @@ void random_move_this_atom (project * this_proj, int aid)
     switch (j)
     {
       case 0:
-        this_proj -> atoms[0][aid].x += l*prob*sqrt(this_proj -> modelgl -> atom_win -> msd[aid]/3.0);
+        this_proj -> pos[0][0][aid] += l*prob*sqrt(this_proj -> modelgl -> atom_win -> msd[aid]/3.0);
         break;
       case 1:
-        this_proj -> atoms[0][aid].y += l*prob*sqrt(this_proj -> modelgl -> atom_win -> msd[aid]/3.0);
+        this_proj -> pos[0][1][aid] += l*prob*sqrt(this_proj -> modelgl -> atom_win -> msd[aid]/3.0);
         break;
       case 2:
-        this_proj -> atoms[0][aid].z += l*prob*sqrt(this_proj -> modelgl -> atom_win -> msd[aid]/3.0);
+        this_proj -> pos[0][2][aid] += l*prob*sqrt(this_proj -> modelgl -> atom_win -> msd[aid]/3.0);
         break;
     }
   }
@@ -393,15 +393,15 @@ void random_rotate_this_object (project * this_proj, atomic_object * object, dou
       n = object -> at_list[m].id;
       if (! was_moved_atom[n])
       {
-        c_old = vec3(object -> at_list[m].x, object -> at_list[m].y, object -> at_list[m].z);
+        c_old = vec3(object -> at_pos[m].x, object -> at_pos[m].y, object -> at_pos[m].z);
         c_new = m4_mul_pos (rot, c_old);
-        object -> at_list[m].x = c_new.x;
-        object -> at_list[m].y = c_new.y;
-        object -> at_list[m].z = c_new.z;
+        object -> at_pos[m].x = c_new.x;
+        object -> at_pos[m].y = c_new.y;
+        object -> at_pos[m].z = c_new.z;
         c_old = v3_add (c_new, baryc);
-        this_proj -> atoms[0][n].x = c_old.x;
-        this_proj -> atoms[0][n].y = c_old.y;
-        this_proj -> atoms[0][n].z = c_old.z;
+        this_proj -> pos[0][0][n] = c_old.x;
+        this_proj -> pos[0][1][n] = c_old.y;
+        this_proj -> pos[0][2][n] = c_old.z;
       }
     }
   }
@@ -437,21 +437,21 @@ void random_translate_this_object (project * this_proj, atomic_object * object,
         for (m=0; m<object -> atoms; m++)
         {
           n = object -> at_list[m].id;
-          if (! was_moved_atom[n]) this_proj -> atoms[0][n].x += prob;
+          if (! was_moved_atom[n]) this_proj -> pos[0][0][n] += prob;
         }
         break;
       case 1:
         for (m=0; m<object -> atoms; m++)
         {
           n = object -> at_list[m].id;
-          if (! was_moved_atom[n]) this_proj -> atoms[0][n].y += prob;
+          if (! was_moved_atom[n]) this_proj -> pos[0][1][n] += prob;
         }
         break;
       case 2:
         for (m=0; m<object -> atoms; m++)
         {
           n = object -> at_list[m].id;
-          if (! was_moved_atom[n]) this_proj -> atoms[0][n].z += prob;
+          if (! was_moved_atom[n]) this_proj -> pos[0][2][n] += prob;
         }
         break;
     }
@@ -683,6 +683,8 @@ void random_move (project * this_proj, atom_search * asearch)
   {
     i = activep;
     active_project_changed (activep);
+    // Only the neighbors of the atom(s) that moved are computed again, if possible
+    active_project -> dmtx = update_distance_matrix ();
     bonds_update = 1;
     frag_update = (active_project -> natomes > ATOM_LIMIT) ? 0 : 1;
     mol_update = (frag_update) ? ((active_project -> steps > STEP_LIMIT) ? 0 : 1) : 0;
@@ -713,7 +715,7 @@ void random_move (project * this_proj, atom_search * asearch)
 void translate_this_atom (project * this_proj, int aid, int axis, vec3_t trans)
 {
   vec3_t c_old, c_new;
-  c_old = vec3(this_proj -> atoms[0][aid].x, this_proj -> atoms[0][aid].y, this_proj -> atoms[0][aid].z);
+  c_old = vec3(this_proj -> pos[0][0][aid], this_proj -> pos[0][1][aid], this_proj -> pos[0][2][aid]);
   if (axis)
   {
     c_new = m4_mul_pos (this_proj -> modelgl -> view_matrix, c_old);
@@ -724,9 +726,9 @@ void translate_this_atom (project * this_proj, int aid, int axis, vec3_t trans)
   {
     c_new = v3_add (c_old, trans);
   }
-  this_proj -> atoms[0][aid].x = c_new.x;
-  this_proj -> atoms[0][aid].y = c_new.y;
-  this_proj -> atoms[0][aid].z = c_new.z;
+  this_proj -> pos[0][0][aid] = c_new.x;
+  this_proj -> pos[0][1][aid] = c_new.y;
+  this_proj -> pos[0][2][aid] = c_new.z;
 }
 
 /*!
@@ -763,9 +765,9 @@ void translate_this_object (project * this_proj, atomic_object * object, int axi
     if (! was_moved_atom[j])
     {
       was_moved_atom[j] = TRUE;
-      this_proj -> atoms[0][j].x = object -> baryc[0] + object -> at_list[i].x;
-      this_proj -> atoms[0][j].y = object -> baryc[1] + object -> at_list[i].y;
-      this_proj -> atoms[0][j].z = object -> baryc[2] + object -> at_list[i].z;
+      this_proj -> pos[0][0][j] = object -> baryc[0] + object -> at_pos[i].x;
+      this_proj -> pos[0][1][j] = object -> baryc[1] + object -> at_pos[i].y;
+      this_proj -> pos[0][2][j] = object -> baryc[2] + object -> at_pos[i].z;
     }
   }
 }
@@ -799,7 +801,7 @@ void rotate_this_object (project * this_proj, atomic_object * object, int axis,
     j = object -> at_list[i].id;
     if (! was_moved_atom[j])
     {
-      c_old = vec3(object -> at_list[i].x, object -> at_list[i].y, object -> at_list[i].z);
+      c_old = vec3(object -> at_pos[i].x, object -> at_pos[i].y, object -> at_pos[i].z);
       if (axis)
       {
         c_new = m4_mul_pos (this_proj -> modelgl -> view_matrix, c_old);
@@ -810,13 +812,13 @@ void rotate_this_object (project * this_proj, atomic_object * object, int axis,
       {
         c_new = m4_mul_pos (rot, c_old);
       }
-      object -> at_list[i].x = c_new.x;
-      object -> at_list[i].y = c_new.y;
-      object -> at_list[i].z = c_new.z;
+      object -> at_pos[i].x = c_new.x;
+      object -> at_pos[i].y = c_new.y;
+      object -> at_pos[i].z = c_new.z;
       c_old = v3_add (c_new, baryc);
-      this_proj -> atoms[0][j].x = c_old.x;
-      this_proj -> atoms[0][j].y = c_old.y;
-      this_proj -> atoms[0][j].z = c_old.z;
+      this_proj -> pos[0][0][j] = c_old.x;
+      this_proj -> pos[0][1][j] = c_old.y;
+      this_proj -> pos[0][2][j] = c_old.z;
       was_moved_atom[j] = TRUE;
     }
   }
@@ -909,6 +911,8 @@ void move_selection (project * this_proj, int action, int axis, vec3_t trans, fl
     {
       i = activep;
       active_project_changed (activep);
+      // Only the neighbors of the atom(s) that moved are computed again, if possible
+      active_project -> dmtx = update_distance_matrix ();
       bonds_update = 1;
       frag_update = (active_project -> natomes > ATOM_LIMIT) ? 0 : 1;
       mol_update = (frag_update) ? ((active_project -> steps > STEP_LIMIT) ? 0 : 1) : 0;
@@ -82,10 +82,10 @@ double get_object_dim (atomic_object * object)
   int i, j;
   for (i=0; i<object -> atoms-1; i++)
   {
-    at = vec3 (object -> at_list[i].x, object -> at_list[i].y, object -> at_list[i].z);
+    at = vec3 (object -> at_pos[i].x, object -> at_pos[i].y, object -> at_pos[i].z);
     for (j=i+1; j<object -> atoms; j++)
     {
-      bt = vec3 (object -> at_list[j].x, object -> at_list[j].y, object -> at_list[j].z);
+      bt = vec3 (object -> at_pos[j].x, object -> at_pos[j].y, object -> at_pos[j].z);
       dist = v3_sub(at, bt);
       dmax = max (dmax, v3_length(dist));
     }
@@ -108,18 +108,18 @@ void correct_pos_and_get_dim (atomic_object * object, gboolean adjust)
   object -> baryc = allocdouble(3);
   for (i=0; i<object -> atoms; i++)
   {
-    object -> baryc[0] += object -> at_list[i].x;
-    object -> baryc[1] += object -> at_list[i].y;
-    object -> baryc[2] += object -> at_list[i].z;
+    object -> baryc[0] += object -> at_pos[i].x;
+    object -> baryc[1] += object -> at_pos[i].y;
+    object -> baryc[2] += object -> at_pos[i].z;
   }
   for (i=0; i<3; i++) object -> baryc[i] /= object -> atoms;
   if (adjust)
   {
     for (i=0; i<object -> atoms; i++)
     {
-      object -> at_list[i].x -= object -> baryc[0];
-      object -> at_list[i].y -= object -> baryc[1];
-      object -> at_list[i].z -= object -> baryc[2];
+      object -> at_pos[i].x -= object -> baryc[0];
+      object -> at_pos[i].y -= object -> baryc[1];
+      object -> at_pos[i].z -= object -> baryc[2];
     }
   }
   object -> dim = get_object_dim (object);
@@ -135,7 +135,7 @@ void correct_pos_and_get_dim (atomic_object * object, gboolean adjust)
   \param object the target insert object
   \param target the target atom id to correct
   \param aid the atom id
-  \param at the target atom
+  \param at the target atom, 'object -> at_list[aid]'
   \param checked_at the list of already checked/corrected atom coordinates id
 */
 gboolean rebuild_atom_neighbors (project * this_proj, int step, atomic_object * object, int target, int aid, atom * at, gboolean * checked_at)
@@ -145,12 +145,12 @@ gboolean rebuild_atom_neighbors (project * this_proj, int step, atomic_object *
   for (i=0; i<at -> numv; i++)
   {
     j = at -> vois[i];
-    dist = distance_3d (& this_proj -> cell, step, at, & object -> at_list[j]);
+    dist = distance_3d (& this_proj -> cell, step, object -> at_pos[aid], object -> at_pos[j]);
     if (dist.pbc && ! checked_at[j])
     {
-      object -> at_list[j].x = at -> x - dist.x;
-      object -> at_list[j].y = at -> y - dist.y;
-      object -> at_list[j].z = at -> z - dist.z;
+      object -> at_pos[j].x = object -> at_pos[aid].x - dist.x;
+      object -> at_pos[j].y = object -> at_pos[aid].y - dist.y;
+      object -> at_pos[j].z = object -> at_pos[aid].z - dist.z;
     }
   }
   checked_at[aid] = TRUE;
@@ -304,9 +304,9 @@ void reconstruct_coordinates_for_object (project * this_proj, atomic_object * th
     for (i=0; i<this_object -> atoms; i++)
     {
       j = this_object -> at_list[i].id;
-      this_proj -> atoms[0][j].x = this_object -> at_list[i].x + this_object -> baryc[0];
-      this_proj -> atoms[0][j].y = this_object -> at_list[i].y + this_object -> baryc[1];
-      this_proj -> atoms[0][j].z = this_object -> at_list[i].z + this_object -> baryc[2];
+      this_proj -> pos[0][0][j] = this_object -> at_pos[i].x + this_object -> baryc[0];
+      this_proj -> pos[0][1][j] = this_object -> at_pos[i].y + this_object -> baryc[1];
+      this_proj -> pos[0][2][j] = this_object -> at_pos[i].z + this_object -> baryc[2];
       this_proj -> atoms[0][j].cloned = FALSE;
     }
     for (i=0; i<3; i++) this_proj -> modelgl -> saved_coord[i] = save_coordinates (this_proj, i);
@@ -387,10 +387,12 @@ atomic_object * duplicate_atomic_object (atomic_object * old_obj)
   new_obj -> name = g_strdup_printf ("%s", old_obj -> name);
   new_obj -> atoms = old_obj -> atoms;
   new_obj -> at_list = g_malloc0 (new_obj -> atoms*sizeof*new_obj -> at_list);
+  new_obj -> at_pos = g_malloc0 (new_obj -> atoms*sizeof*new_obj -> at_pos);
   int i;
   for (i=0; i<new_obj -> atoms; i++)
   {
     new_obj -> at_list[i] = * duplicate_atom (& old_obj -> at_list[i]);
+    new_obj -> at_pos[i] = old_obj -> at_pos[i];
   }
   new_obj -> old_z = duplicate_int (old_obj -> species, old_obj -> old_z);
   new_obj -> coord = duplicate_coord_info (old_obj -> coord);
@@ -430,6 +432,7 @@ void create_object_from_library (int p)
   lib_object -> coord = duplicate_coord_info (other_proj -> coord);
   lib_object -> atoms = i;
   lib_object -> at_list = g_malloc0 (lib_object -> atoms*sizeof*lib_object -> at_list);
+  lib_object -> at_pos = g_malloc0 (lib_object -> atoms*sizeof*lib_object -> at_pos);
   lib_object -> occ = 1.0;
   lib_object -> species = other_proj -> nspec;
   lib_object -> old_z = allocint (other_proj -> nspec);
@@ -437,6 +440,7 @@ void create_object_from_library (int p)
   for (j=0; j<i; j++)
   {
     lib_object -> at_list[j] = * duplicate_atom (& other_proj -> atoms[0][j]);
+    lib_object -> at_pos[j] = get_atom_pos (other_proj, 0, j);
   }
   correct_pos_and_get_dim (lib_object, TRUE);
   if (other_proj -> modelgl -> bonds[0][0])
@@ -624,6 +628,7 @@ void add_object_atoms (atomic_object * this_object, project * this_proj,
   int i, j;
   this_object -> atoms = numa;
   this_object -> at_list = g_malloc0 (this_object -> atoms*sizeof*this_object -> at_list);
+  this_object -> at_pos = g_malloc0 (this_object -> atoms*sizeof*this_object -> at_pos);
   int * new_id = allocint (this_proj -> natomes);
   for (i=0; i<this_object -> atoms; i++)
   {
@@ -631,6 +636,7 @@ void add_object_atoms (atomic_object * this_object, project * this_proj,
     new_id[j] = i+1;
     if (remove) remove -> todo[j] = 1;
     this_object -> at_list[i] = * duplicate_atom (& this_proj -> atoms[o_step][j]);
+    this_object -> at_pos[i] = get_atom_pos (this_proj, o_step, j);
     if (i)
     {
       this_object -> at_list[i].prev = & this_object -> at_list[i-1];
@@ -805,11 +811,13 @@ atomic_object * create_object_from_atom_coordination (project * this_proj, int c
   this_object -> origin = this_proj -> id;
   this_object -> atoms = i+1;
   this_object -> at_list = g_malloc0 (this_object -> atoms*sizeof*this_object -> at_list);
+  this_object -> at_pos = g_malloc0 (this_object -> atoms*sizeof*this_object -> at_pos);
   this_object -> occ = 1.0;
   this_object -> coord = duplicate_coord_info (this_proj -> coord);
   this_object -> species = this_proj -> nspec;
   this_object -> old_z = duplicate_int (this_proj -> nspec, (int *)this_proj -> chemistry -> chem_prop[CHEM_Z]);
   this_object -> at_list[0] = * duplicate_atom (& this_proj -> atoms[o_step][aid]);
+  this_object -> at_pos[0] = get_atom_pos (this_proj, o_step, aid);
   if (remove) remove_search -> todo[aid] = 1;
   gboolean movtion = (object_motion && this_proj -> modelgl -> rebuild[0][0]) || (! object_motion && this_proj -> modelgl -> rebuild[1][0]);
   if (this_proj -> atoms[o_step][aid].numv)
@@ -823,6 +831,7 @@ atomic_object * create_object_from_atom_coordination (project * this_proj, int c
       if (remove) remove_search -> todo[j] = 1;
       new_id[j] = i+2;
       this_object -> at_list[i+1] = * duplicate_atom (& this_proj -> atoms[o_step][j]);
+      this_object -> at_pos[i+1] = get_atom_pos (this_proj, o_step, j);
     }
     clean_object_bonds (this_proj, o_step, this_object, new_id, movtion);
     if (new_id)
@@ -1038,6 +1047,7 @@ int create_object_from_open_project (project * this_proj, int p)
   lib_object -> origin = p;
   lib_object -> atoms = i;
   lib_object -> at_list = g_malloc0 (lib_object -> atoms*sizeof*lib_object -> at_list);
+  lib_object -> at_pos = g_malloc0 (lib_object -> atoms*sizeof*lib_object -> at_pos);
   lib_object -> occ = 1.0;
   lib_object -> coord = duplicate_coord_info (other_proj -> coord);
   lib_object -> species = other_proj -> nspec;
@@ -1050,6 +1060,7 @@ int create_object_from_open_project (project * this_proj, int p)
     for (j=0; j<i; j++)
     {
       lib_object -> at_list[j] = * duplicate_atom (& other_proj -> atoms[o_step][j]);
+      lib_object -> at_pos[j] = get_atom_pos (other_proj, o_step, j);
       new_id[j] = j+1;
       if (j)
       {
@@ -1066,6 +1077,7 @@ int create_object_from_open_project (project * this_proj, int p)
       if (other_proj -> atoms[o_step][j].pick[0] == this_proj -> modelgl -> other_status)
       {
         lib_object -> at_list[i] = * duplicate_atom (& other_proj -> atoms[o_step][j]);
+        lib_object -> at_pos[i] = get_atom_pos (other_proj, o_step, j);
         new_id[j] = i+1;
         if (i)
         {
@@ -1119,6 +1131,7 @@ void clean_this_object (int orig, int act, project * this_proj, atom_search * as
       if (object -> ibonds) g_free (object -> ibonds);
       if (object -> baryc) g_free (object -> baryc);
       if (object -> at_list) g_free (object -> at_list);
+      if (object -> at_pos) g_free (object -> at_pos);
       if (object -> coord) g_free (object -> coord);
       object -> atoms = object -> bonds = 0;
       asearch -> in_selection --;
@@ -1274,7 +1287,7 @@ void to_insert_in_project (int stat, int orig, project * this_proj, atom_search
       }
       else if (orig > -1)
       {
-        coor_ins = vec3 (this_proj -> atoms[0][orig].x, this_proj -> atoms[0][orig].y, this_proj -> atoms[0][orig].z);
+        coor_ins = vec3 (this_proj -> pos[0][0][orig], this_proj -> pos[0][1][orig], this_proj -> pos[0][2][orig]);
       }
     }
   }
@@ -1285,6 +1298,7 @@ void to_insert_in_project (int stat, int orig, project * this_proj, atom_search
     lib_object -> old_z = allocint (1);
     lib_object -> old_z[0] = (stat < 119) ? stat : 0.0;
     lib_object -> at_list = g_malloc0(sizeof*lib_object -> at_list);
+    lib_object -> at_pos = g_malloc0(sizeof*lib_object -> at_pos);
     lib_object -> coord = g_malloc0 (sizeof*lib_object -> coord);
     lib_object -> coord -> species = 1;
     for (j=0; j<2; j++)
@@ -1357,9 +1371,9 @@ void to_insert_in_project (int stat, int orig, project * this_proj, atom_search
 
   for (i=0; i<object -> atoms; i++)
   {
-    object -> at_list[i].x += coor_ins.x + object -> dim*ulam.a;
-    object -> at_list[i].y += coor_ins.y + object -> dim*ulam.b;
-    object -> at_list[i].z += coor_ins.z + object -> dim*ulam.c;
+    object -> at_pos[i].x += coor_ins.x + object -> dim*ulam.a;
+    object -> at_pos[i].y += coor_ins.y + object -> dim*ulam.b;
+    object -> at_pos[i].z += coor_ins.z + object -> dim*ulam.c;
   }
   asearch -> in_selection ++;
 
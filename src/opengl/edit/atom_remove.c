@@ -508,7 +508,7 @@ gboolean * remove_bonds_from_project (project * this_proj, atomic_object * this_
             {
               l = this_proj -> modelgl -> bondid[0][i][k][0];
               m = this_proj -> modelgl -> bondid[0][i][k][1];
-              clo = distance_3d (& this_proj -> cell, 0, & this_proj -> atoms[0][l], & this_proj -> atoms[0][m]);
+              clo = distance_3d (& this_proj -> cell, 0, get_atom_pos (this_proj, 0, l), get_atom_pos (this_proj, 0, m));
               this_proj -> modelgl -> clones[0][k].x = clo.x;
               this_proj -> modelgl -> clones[0][k].y = clo.y;
               this_proj -> modelgl -> clones[0][k].z = clo.z;
@@ -617,9 +617,9 @@ void to_remove_this_list_of_objects (project * this_proj, atom_search * asearch)
         {
           tmp_object = g_malloc0(sizeof*tmp_object);
           tmp_object -> baryc = allocdouble (3);
-          tmp_object -> baryc[0] = this_proj -> atoms[0][i].x;
-          tmp_object -> baryc[1] = this_proj -> atoms[0][i].y;
-          tmp_object -> baryc[2] = this_proj -> atoms[0][i].z;
+          tmp_object -> baryc[0] = this_proj -> pos[0][0][i];
+          tmp_object -> baryc[1] = this_proj -> pos[0][1][i];
+          tmp_object -> baryc[2] = this_proj -> pos[0][2][i];
         }
       }
       if (asearch -> action == REPLACE)
@@ -1181,9 +1181,9 @@ int build_crystal (gboolean visible, project * this_proj, int c_step, gboolean t
           for (l=0; l<object -> atoms; l++)
           {
             n = object -> at_list[l].sp;
-            cdata -> position[i][l].x = object -> at_list[l].x;
-            cdata -> position[i][l].y = object -> at_list[l].y;
-            cdata -> position[i][l].z = object -> at_list[l].z;
+            cdata -> position[i][l].x = object -> at_pos[l].x;
+            cdata -> position[i][l].y = object -> at_pos[l].y;
+            cdata -> position[i][l].z = object -> at_pos[l].z;
             if (! cdata -> holes[i])
             {
               for (o=0; o<k; o++)
@@ -1453,7 +1453,7 @@ int build_crystal (gboolean visible, project * this_proj, int c_step, gboolean t
   }
   cdata = free_crystal_data (cdata);
   gboolean low_occ = adjust_object_occupancy (cryst, occupying, rounding, tot_cell);
-  atom at, bt;
+  atom_pos at, bt;
   distance dist;
 
   if (! cryst -> overlapping)
@@ -1479,7 +1479,7 @@ int build_crystal (gboolean visible, project * this_proj, int c_step, gboolean t
                   bt.x = cryst -> coord[k][m].x;
                   bt.y = cryst -> coord[k][m].y;
                   bt.z = cryst -> coord[k][m].z;
-                  dist = distance_3d (active_cell, 0, & at, & bt);
+                  dist = distance_3d (active_cell, 0, at, bt);
                   if (dist.length < 0.5)
                   {
                     // g_print ("i= %d, j= %d, k= %d, m= %d, d= %f\n", i, j, k, m, dist.length);
@@ -1656,9 +1656,9 @@ int build_crystal (gboolean visible, project * this_proj, int c_step, gboolean t
     active_project -> atoms[c_step][i].id = i;
     j = tot_new_lot[i];
     active_project -> atoms[c_step][i].sp =  j;
-    active_project -> atoms[c_step][i].x = ncc[i].x + copos[0];
-    active_project -> atoms[c_step][i].y = ncc[i].y + copos[1];
-    active_project -> atoms[c_step][i].z = ncc[i].z + copos[2];
+    active_project -> pos[c_step][0][i] = ncc[i].x + copos[0];
+    active_project -> pos[c_step][1][i] = ncc[i].y + copos[1];
+    active_project -> pos[c_step][2][i] = ncc[i].z + copos[2];
     active_project -> atoms[c_step][i].show[0] = TRUE;
     active_project -> atoms[c_step][i].show[1] = TRUE;
     active_project -> atoms[c_step][i].label[0] = FALSE;
@@ -414,9 +414,9 @@ void invert_selection (project * this_proj)
         if (! this_proj -> atoms[0][j].pick[0])
         {
           saved_c[k] = allocdouble (3);
-          saved_c[k][0] = this_proj -> atoms[0][j].x;
-          saved_c[k][1] = this_proj -> atoms[0][j].y;
-          saved_c[k][2] = this_proj -> atoms[0][j].z;
+          saved_c[k][0] = this_proj -> pos[0][0][j];
+          saved_c[k][1] = this_proj -> pos[0][1][j];
+          saved_c[k][2] = this_proj -> pos[0][2][j];
           k ++;
         }
       }
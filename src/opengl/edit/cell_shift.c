@@ -85,7 +85,7 @@ void modify_coordinates_in_lattice (project * this_proj, mat4_t * dlat, mat4_t *
   {
     for (j=0; j<this_proj -> natomes; j++)
     {
-      pos = vec3(this_proj -> atoms[i][j].x, this_proj -> atoms[i][j].y, this_proj -> atoms[i][j].z);
+      pos = vec3(this_proj -> pos[i][0][j], this_proj -> pos[i][1][j], this_proj -> pos[i][2][j]);
       if (density)
       {
         res = m4_mul_pos(*drec, pos);
@@ -114,9 +114,9 @@ void modify_coordinates_in_lattice (project * this_proj, mat4_t * dlat, mat4_t *
         res.z -= (int)(res.z/0.5);
         pos = m4_mul_pos(lat, res);
       }
-      this_proj -> atoms[i][j].x = pos.x;
-      this_proj -> atoms[i][j].y = pos.y;
-      this_proj -> atoms[i][j].z = pos.z;
+      this_proj -> pos[i][0][j] = pos.x;
+      this_proj -> pos[i][1][j] = pos.y;
+      this_proj -> pos[i][2][j] = pos.z;
     }
     if (density)
     {
@@ -234,9 +234,9 @@ void super_celling (glwin * view)
         {
           for (j=0; j<active_project -> natomes; j++)
           {
-            active_project -> atoms[i][j].x += shift.x;
-            active_project -> atoms[i][j].y += shift.y;
-            active_project -> atoms[i][j].z += shift.z;
+            active_project -> pos[i][0][j] += shift.x/2.0;
+            active_project -> pos[i][1][j] += shift.y/2.0;
+            active_project -> pos[i][2][j] += shift.z/2.0;
           }
         }
       }
@@ -268,9 +268,9 @@ void super_celling (glwin * view)
         {
           for (j=0; j<active_project -> natomes; j++)
           {
-            active_project -> atoms[i][j].x -= shift.x/2.0;
-            active_project -> atoms[i][j].y -= shift.y/2.0;
-            active_project -> atoms[i][j].z -= shift.z/2.0;
+            active_project -> pos[i][0][j] -= shift.x/2.0;
+            active_project -> pos[i][1][j] -= shift.y/2.0;
+            active_project -> pos[i][2][j] -= shift.z/2.0;
           }
         }
       }
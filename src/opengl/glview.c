@@ -50,9 +50,14 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
   void update_bonds_ (int * bd, int * stp,
                       int * bdim, int bda[* bdim], int bdb[* bdim],
                       double * x, double * y, double * z);
+  void patch_bonds_ (int * stp, int * nchg, int chg[* nchg],
+                     int * bdim, int bda[* bdim], int bdb[* bdim],
+                     int * cdim, int cla[* cdim], int clb[* cdim],
+                     double * x, double * y, double * z);
   void sort (int dim, int * tab);
-  void update_atom_neighbors_ (int * stp, int * at, int * nv);
-  void update_this_neighbor_ (int * stp, int * at, int * iv, int * nv);
+  void free_step_neighbors (project * this_proj, int stp);
+  void free_neighbor_lists (project * this_proj);
+  void update_step_neighbors_ (int * stp, int * nat, int * maxn, int contj[* nat], int voisj[* nat * * maxn]);
   void update (glwin * view);
   void transform (glwin * view, double aspect);
   void reshape (glwin * view, int width, int height, gboolean use_ratio);
@@ -373,13 +378,99 @@ void update_bonds_ (int * bd, int * stp,
         active_glwin -> clones[* stp][i].z = z[i];
         j = bda[i] - 1;
         k = bdb[i] - 1;
-        active_project -> atoms[* stp][j].cloned = TRUE;
-        active_project -> atoms[* stp][k].cloned = TRUE;
+        set_step_clone (active_project, * stp, j, TRUE);
+        set_step_clone (active_project, * stp, k, TRUE);
       }
     }
   }
 }
 
+/*!
+  \fn void patch_bonds_ (int * stp, int * nchg, int chg[* nchg],
+                         int * bdim, int bda[* bdim], int bdb[* bdim],
+                         int * cdim, int cla[* cdim], int clb[* cdim],
+                         double * x, double * y, double * z)
+
+  \brief update bonding information from Fortran90 after some atom(s) moved:
+  the bond(s) of these atom(s) are replaced by the new one(s), the other bond(s) are kept
+
+  \param stp the MD step
+  \param nchg number of atom(s) that moved
+  \param chg the atom(s) that moved, Fortran ids
+  \param bdim number of new bond(s)
+  \param bda new bond "ab" list atom a
+  \param bdb new bond "ab" list atom b
+  \param cdim number of new clone bond(s)
+  \param cla new clone bond "ab" list atom a
+  \param clb new clone bond "ab" list atom b
+  \param x new clone(s) x coordinates
+  \param y new clone(s) y coordinates
+  \param z new clone(s) z coordinates
+*/
+void patch_bonds_ (int * stp, int * nchg, int chg[* nchg],
+                   int * bdim, int bda[* bdim], int bdb[* bdim],
+                   int * cdim, int cla[* cdim], int clb[* cdim],
+                   double * x, double * y, double * z)
+{
+  int i, j, k, l, m;
+  int ** bid;
+  vec3_t * clo;
+  gboolean * moved = allocbool (active_project -> natomes);
+  for (i=0; i<* nchg; i++) moved[chg[i]-1] = TRUE;
+  for (i=0; i<2; i++)
+  {
+    j = active_glwin -> bonds[* stp][i];
+    k = (i) ? * cdim : * bdim;
+    l = 0;
+    for (m=0; m<j; m++)
+    {
+      if (! moved[active_glwin -> bondid[* stp][i][m][0]] && ! moved[active_glwin -> bondid[* stp][i][m][1]]) l ++;
+    }
+    bid = (l+k) ? allocdint (l+k, 2) : NULL;
+    clo = (i && l+k) ? g_malloc0 ((l+k)*sizeof*clo) : NULL;
+    l = 0;
+    for (m=0; m<j; m++)
+    {
+      if (! moved[active_glwin -> bondid[* stp][i][m][0]] && ! moved[active_glwin -> bondid[* stp][i][m][1]])
+      {
+        bid[l][0] = active_glwin -> bondid[* stp][i][m][0];
+        bid[l][1] = active_glwin -> bondid[* stp][i][m][1];
+        if (i) clo[l] = active_glwin -> clones[* stp][m];
+        l ++;
+      }
+      g_free (active_glwin -> bondid[* stp][i][m]);
+    }
+    for (m=0; m<k; m++)
+    {
+      bid[l][0] = ((i) ? cla[m] : bda[m]) - 1;
+      bid[l][1] = ((i) ? clb[m] : bdb[m]) - 1;
+      if (i)
+      {
+        clo[l].x = x[m];
+        clo[l].y = y[m];
+        clo[l].z = z[m];
+      }
+      l ++;
+    }
+    if (active_glwin -> bondid[* stp][i]) g_free (active_glwin -> bondid[* stp][i]);
+    active_glwin -> bondid[* stp][i] = bid;
+    if (i)
+    {
+      if (active_glwin -> clones[* stp]) g_free (active_glwin -> clones[* stp]);
+      active_glwin -> clones[* stp] = clo;
+    }
+    active_glwin -> allbonds[i] += l - j;
+    active_glwin -> bonds[* stp][i] = l;
+  }
+  for (i=0; i<active_project -> natomes; i++) set_step_clone (active_project, * stp, i, FALSE);
+  for (i=0; i<active_glwin -> bonds[* stp][1]; i++)
+  {
+    set_step_clone (active_project, * stp, active_glwin -> bondid[* stp][1][i][0], TRUE);
+    set_step_clone (active_project, * stp, active_glwin -> bondid[* stp][1][i][1], TRUE);
+  }
+  g_free (moved);
+}
+
 /*!
   \fn void sort (int dim, int * tab)
 
@@ -404,40 +495,96 @@ void sort (int dim, int * tab)
 }
 
 /*!
-  \fn void update_atom_neighbors_ (int * stp, int * at, int * nv)
+  \fn void free_step_neighbors (project * this_proj, int stp)
 
-  \brief update an atom number of neighbors from Fortran90
+  \brief free the neighbor lists of an MD step
 
+  \param this_proj the target project
   \param stp the MD step
-  \param at atom id
-  \param nv number of neighbor atom(s)
 */
-void update_atom_neighbors_ (int * stp, int * at, int * nv)
+void free_step_neighbors (project * this_proj, int stp)
 {
-  active_project -> atoms[* stp][* at].numv = * nv;
-  if (* nv)
+  int i;
+  gboolean csr = (this_proj -> vois_csr && stp < this_proj -> csr_steps && this_proj -> vois_csr[stp]) ? TRUE : FALSE;
+  // The atoms shared by all MD steps only point in the lists of the active MD step, see 'pos_window.c'
+  gboolean in_atoms = (! this_proj -> pos_win || this_proj -> pos_win -> active == stp) ? TRUE : FALSE;
+  for (i=0; i<this_proj -> natomes && in_atoms; i++)
+  {
+    if (! csr && ! this_proj -> pos_win)
+    {
+      if (this_proj -> atoms[stp][i].vois) g_free (this_proj -> atoms[stp][i].vois);
+    }
+    this_proj -> atoms[stp][i].vois = NULL;
+    this_proj -> atoms[stp][i].numv = 0;
+  }
+  if (this_proj -> pos_win && in_atoms) this_proj -> pos_win -> active = -1;
+  if (csr)
   {
-    active_project -> atoms[* stp][* at].vois = allocint(* nv);
+    g_free (this_proj -> vois_csr[stp]);
+    this_proj -> vois_csr[stp] = NULL;
   }
 }
 
 /*!
-  \fn void update_this_neighbor_ (int * stp, int * at, int * iv, int * nv)
+  \fn void free_neighbor_lists (project * this_proj)
 
-  \brief update atom neighbor list from Fortran90
+  \brief free the CSR neighbor lists of all MD steps,
+  the atoms must not point in them anymore
+
+  \param this_proj the target project
+*/
+void free_neighbor_lists (project * this_proj)
+{
+  int i;
+  if (this_proj -> vois_csr)
+  {
+    for (i=0; i<this_proj -> csr_steps; i++)
+    {
+      if (this_proj -> vois_csr[i]) g_free (this_proj -> vois_csr[i]);
+    }
+    g_free (this_proj -> vois_csr);
+    this_proj -> vois_csr = NULL;
+  }
+  this_proj -> csr_steps = 0;
+}
+
+/*!
+  \fn void update_step_neighbors_ (int * stp, int * nat, int * maxn, int contj[* nat], int voisj[* nat * * maxn])
+
+  \brief update the neighbor lists of all atoms for an MD step from Fortran90
 
   \param stp the MD step
-  \param at atom id
-  \param iv neighbor index
-  \param nv neighbor id
+  \param nat the number of atoms
+  \param maxn the maximum number of neighbors
+  \param contj the number of neighbors of each atom
+  \param voisj the neighbors of each atom, 'maxn' values per atom, Fortran ids
 */
-void update_this_neighbor_ (int * stp, int * at, int * iv, int * nv)
+void update_step_neighbors_ (int * stp, int * nat, int * maxn, int contj[* nat], int voisj[* nat * * maxn])
 {
-  active_project -> atoms[* stp][* at].vois[* iv] = * nv - 1;
-  if (* iv == active_project -> atoms[* stp][* at].numv - 1)
+  int i, j, k;
+  int * csr;
+  // Previous lists, if any, after an incremental update of the distance matrix
+  free_step_neighbors (active_project, * stp);
+  k = * nat + 1;
+  for (i=0; i<* nat; i++) k += contj[i];
+  // One block per step: offsets then neighbor ids, the atom lists are views in it
+  csr = allocint (k);
+  active_project -> vois_csr[* stp] = csr;
+  k = * nat + 1;
+  for (i=0; i<* nat; i++)
   {
-    sort (active_project -> atoms[* stp][* at].numv, active_project -> atoms[* stp][* at].vois);
+    csr[i] = k;
+    for (j=0; j<contj[i]; j++) csr[k+j] = voisj[i * * maxn + j] - 1;
+    sort (contj[i], & csr[k]);
+    // Otherwise loaded in the atoms when the MD step is used, see 'use_pos_step'
+    if (! active_project -> pos_win)
+    {
+      active_project -> atoms[* stp][i].numv = contj[i];
+      active_project -> atoms[* stp][i].vois = (contj[i]) ? & csr[k] : NULL;
+    }
+    k += contj[i];
   }
+  csr[* nat] = k;
 }
 
 /*!
@@ -449,6 +596,8 @@ void update_this_neighbor_ (int * stp, int * at, int * iv, int * nv)
 */
 void update (glwin * view)
 {
+  // No widget to render when drawing in batch mode
+  if (! view -> plot) return;
   gtk_gl_area_queue_render ((GtkGLArea *)view -> plot);
 #ifdef G_OS_WIN32
 #ifdef GTK3
@@ -1502,18 +1651,18 @@ void center_molecule (project * this_proj)
     z = 0.0;
     for (i = 0; i < this_proj -> natomes; i++)
     {
-      x += this_proj -> atoms[l][i].x;
-      y += this_proj -> atoms[l][i].y;
-      z += this_proj -> atoms[l][i].z;
+      x += this_proj -> pos[l][0][i];
+      y += this_proj -> pos[l][1][i];
+      z += this_proj -> pos[l][2][i];
     }
     x /= this_proj -> natomes;
     y /= this_proj -> natomes;
     z /= this_proj -> natomes;
     for (i = 0; i < this_proj -> natomes; i++)
     {
-      this_proj -> atoms[l][i].x -= x;
-      this_proj -> atoms[l][i].y -= y;
-      this_proj -> atoms[l][i].z -= z;
+      this_proj -> pos[l][0][i] -= x;
+      this_proj -> pos[l][1][i] -= y;
+      this_proj -> pos[l][2][i] -= z;
     }
 
     for (i=0; i<FILLED_STYLES; i++)
@@ -142,6 +142,22 @@ extern GLfloat template_parameters[TEMPLATES][5];
   \brief Maximum number of atoms in selection to display measure information
 */
 #define MAX_IN_SELECTION 21
+
+/*! \def IMPOSTOR_INDICES
+  \brief Number of mesh indices to render, above which spheres and cylinders are ray cast impostors
+*/
+#define IMPOSTOR_INDICES 50000000
+
+/*! \def PICK_AREA
+  \brief Size, in pixels, of the square around the pointer rendered for picking
+*/
+#define PICK_AREA 5
+
+/*! \def PICK_MAX
+  \brief Maximum number of pickable objects, the pick id is encoded in the RGB color
+*/
+#define PICK_MAX 16777215
+
 /*! \def COORD_MAX_MENU
   \brief Maximum number of fragments or molecules to build the related menu items
 */
@@ -266,7 +282,7 @@ extern int qual;
 extern int acolorm;
 extern int pcolorm;
 extern int step;
-extern int gColorID[3];
+extern int pick_id;
 extern int field_object;
 extern GLenum ogl_texture;
 
@@ -284,13 +300,16 @@ extern void draw_box ();
 extern void prepare_cuboid (vec3_t position, int id);
 extern void prepare_axis ();
 extern void draw (glwin * view);
+extern int string_shaders (int id);
 extern void render_all_strings (int glsl, int id);
 extern void prepare_string (char * text, int id, ColRGBA col, vec3_t pos, float lshift[3],
-                            atom * at, atom * bt, atom * ct);
+                            atom_pos * at, atom_pos * bt, atom_pos * ct);
 
 ColRGBA init_color (int id, int numid);
 ColRGBA set_default_color (int z);
 extern void sort (int dim, int * tab);
+extern void free_step_neighbors (project * this_proj, int stp);
+extern void free_neighbor_lists (project * this_proj);
 extern vec3_t get_insertion_coordinates (glwin * view);
 void setup_bonds (glwin * view);
 void update (glwin * view);
@@ -325,15 +344,27 @@ void init_camera (project * this_proj, gboolean get_depth);
 
 extern void debug_image (image img, int i);
 
-extern distance distance_2d (atom * at, atom * bt);
-extern distance distance_3d (cell_info * cell, int mdstep, atom * at, atom * bt);
-extern angle angle_2d (atom * at, atom * bt, atom * ct);
-extern angle angle_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct);
-extern angle dihedral_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct, atom * dt);
+extern distance distance_2d (atom_pos at, atom_pos bt);
+extern distance distance_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt);
+extern angle angle_2d (atom_pos at, atom_pos bt, atom_pos ct);
+extern angle angle_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt, atom_pos ct);
+extern angle dihedral_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt, atom_pos ct, atom_pos dt);
+
+typedef struct gl_atom gl_atom;
+struct gl_atom
+{
+  double x, y, z;
+  int sp;
+  int id;
+  int style;
+  gboolean show[2];
+  gboolean pick[2];
+};
 
 extern atom * duplicate_atom (atom * at);
-extern void at_shift (atom * at, float * shift);
-extern void at_unshift (atom * at, float * shift);
+extern void gl_atom_view (gl_atom * va, atom * at);
+extern void at_shift (atom_pos * at, float * shift);
+extern void at_unshift (atom_pos * at, float * shift);
 extern int check_label_numbers (project * this_proj, int types);
 
 extern mat4_t create_axis_matrices (int type);
@@ -343,6 +374,17 @@ extern int nbs, nbl, nba;
 extern void re_create_all_md_shaders (glwin * view);
 extern void re_create_md_shaders (int nshaders, int shaders[nshaders], project * this_proj);
 extern void cleaning_shaders (glwin * view, int shader);
+extern void free_poly_hulls (glwin * view);
+extern void update_atom_instances (glsl_program * glsl, float * instances);
+extern void update_pair_instances (glsl_program * glsl, float * instances);
+extern void free_glsl_program (glsl_program * glsl);
+extern const GLchar * impostor_color ();
+extern void glsl_set_impostor (glsl_program * glsl);
+extern void glsl_sort_instances (glsl_program * glsl);
+extern void glsl_cell_bounds (glsl_program * glsl);
+extern void glsl_draw_visible_cells (glsl_program * glsl, int vertices);
+extern gboolean use_impostors (int instances, int indices);
+extern object_3d * draw_impostor_box ();
 extern void init_default_shaders (glwin * view);
 extern void init_shaders(glwin * view);
 
@@ -268,6 +268,41 @@ struct screen_label
   ColRGBA * color;
   double shift[3];
   screen_string * list;
+  GHashTable * words;             /*!< The screen strings of the list, by text */
+};
+
+/*! \typedef glyph_atlas
+
+  \brief OpenGL string rendering: the characters of a font, rendered once then packed in texture(s)
+*/
+typedef struct glyph_atlas glyph_atlas;
+struct glyph_atlas
+{
+  gchar * font;                   /*!< The font description */
+  int size;                       /*!< The absolute font size, in Pango units */
+  int render;                     /*!< The rendering mode: 0 = normal, 1 = with outline */
+  int width;                      /*!< Width of the atlas, in pixels */
+  int height;                     /*!< Height of the atlas, in pixels */
+  int pen[3];                     /*!< Next free spot in the atlas: x, y, then height of the current row */
+  GLubyte * pixels[2];            /*!< The atlas data: the glyphs, then their outline if any */
+  GLuint texture[2];              /*!< The atlas texture(s): the glyphs, then their outline if any */
+  gboolean update;                /*!< The atlas data was modified since the last texture upload */
+  GHashTable * glyphs;            /*!< The glyphs already in the atlas, by character */
+  glyph_atlas * next;
+};
+
+/*! \typedef poly_hull
+
+  \brief the faces of the coordination polyhedron of an atom: the convex hull of its neighbors
+*/
+typedef struct poly_hull poly_hull;
+struct poly_hull
+{
+  int summits;                    /*!< Number of summits, 0 if not computed yet */
+  gboolean clones;                /*!< Some summits are periodic images of the neighbors */
+  float * xyz;                    /*!< Coordinates of the summits, used to check that the hull is up to date */
+  int triangles;                  /*!< Number of triangles */
+  int * faces;                    /*!< Summits of each triangle */
 };
 
 typedef struct atom_in_selection atom_in_selection;
@@ -610,6 +645,7 @@ struct atomic_object
   int species;                  /*!< Number of chemical species */
   int * old_z;                  /*!< Temporary buffer to preserve the atomic numbers */
   struct atom * at_list;        /*!< List of atom(s) in the object */
+  struct atom_pos * at_pos;     /*!< Coordinates of the atom(s) in the object */
   int ifcl;                     /*!< Number of clone(s), if any */
   int * bcid;                   /*!< Cloned bonds ID */
   double occ;                   /*!< Occupancy (for crystal building purposes) */
@@ -1020,6 +1056,18 @@ struct glwin
   gboolean create_shaders[NGLOBAL_SHADERS];
   glsl_program *** ogl_glsl[NGLOBAL_SHADERS];
   int * n_shaders[NGLOBAL_SHADERS];
+  int atom_stream_step;                     /*!< MD step that holds the atom shaders, reused for any other MD step, -1 if none */
+  int atom_stream_shaders;                  /*!< Number of atom shaders in that set */
+  int atom_stream_key[3];                   /*!< Quality, number of lights and style used to build that set */
+  int bond_stream_step;                     /*!< MD step that holds the bond shaders built from atom pairs, reused for any other MD step, -1 if none */
+  int bond_stream_shaders;                  /*!< Number of bond shaders in that set */
+  int bond_stream_key[3];                   /*!< Quality, number of lights and style used to build that set */
+  GLuint atom_positions[2];                 /*!< Atom position buffer, and its texture, read by the bond shaders built from atom pairs, 0 if none */
+  glyph_atlas * atlas;                      /*!< The glyph atlases used to render the labels, most recently used first */
+  glyph_atlas * label_atlas[5];             /*!< The glyph atlas in use for each label list */
+  int poly_hull_atoms;                      /*!< Number of atoms when the coordination polyhedra were cached */
+  int poly_hull_steps;                      /*!< Number of MD steps when the coordination polyhedra were cached */
+  poly_hull ** poly_hulls;                  /*!< The coordination polyhedron of each atom, for each MD step, NULL if none */
   opengl_edition * opengl_win;
   model_edition * model_win[2];
   builder_edition * builder_win;
@@ -1150,12 +1198,13 @@ struct glwin
   int labelled;
   int picked;
 
-  // Color picking
-  int to_be_picked;                          /*!< Total number of objects that can be picked */
-  int atoms_to_be_picked;                    /*!< Number of atoms that can be picked */
-  int clones_to_be_picked;                   /*!< Number of clones that can be picked */
-  int bonds_to_be_picked;                    /*!< Number of bonds that can be picked (do not include clones) */
-  int * color_to_pick;                       /*!< The different colors that can be picked */
+  // Color picking, the pick id of an object is its position in the following ranges:
+  // atoms [0, atoms_to_be_picked[, clones [atoms_to_be_picked, clones_to_be_picked[,
+  // bond halves [clones_to_be_picked, bonds_to_be_picked[, clone bond halves [bonds_to_be_picked, to_be_picked[
+  int to_be_picked;                          /*!< End of the clone bonds pick id range, total number of pick ids */
+  int atoms_to_be_picked;                    /*!< End of the atoms pick id range: 1 id per atom */
+  int clones_to_be_picked;                   /*!< End of the clones pick id range: 2 ids per clone bond */
+  int bonds_to_be_picked;                    /*!< End of the bonds pick id range: 2 ids per bond (do not include clones) */
 
   // Spinner, player
   sequencer * player;
@@ -38,8 +38,9 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
   void duplicate_material_and_lightning (image * new_img, image * old_img);
   void duplicate_screen_label (screen_label * new_lab, screen_label * old_lab);
   void add_image ();
-  void at_shift (atom * at, float * shift);
-  void at_unshift (atom * at, float * shift);
+  void at_shift (atom_pos * at, float * shift);
+  void at_unshift (atom_pos * at, float * shift);
+  void gl_atom_view (gl_atom * va, atom * at);
   void draw (glwin * view);
 
   screen_string * duplicate_screen_string (screen_string * old_s);
@@ -80,6 +81,7 @@ extern int create_selection_lists ();
 extern void create_poly_lists ();
 extern void create_ring_lists ();
 extern int create_box_lists (int b_step);
+extern void use_pos_step (project * this_proj, int step);
 extern int create_axis_lists ();
 extern int create_pick_lists ();
 extern int create_label_lists ();
@@ -253,6 +255,7 @@ void duplicate_screen_label (screen_label * new_lab, screen_label * old_lab)
     new_lab -> color = duplicate_color (new_lab -> n_colors, old_lab -> color);
   }
   new_lab -> list = NULL;
+  new_lab -> words = NULL;
   if (old_lab -> list != NULL)
   {
     new_lab -> list = duplicate_screen_string (old_lab -> list);
@@ -444,9 +447,6 @@ extern void update_gl_pick_colors ();
 atom * duplicate_atom (atom * at)
 {
   atom * bt = g_malloc0 (sizeof*bt);
-  bt -> x = at -> x;
-  bt -> y = at -> y;
-  bt -> z = at -> z;
   bt -> sp = at -> sp;
   bt -> id = at -> id;
   bt -> style = at -> style;
@@ -470,14 +470,36 @@ atom * duplicate_atom (atom * at)
 }
 
 /*!
-  \fn void at_shift (atom * at, float * shift)
+  \fn void gl_atom_view (gl_atom * va, atom * at)
 
-  \brief modify atomic coordinates to display image in cell replica
+  \brief copy the rendering data of an atom of the project being drawn, without any allocation
 
+  \param va the rendering view to fill
   \param at the atom
+*/
+void gl_atom_view (gl_atom * va, atom * at)
+{
+  va -> x = proj_gl -> pos[step][0][at -> id];
+  va -> y = proj_gl -> pos[step][1][at -> id];
+  va -> z = proj_gl -> pos[step][2][at -> id];
+  va -> sp = at -> sp;
+  va -> id = at -> id;
+  va -> style = at -> style;
+  va -> show[0] = at -> show[0];
+  va -> show[1] = at -> show[1];
+  va -> pick[0] = at -> pick[0];
+  va -> pick[1] = at -> pick[1];
+}
+
+/*!
+  \fn void at_shift (atom_pos * at, float * shift)
+
+  \brief modify atomic coordinates to display image in cell replica
+
+  \param at the atomic coordinates
   \param shift the shift to apply
 */
-void at_shift (atom * at, float * shift)
+void at_shift (atom_pos * at, float * shift)
 {
   at -> x += shift[0];
   at -> y += shift[1];
@@ -485,14 +507,14 @@ void at_shift (atom * at, float * shift)
 }
 
 /*!
-  \fn void at_unshift (atom * at, float * shift)
+  \fn void at_unshift (atom_pos * at, float * shift)
 
   \brief correct atomic coordinates modified to display image in cell replica
 
-  \param at the atom
+  \param at the atomic coordinates
   \param shift the shift to correct
 */
-void at_unshift (atom * at, float * shift)
+void at_unshift (atom_pos * at, float * shift)
 {
   at -> x -= shift[0];
   at -> y -= shift[1];
@@ -519,8 +541,13 @@ void draw (glwin * view)
   acolorm = plot -> color_map[0];
   pcolorm = plot -> color_map[1];
   step = plot -> step;
+  // For large trajectories the coordinates and the atom data of the MD step to draw are loaded from the file
+  use_pos_step (proj_gl, step);
   int box_step = (cell_gl -> npt) ? step : 0;
   box_gl = & cell_gl -> box[box_step];
+  struct timespec prof;
+  struct timespec prof_frame;
+  profile_start (& prof_frame);
 
 /* #ifdef DEBUG
   clock_gettime (CLOCK_MONOTONIC, & start_time);
@@ -531,16 +558,68 @@ void draw (glwin * view)
   // First, if needed, we prepare the display lists
   if (proj_at)
   {
-    if (wingl -> create_shaders[ATOMS] && wingl -> n_shaders[ATOMS][step] < 0) create_atom_lists (FALSE);
-    if (wingl -> create_shaders[BONDS] && wingl -> n_shaders[BONDS][step] < 0) wingl -> n_shaders[BONDS][step] = create_bond_lists (FALSE);
-    if (wingl -> create_shaders[SELEC] && wingl -> n_shaders[SELEC][step] < 0) wingl -> n_shaders[SELEC][step] = create_selection_lists ();
-    if (wingl -> create_shaders[POLYS] && wingl -> n_shaders[POLYS][step] < 0) create_poly_lists ();
-    if (wingl -> create_shaders[RINGS] && wingl -> n_shaders[RINGS][step] < 0) create_ring_lists ();
-    if (wingl -> create_shaders[PICKS]) wingl -> n_shaders[PICKS][0] = create_pick_lists ();
-    if (wingl -> create_shaders[SLABS]) create_slab_lists (proj_gl);
-    if (wingl -> create_shaders[VOLMS] && wingl -> n_shaders[VOLMS][step] < 0) create_volumes_lists ();
-    if (wingl -> create_shaders[LABEL]) wingl -> n_shaders[LABEL][0] = create_label_lists ();
-    if (wingl -> create_shaders[MEASU]) create_measures_lists ();
+    // The atom shaders of another MD step, if any, are moved to this step
+    if ((wingl -> create_shaders[ATOMS] || wingl -> atom_stream_step > -1) && wingl -> n_shaders[ATOMS][step] < 0)
+    {
+      profile_start (& prof);
+      create_atom_lists (FALSE);
+      profile_stop ("create_atom_lists", & prof);
+    }
+    // The bond shaders built from atom pairs of another MD step, if any, are moved to this step
+    if ((wingl -> create_shaders[BONDS] || wingl -> bond_stream_step > -1) && wingl -> n_shaders[BONDS][step] < 0)
+    {
+      profile_start (& prof);
+      wingl -> n_shaders[BONDS][step] = create_bond_lists (FALSE);
+      profile_stop ("create_bond_lists", & prof);
+    }
+    if (wingl -> create_shaders[SELEC] && wingl -> n_shaders[SELEC][step] < 0)
+    {
+      profile_start (& prof);
+      wingl -> n_shaders[SELEC][step] = create_selection_lists ();
+      profile_stop ("create_selection_lists", & prof);
+    }
+    if (wingl -> create_shaders[POLYS] && wingl -> n_shaders[POLYS][step] < 0)
+    {
+      profile_start (& prof);
+      create_poly_lists ();
+      profile_stop ("create_poly_lists", & prof);
+    }
+    if (wingl -> create_shaders[RINGS] && wingl -> n_shaders[RINGS][step] < 0)
+    {
+      profile_start (& prof);
+      create_ring_lists ();
+      profile_stop ("create_ring_lists", & prof);
+    }
+    if (wingl -> create_shaders[PICKS])
+    {
+      profile_start (& prof);
+      wingl -> n_shaders[PICKS][0] = create_pick_lists ();
+      profile_stop ("create_pick_lists", & prof);
+    }
+    if (wingl -> create_shaders[SLABS])
+    {
+      profile_start (& prof);
+      create_slab_lists (proj_gl);
+      profile_stop ("create_slab_lists", & prof);
+    }
+    if (wingl -> create_shaders[VOLMS] && wingl -> n_shaders[VOLMS][step] < 0)
+    {
+      profile_start (& prof);
+      create_volumes_lists ();
+      profile_stop ("create_volumes_lists", & prof);
+    }
+    if (wingl -> create_shaders[LABEL])
+    {
+      profile_start (& prof);
+      wingl -> n_shaders[LABEL][0] = create_label_lists ();
+      profile_stop ("create_label_lists", & prof);
+    }
+    if (wingl -> create_shaders[MEASU])
+    {
+      profile_start (& prof);
+      create_measures_lists ();
+      profile_stop ("create_measures_lists", & prof);
+    }
   }
   else
   {
@@ -548,26 +627,50 @@ void draw (glwin * view)
     for (i=0; i<NGLOBAL_SHADERS; i++) cleaning_shaders (wingl, i);
     if (plot -> back -> gradient) wingl -> create_shaders[BACKG] = TRUE;
   }
-  if (plot -> back -> gradient && wingl -> create_shaders[BACKG]) create_background_lists ();
-  if (wingl -> create_shaders[MDBOX]) wingl -> n_shaders[MDBOX][box_step] = create_box_lists (box_step);
-  if (wingl -> create_shaders[MAXIS]) wingl -> n_shaders[MAXIS][0] = create_axis_lists ();
-  if (wingl -> create_shaders[LIGHT]) create_light_lists ();
+  if (plot -> back -> gradient && wingl -> create_shaders[BACKG])
+  {
+    profile_start (& prof);
+    create_background_lists ();
+    profile_stop ("create_background_lists", & prof);
+  }
+  if (wingl -> create_shaders[MDBOX])
+  {
+    profile_start (& prof);
+    wingl -> n_shaders[MDBOX][box_step] = create_box_lists (box_step);
+    profile_stop ("create_box_lists", & prof);
+  }
+  if (wingl -> create_shaders[MAXIS])
+  {
+    profile_start (& prof);
+    wingl -> n_shaders[MAXIS][0] = create_axis_lists ();
+    profile_stop ("create_axis_lists", & prof);
+  }
+  if (wingl -> create_shaders[LIGHT])
+  {
+    profile_start (& prof);
+    create_light_lists ();
+    profile_stop ("create_light_lists", & prof);
+  }
 
   setup_camera ();
   // We draw normal scene or picking mode scene (only atoms or selection)
 
   if (wingl -> to_pick)
   {
-    // Picking mode scene
+    // Picking mode scene, only the pixels around the pointer are rendered
+    GLint viewport[4];
+    int scale = (wingl -> win) ? gtk_widget_get_scale_factor (wingl -> win) : 1;
+    glGetIntegerv (GL_VIEWPORT, viewport);
     glDisable (GL_LIGHTING);
-    glClearColor (plot -> back -> color.red,
-                  plot -> back -> color.green,
-                  plot -> back -> color.blue,
-                  1.0);
+    glEnable (GL_SCISSOR_TEST);
+    glScissor (scale * wingl -> mouseX - PICK_AREA/2, viewport[3] - scale * wingl -> mouseY - PICK_AREA/2, PICK_AREA, PICK_AREA);
+    // Black, pick id 0, is nothing to pick
+    glClearColor (0.0, 0.0, 0.0, 1.0);
     glClear (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
     draw_vertices (PICKS);
 
+    glDisable (GL_SCISSOR_TEST);
     glEnable (GL_LIGHTING);
   }
   else
@@ -631,6 +734,7 @@ void draw (glwin * view)
     //draw_labels ();
     if (wingl -> record) add_image ();
   }
+  profile_stop ((wingl -> to_pick) ? "draw: picking" : "draw", & prof_frame);
 
 /* #ifdef DEBUG
   glEndQuery (GL_TIME_ELAPSED);
@@ -39,6 +39,8 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 
 //#define GLSL(src) "#version 430 core\n" #src
 #define GLSL(src) "#version 150\n" #src
+// Shader code appended to an existing shader
+#define GLSL_PART(src) #src
 
 const GLchar * point_vertex = GLSL(
   uniform mat4 mvp;
@@ -866,6 +868,266 @@ const GLchar * cap_vertex = GLSL(
   }
 );
 
+// Impostors: the sphere or cylinder surface is ray cast in a box around the object
+
+const GLchar * sphere_impostor_vertex = GLSL(
+  uniform mat4 mvp;
+  uniform mat4 m_view;
+
+  in vec3 vert;
+  in vec3 offset;
+  in vec4 vertColor;
+  in float radius;
+
+  out vec4 surfaceColor;
+  out vec3 impostorPosition;
+  flat out vec3 impostorCenter;
+  flat out vec3 impostorAxis;
+  flat out vec2 impostorSize;
+  void main ()
+  {
+    surfaceColor = vertColor;
+    vec4 pos = vec4 (radius*vert + offset, 1.0);
+    impostorPosition = vec3(m_view * pos);
+    impostorCenter = vec3(m_view * vec4(offset, 1.0));
+    impostorAxis = vec3(0.0);
+    impostorSize = vec2(radius, 0.0);
+    gl_Position = mvp * pos;
+  }
+);
+
+const GLchar * cylinder_impostor_vertex = GLSL(
+  uniform mat4 mvp;
+  uniform mat4 m_view;
+  in vec4 quat;
+  in float height;
+  in float radius;
+  in vec3 offset;
+  in vec3 vert;
+  in vec4 vertColor;
+
+  out vec4 surfaceColor;
+  out vec3 impostorPosition;
+  flat out vec3 impostorCenter;
+  flat out vec3 impostorAxis;
+  flat out vec2 impostorSize;
+
+  vec3 rotate_this (in vec3 v, in vec4 quat)
+  {
+    vec3 u = vec3(quat.x, quat.y, quat.z);
+    float s = quat.w;
+    return 2.0 * dot(u,v) * u + (s*s - dot(u,u)) * v + 2.0 * s * cross (u,v);
+  }
+
+  void main ()
+  {
+    surfaceColor = vertColor;
+    vec3 pos = vec3(radius*vert.x, radius*vert.y, 0.5*height*vert.z);
+    vec3 axis = vec3(0.0, 0.0, 1.0);
+    if (quat.w != 0.0)
+    {
+      pos = rotate_this (pos, quat);
+      axis = rotate_this (axis, quat);
+    }
+    pos += offset;
+    impostorPosition = vec3(m_view * vec4(pos, 1.0));
+    impostorCenter = vec3(m_view * vec4(offset, 1.0));
+    impostorAxis = normalize (mat3(m_view) * axis);
+    impostorSize = vec2(radius, 0.5*height);
+    gl_Position = mvp * vec4(pos, 1.0);
+  }
+);
+
+// Bonds built from atom pairs: the half bond goes from atom 'a' to the middle of the bond 'a-b',
+// the atom positions are read in a texture buffer, updated once per MD step
+
+const GLchar * pair_cylinder_vertex = GLSL(
+  uniform mat4 mvp;
+  uniform mat4 m_view;
+  uniform samplerBuffer positions;
+  in vec2 atoms;
+  in float radius;
+  in vec3 vert;
+  in vec4 vertColor;
+
+  out vec4 surfaceColor;
+  out vec3 surfacePosition;
+  out vec3 surfaceNormal;
+  out vec3 surfaceToCamera;
+
+  mat3 bond_axis (in vec3 w)
+  {
+    vec3 t = (abs(w.z) < 0.9) ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    vec3 u = normalize (cross (t, w));
+    return mat3(u, cross (w, u), w);
+  }
+
+  void main ()
+  {
+    surfaceColor = vertColor;
+    vec3 pos_a = texelFetch (positions, int(atoms.x)).xyz;
+    vec3 pos_b = 0.5 * (pos_a + texelFetch (positions, int(atoms.y)).xyz);
+    vec3 axis = pos_a - pos_b;
+    float height = length (axis);
+    mat3 rot = (height > 0.0) ? bond_axis (axis / height) : mat3(1.0);
+    vec3 pos = rot * vec3(radius*vert.x, radius*vert.y, height*vert.z) + 0.5 * (pos_a + pos_b);
+    vec3 norm = rot * normalize (vec3(vert.x, vert.y, 0.0));
+    surfacePosition = vec3(m_view * vec4(pos,1.0));
+    surfaceNormal   = mat3(m_view) * norm;
+    surfaceToCamera = normalize (- surfacePosition);
+    gl_Position = mvp * vec4(pos,1.0);
+  }
+);
+
+const GLchar * pair_cap_vertex = GLSL(
+  uniform mat4 mvp;
+  uniform mat4 m_view;
+  uniform samplerBuffer positions;
+  in vec2 atoms;
+  in float radius;
+  in vec3 vert;
+  in vec4 vertColor;
+
+  out vec4 surfaceColor;
+  out vec3 surfacePosition;
+  out vec3 surfaceNormal;
+  out vec3 surfaceToCamera;
+
+  mat3 bond_axis (in vec3 w)
+  {
+    vec3 t = (abs(w.z) < 0.9) ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    vec3 u = normalize (cross (t, w));
+    return mat3(u, cross (w, u), w);
+  }
+
+  void main ()
+  {
+    surfaceColor = vertColor;
+    vec3 pos_a = texelFetch (positions, int(atoms.x)).xyz;
+    vec3 pos_b = 0.5 * (pos_a + texelFetch (positions, int(atoms.y)).xyz);
+    vec3 axis = pos_a - pos_b;
+    float height = length (axis);
+    mat3 rot = (height > 0.0) ? bond_axis (axis / height) : mat3(1.0);
+    vec3 pos = rot * vec3(radius*vert.x, radius*vert.y, vert.z) + pos_b;
+    vec3 norm = rot * vec3(0.0, 0.0, -1.0);
+    surfacePosition = vec3(m_view * vec4(pos,1.0));
+    surfaceNormal   = mat3(m_view) * norm;
+    surfaceToCamera = normalize (- surfacePosition);
+    gl_Position = mvp * vec4(pos,1.0);
+  }
+);
+
+const GLchar * pair_impostor_vertex = GLSL(
+  uniform mat4 mvp;
+  uniform mat4 m_view;
+  uniform samplerBuffer positions;
+  in vec2 atoms;
+  in float radius;
+  in vec3 vert;
+  in vec4 vertColor;
+
+  out vec4 surfaceColor;
+  out vec3 impostorPosition;
+  flat out vec3 impostorCenter;
+  flat out vec3 impostorAxis;
+  flat out vec2 impostorSize;
+
+  mat3 bond_axis (in vec3 w)
+  {
+    vec3 t = (abs(w.z) < 0.9) ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    vec3 u = normalize (cross (t, w));
+    return mat3(u, cross (w, u), w);
+  }
+
+  void main ()
+  {
+    surfaceColor = vertColor;
+    vec3 pos_a = texelFetch (positions, int(atoms.x)).xyz;
+    vec3 pos_b = 0.5 * (pos_a + texelFetch (positions, int(atoms.y)).xyz);
+    vec3 axis = pos_a - pos_b;
+    float height = length (axis);
+    mat3 rot = (height > 0.0) ? bond_axis (axis / height) : mat3(1.0);
+    vec3 center = 0.5 * (pos_a + pos_b);
+    vec3 pos = rot * vec3(radius*vert.x, radius*vert.y, 0.5*height*vert.z) + center;
+    impostorPosition = vec3(m_view * vec4(pos, 1.0));
+    impostorCenter = vec3(m_view * vec4(center, 1.0));
+    impostorAxis = normalize (mat3(m_view) * rot[2]);
+    impostorSize = vec2(radius, 0.5*height);
+    gl_Position = mvp * vec4(pos, 1.0);
+  }
+);
+
+// Appended to the lightning fragment shader, see 'impostor_color' in 'ogl_shading.c'
+const GLchar * impostor_main = GLSL_PART(
+  uniform mat4 proj;
+
+  in vec3 impostorPosition;
+  flat in vec3 impostorCenter;
+  flat in vec3 impostorAxis;
+  flat in vec2 impostorSize;
+
+  void main ()
+  {
+    vec3 ro;
+    vec3 rd;
+    float r = impostorSize.x;
+    // Orthographic projection: parallel rays, perspective projection: rays from the eye
+    if (proj[3][3] == 1.0)
+    {
+      rd = vec3(0.0, 0.0, -1.0);
+      ro = vec3(impostorPosition.xy, impostorCenter.z + r + impostorSize.y + 1.0);
+    }
+    else
+    {
+      rd = normalize (impostorPosition);
+      ro = vec3(0.0);
+    }
+    vec3 oc = ro - impostorCenter;
+    float t;
+    vec3 n;
+    if (impostorSize.y == 0.0)
+    {
+      // Sphere
+      float b = dot(oc, rd);
+      float c = dot(oc, oc) - r*r;
+      float h = b*b - c;
+      if (h < 0.0) discard;
+      t = - b - sqrt(h);
+      n = (oc + t*rd) / r;
+    }
+    else
+    {
+      // Open cylinder, caps are rendered separately
+      float card = dot(impostorAxis, rd);
+      float caoc = dot(impostorAxis, oc);
+      float a = 1.0 - card*card;
+      float b = dot(oc, rd) - caoc*card;
+      float c = dot(oc, oc) - caoc*caoc - r*r;
+      float h = b*b - a*c;
+      if (a < 1e-6 || h < 0.0) discard;
+      h = sqrt(h);
+      t = (- b - h) / a;
+      float y = caoc + t*card;
+      float side = 1.0;
+      if (abs(y) > impostorSize.y)
+      {
+        // Looking inside the cylinder
+        t = (- b + h) / a;
+        y = caoc + t*card;
+        side = -1.0;
+        if (abs(y) > impostorSize.y) discard;
+      }
+      n = side * (oc + t*rd - y*impostorAxis) / r;
+    }
+    surfacePosition = ro + t*rd;
+    surfaceNormal = n;
+    surfaceToCamera = normalize (- surfacePosition);
+    vec4 clip = proj * vec4(surfacePosition, 1.0);
+    gl_FragDepth = 0.5 * clip.z / clip.w + 0.5;
+    shade_fragment ();
+  }
+);
+
 const GLchar * gs_cylinder_geom = GLSL(
 
   layout (lines) in;
@@ -1739,6 +2001,26 @@ const GLchar * string_color_2d = GLSL(
   }
 );
 
+// Appended to the string vertex shaders, see 'glyph_vertex' in 'ogl_text.c':
+// each instance is a character of a string, the quad and its texture coordinates in the glyph atlas
+const GLchar * glyph_main = GLSL_PART(
+  in vec2 corner;
+  in vec4 glyph_shift;
+  in vec4 glyph_pos;
+  in vec4 glyph_tex;
+  in vec4 glyph_color;
+  out vec4 vert_color;
+
+  void main ()
+  {
+    pos_shift = glyph_shift;
+    vert = mix (glyph_pos.xy, glyph_pos.zw, corner);
+    tcoord = mix (glyph_tex.xy, glyph_tex.zw, corner);
+    vert_color = glyph_color;
+    string_main ();
+  }
+);
+
 const GLchar * background_vertex = GLSL(
   in vec2 vert;
 
@@ -41,11 +41,13 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
   gboolean glsl_disable_cull_face (glsl_program * glsl);
 
   void set_light_uniform_location (GLuint * lightning, int id, int j, int k, char * string);
+  void glsl_bind_positions (glsl_program * glsl, object_3d * obj, GLuint vbo);
   void glsl_bind_points (glsl_program * glsl, object_3d * obj);
   void glsl_bind_spheres (glsl_program * glsl, object_3d * obj);
   void glsl_bind_lines (glsl_program * glsl, object_3d * obj);
   void glsl_bind_cylinders (glsl_program * glsl, object_3d * obj);
   void glsl_bind_caps (glsl_program * glsl, object_3d * obj);
+  void glsl_bind_atom_pairs (glsl_program * glsl, object_3d * obj);
   void glsl_bind_polyhedra (glsl_program * glsl, object_3d * obj);
   void glsl_bind_background (glsl_program * glsl, object_3d * obj);
   void update_string_instances (glsl_program * glsl, object_3d * obj);
@@ -60,6 +62,19 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
   void shading_glsl_text (glsl_program * glsl);
   void render_this_shader (glsl_program * glsl, int ids);
   void draw_vertices (int id);
+  void update_atom_instances (glsl_program * glsl, float * instances);
+  void update_pair_instances (glsl_program * glsl, float * instances);
+  void free_glsl_program (glsl_program * glsl);
+  void glsl_set_impostor (glsl_program * glsl);
+  void glsl_sort_instances (glsl_program * glsl);
+  void glsl_cell_bounds (glsl_program * glsl);
+  void glsl_draw_visible_cells (glsl_program * glsl, int vertices);
+
+  void glsl_instance_center (glsl_program * glsl, float * inst, float * center);
+
+  float glsl_instance_extent (glsl_program * glsl, float * inst);
+
+  const GLchar * impostor_color ();
 
   glsl_program * init_shader_program (int object, int object_id,
                                       const GLchar * vertex, const GLchar * geometry, const GLchar * fragment,
@@ -74,6 +89,8 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 #include "glview.h"
 #include "ogl_shading.h"
 
+extern gchar * substitute_string (gchar * init, gchar * o_motif, gchar * n_motif);
+
 /* Create and compile a shader */
 /*!
   \fn GLuint create_shader (int type, const GLchar * src)
@@ -193,6 +210,34 @@ GLuint * glsl_add_lights (glsl_program * glsl)
   return lightning;
 }
 
+/*!
+  \fn void glsl_bind_positions (glsl_program * glsl, object_3d * obj, GLuint vbo)
+
+  \brief bind the instance positions of an atom shader to their own buffer,
+  \brief so that they can be streamed without re-sending the colors and the radii
+
+  \param glsl the target glsl
+  \param obj the 3D object to bind
+  \param vbo the position buffer
+*/
+void glsl_bind_positions (glsl_program * glsl, object_3d * obj, GLuint vbo)
+{
+  int i;
+  float * pos = allocfloat (3*obj -> num_instances);
+  for (i=0; i<obj -> num_instances; i++)
+  {
+    pos[3*i]   = obj -> instances[i*obj -> inst_buffer_size];
+    pos[3*i+1] = obj -> instances[i*obj -> inst_buffer_size+1];
+    pos[3*i+2] = obj -> instances[i*obj -> inst_buffer_size+2];
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  glBufferData(GL_ARRAY_BUFFER, 3 * obj -> num_instances * sizeof(GLfloat), pos, GL_STREAM_DRAW);
+  glEnableVertexAttribArray (glsl -> array_pointer[1]);
+  glVertexAttribPointer (glsl -> array_pointer[1], 3, GL_FLOAT, GL_FALSE, 3*sizeof(GLfloat), (GLvoid*) 0);
+  glVertexAttribDivisor (glsl -> array_pointer[1], 1);
+  g_free (pos);
+}
+
 /*!
   \fn void glsl_bind_points (glsl_program * glsl, object_3d * obj)
 
@@ -215,15 +260,20 @@ void glsl_bind_points (glsl_program * glsl, object_3d * obj)
   // The instances (pos + col)
   glBindBuffer(GL_ARRAY_BUFFER, glsl -> vbo[1]);
   glBufferData(GL_ARRAY_BUFFER, obj -> inst_buffer_size * obj -> num_instances * sizeof(GLfloat), obj -> instances, GL_STATIC_DRAW);
-  glEnableVertexAttribArray (glsl -> array_pointer[1]);
-  glVertexAttribPointer (glsl -> array_pointer[1], 3, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) 0);
-  glVertexAttribDivisor (glsl -> array_pointer[1], 1);
+  if (glsl -> object != ATOMS)
+  {
+    glEnableVertexAttribArray (glsl -> array_pointer[1]);
+    glVertexAttribPointer (glsl -> array_pointer[1], 3, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) 0);
+    glVertexAttribDivisor (glsl -> array_pointer[1], 1);
+  }
   glEnableVertexAttribArray (glsl -> array_pointer[2]);
   glVertexAttribPointer (glsl -> array_pointer[2], 1, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) (3*sizeof(GLfloat)));
   glVertexAttribDivisor (glsl -> array_pointer[2], 1);
   glEnableVertexAttribArray (glsl -> array_pointer[3]);
   glVertexAttribPointer (glsl -> array_pointer[3], 4, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) (4*sizeof(GLfloat)));
   glVertexAttribDivisor (glsl -> array_pointer[3], 1);
+  // Atom positions in a separate buffer
+  if (glsl -> object == ATOMS) glsl_bind_positions (glsl, obj, glsl -> vbo[glsl -> nvbo-1]);
 }
 
 /*!
@@ -251,15 +301,20 @@ void glsl_bind_spheres (glsl_program * glsl, object_3d * obj)
   // The instances (pos + col)
   glBindBuffer(GL_ARRAY_BUFFER, glsl -> vbo[2]);
   glBufferData(GL_ARRAY_BUFFER, obj -> inst_buffer_size * obj -> num_instances * sizeof(GLfloat), obj -> instances, GL_STATIC_DRAW);
-  glEnableVertexAttribArray (glsl -> array_pointer[1]);
-  glVertexAttribPointer (glsl -> array_pointer[1], 3, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) 0);
-  glVertexAttribDivisor (glsl -> array_pointer[1], 1);
+  if (glsl -> object != ATOMS)
+  {
+    glEnableVertexAttribArray (glsl -> array_pointer[1]);
+    glVertexAttribPointer (glsl -> array_pointer[1], 3, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) 0);
+    glVertexAttribDivisor (glsl -> array_pointer[1], 1);
+  }
   glEnableVertexAttribArray (glsl -> array_pointer[2]);
   glVertexAttribPointer (glsl -> array_pointer[2], 1, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) (3*sizeof(GLfloat)));
   glVertexAttribDivisor (glsl -> array_pointer[2], 1);
   glEnableVertexAttribArray (glsl -> array_pointer[3]);
   glVertexAttribPointer (glsl -> array_pointer[3], 4, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) (4*sizeof(GLfloat)));
   glVertexAttribDivisor (glsl -> array_pointer[3], 1);
+  // Atom positions in a separate buffer
+  if (glsl -> object == ATOMS) glsl_bind_positions (glsl, obj, glsl -> vbo[glsl -> nvbo-1]);
 }
 
 /*!
@@ -380,6 +435,45 @@ void glsl_bind_caps (glsl_program * glsl, object_3d * obj)
   glVertexAttribDivisor (glsl -> array_pointer[4], 1);
 }
 
+/*!
+  \fn void glsl_bind_atom_pairs (glsl_program * glsl, object_3d * obj)
+
+  \brief bind a 3D object cylinder or cylinder cap, with atom pairs as instances, to an OpenGL shader program
+
+  \param glsl the target glsl, created with at least 3 uniform locations
+  \param obj the 3D object, cylinder or cylinder cap to bind
+*/
+void glsl_bind_atom_pairs (glsl_program * glsl, object_3d * obj)
+{
+  glsl -> array_pointer[1] = glGetAttribLocation (glsl -> id, "atoms");
+  glsl -> array_pointer[2] = glGetAttribLocation (glsl -> id, "radius");
+  glsl -> array_pointer[3] = glGetAttribLocation (glsl -> id, "vertColor");
+  glsl -> uniform_loc[2] = glGetUniformLocation (glsl -> id, "positions");
+
+  // The cylinder vertices
+  glBindBuffer(GL_ARRAY_BUFFER, glsl -> vbo[0]);
+  glBufferData(GL_ARRAY_BUFFER, obj -> vert_buffer_size * obj -> num_vertices*sizeof(GLfloat), obj -> vertices, GL_STATIC_DRAW);
+  glEnableVertexAttribArray(glsl -> array_pointer[0]);
+  glVertexAttribPointer(glsl -> array_pointer[0], 3, GL_FLOAT, GL_FALSE, obj -> vert_buffer_size*sizeof(GLfloat), (GLvoid*) 0);
+
+  // The cylinder indices
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, glsl -> vbo[1]);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, obj -> num_indices*sizeof(GLint), obj -> indices, GL_STATIC_DRAW);
+
+  // The instances (atoms + rad + col)
+  glBindBuffer(GL_ARRAY_BUFFER, glsl -> vbo[2]);
+  glBufferData(GL_ARRAY_BUFFER, obj -> inst_buffer_size * obj -> num_instances * sizeof(GLfloat), obj -> instances, GL_STATIC_DRAW);
+  glEnableVertexAttribArray (glsl -> array_pointer[1]);
+  glVertexAttribPointer (glsl -> array_pointer[1], 2, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) 0);
+  glVertexAttribDivisor (glsl -> array_pointer[1], 1);
+  glEnableVertexAttribArray (glsl -> array_pointer[2]);
+  glVertexAttribPointer (glsl -> array_pointer[2], 1, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) (2*sizeof(GLfloat)));
+  glVertexAttribDivisor (glsl -> array_pointer[2], 1);
+  glEnableVertexAttribArray (glsl -> array_pointer[3]);
+  glVertexAttribPointer (glsl -> array_pointer[3], 4, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) (3*sizeof(GLfloat)));
+  glVertexAttribDivisor (glsl -> array_pointer[3], 1);
+}
+
 /*!
   \fn void glsl_bind_polyhedra (glsl_program * glsl, object_3d * obj)
 
@@ -436,26 +530,32 @@ void glsl_bind_background (glsl_program * glsl, object_3d * obj)
 */
 void update_string_instances (glsl_program * glsl, object_3d * obj)
 {
-  // The instances (pos)
+  int i;
+  // The instances: one per character (shift + quad + texture coordinates + color, then pos)
   glBindBuffer(GL_ARRAY_BUFFER, glsl -> vbo[1]);
   glBufferData(GL_ARRAY_BUFFER, obj -> inst_buffer_size * obj -> num_instances * sizeof(GLfloat), obj -> instances, GL_STATIC_DRAW);
-  glEnableVertexAttribArray (glsl -> array_pointer[2]);
-
-  glVertexAttribPointer (glsl -> array_pointer[2], 3, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) 0);
-  glVertexAttribDivisor (glsl -> array_pointer[2], 1);
+  for (i=1; i<5; i++)
+  {
+    glEnableVertexAttribArray (glsl -> array_pointer[i]);
+    glVertexAttribPointer (glsl -> array_pointer[i], 4, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) (4*(i-1)*sizeof(GLfloat)));
+    glVertexAttribDivisor (glsl -> array_pointer[i], 1);
+  }
+  glEnableVertexAttribArray (glsl -> array_pointer[5]);
+  glVertexAttribPointer (glsl -> array_pointer[5], 3, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) (GLYPH_BUFF_SIZE*sizeof(GLfloat)));
+  glVertexAttribDivisor (glsl -> array_pointer[5], 1);
   if (glsl -> object == MEASU)
   {
-    glEnableVertexAttribArray (glsl -> array_pointer[3]);
-    glVertexAttribPointer (glsl -> array_pointer[3], 3, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) (3*sizeof(GLfloat)));
-    glVertexAttribDivisor (glsl -> array_pointer[3], 1);
-    glEnableVertexAttribArray (glsl -> array_pointer[4]);
-    glVertexAttribPointer (glsl -> array_pointer[4], 3, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) (6*sizeof(GLfloat)));
-    glVertexAttribDivisor (glsl -> array_pointer[4], 1);
-    if (obj -> inst_buffer_size == 12)
+    glEnableVertexAttribArray (glsl -> array_pointer[6]);
+    glVertexAttribPointer (glsl -> array_pointer[6], 3, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) ((GLYPH_BUFF_SIZE+3)*sizeof(GLfloat)));
+    glVertexAttribDivisor (glsl -> array_pointer[6], 1);
+    glEnableVertexAttribArray (glsl -> array_pointer[7]);
+    glVertexAttribPointer (glsl -> array_pointer[7], 3, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) ((GLYPH_BUFF_SIZE+6)*sizeof(GLfloat)));
+    glVertexAttribDivisor (glsl -> array_pointer[7], 1);
+    if (obj -> inst_buffer_size == GLYPH_BUFF_SIZE+12)
     {
-      glEnableVertexAttribArray (glsl -> array_pointer[5]);
-      glVertexAttribPointer (glsl -> array_pointer[5], 3, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) (9*sizeof(GLfloat)));
-      glVertexAttribDivisor (glsl -> array_pointer[5], 1);
+      glEnableVertexAttribArray (glsl -> array_pointer[8]);
+      glVertexAttribPointer (glsl -> array_pointer[8], 3, GL_FLOAT, GL_FALSE, obj -> inst_buffer_size*sizeof(GLfloat), (GLvoid*) ((GLYPH_BUFF_SIZE+9)*sizeof(GLfloat)));
+      glVertexAttribDivisor (glsl -> array_pointer[8], 1);
     }
   }
 }
@@ -463,7 +563,8 @@ void update_string_instances (glsl_program * glsl, object_3d * obj)
 /*!
   \fn void glsl_bind_string (glsl_program * glsl, object_3d * obj)
 
-  \brief bind a 3D object text string to an OpenGL shader program
+  \brief bind a 3D object text string to an OpenGL shader program,
+  \brief the characters are drawn as instances of a quad textured using the glyph atlas
 
   \param glsl the target glsl
   \param obj the 3D object text string to bind
@@ -477,26 +578,26 @@ void glsl_bind_string (glsl_program * glsl, object_3d * obj)
   glsl -> uniform_loc[2] = glGetUniformLocation (glsl -> id, "text_proj");
   glsl -> uniform_loc[3] = glGetUniformLocation (glsl -> id, "un_view");
   glsl -> uniform_loc[4] = glGetUniformLocation (glsl -> id, "viewp");
-  glsl -> uniform_loc[5] = glGetUniformLocation (glsl -> id, "pos_shift");
-  glsl -> uniform_loc[6] = glGetUniformLocation (glsl -> id, "vert_color");
 
-  glsl -> array_pointer[1] = glGetAttribLocation (glsl -> id, "tcoord");
-  glsl -> array_pointer[2] = glGetAttribLocation (glsl -> id, "offset");
+  glsl -> array_pointer[0] = glGetAttribLocation (glsl -> id, "corner");
+  glsl -> array_pointer[1] = glGetAttribLocation (glsl -> id, "glyph_shift");
+  glsl -> array_pointer[2] = glGetAttribLocation (glsl -> id, "glyph_pos");
+  glsl -> array_pointer[3] = glGetAttribLocation (glsl -> id, "glyph_tex");
+  glsl -> array_pointer[4] = glGetAttribLocation (glsl -> id, "glyph_color");
+  glsl -> array_pointer[5] = glGetAttribLocation (glsl -> id, "offset");
   if (glsl -> object == MEASU)
   {
     glsl -> uniform_loc[7] =  glGetUniformLocation (glsl -> id, "tilted");
-    glsl -> array_pointer[3] = glGetAttribLocation (glsl -> id, "at_a");
-    glsl -> array_pointer[4] = glGetAttribLocation (glsl -> id, "at_b");
-    if (obj -> inst_buffer_size == 12) glsl -> array_pointer[5] = glGetAttribLocation (glsl -> id, "at_c");
+    glsl -> array_pointer[6] = glGetAttribLocation (glsl -> id, "at_a");
+    glsl -> array_pointer[7] = glGetAttribLocation (glsl -> id, "at_b");
+    if (obj -> inst_buffer_size == GLYPH_BUFF_SIZE+12) glsl -> array_pointer[8] = glGetAttribLocation (glsl -> id, "at_c");
   }
 
-  // The string (rendered using triangles and textures + colors)
+  // The character quad (rendered using triangles and textures + colors)
   glBindBuffer(GL_ARRAY_BUFFER, glsl -> vbo[0]);
   glBufferData(GL_ARRAY_BUFFER, obj -> vert_buffer_size * obj -> num_vertices*sizeof(GLfloat), obj -> vertices, GL_STATIC_DRAW);
   glEnableVertexAttribArray(glsl -> array_pointer[0]);
   glVertexAttribPointer(glsl -> array_pointer[0], 2, GL_FLOAT, GL_FALSE, obj -> vert_buffer_size*sizeof(GLfloat), (GLvoid*) 0);
-  glEnableVertexAttribArray(glsl -> array_pointer[1]);
-  glVertexAttribPointer(glsl -> array_pointer[1], 2, GL_FLOAT, GL_FALSE, obj -> vert_buffer_size*sizeof(GLfloat), (GLvoid*) (2*sizeof(GLfloat)));
   update_string_instances (glsl, obj);
 }
 
@@ -596,6 +697,8 @@ glsl_program * init_shader_program (int object, int object_id,
   glsl -> obj = duplicate_object_3d (obj);
 
   glsl -> draw_instanced = FALSE;
+  glsl -> num_cells = 0;
+  glsl -> atom_pairs = ((object_id == GLSL_CYLINDERS || object_id == GLSL_CAPS) && obj -> inst_buffer_size == PAIR_BUFF_SIZE) ? TRUE : FALSE;
 
   int nvbo = 1;
   if (glsl -> obj -> num_indices > 0) nvbo ++;
@@ -603,8 +706,14 @@ glsl_program * init_shader_program (int object, int object_id,
   {
     nvbo ++;
     if (glsl -> obj -> num_instances > 1) glsl -> draw_instanced = TRUE;
+    // Atom positions are streamed in their own buffer
+    if (object == ATOMS && (object_id == GLSL_SPHERES || object_id == GLSL_POINTS)) nvbo ++;
   }
 
+  // Instances are sorted by spatial cell before they are sent to the GPU
+  glsl_sort_instances (glsl);
+
+  glsl -> nvbo = nvbo;
   glsl -> vbo = allocgluint (nvbo);
   glGenBuffers (nvbo, glsl -> vbo);
 
@@ -623,12 +732,26 @@ glsl_program * init_shader_program (int object, int object_id,
       glsl_bind_lines (glsl, glsl -> obj);
       break;
     case GLSL_CYLINDERS:
-      // narray = 6
-      glsl_bind_cylinders (glsl, glsl -> obj);
+      // narray = 6, atom pairs: narray = 4, nunif = 3
+      if (glsl -> atom_pairs)
+      {
+        glsl_bind_atom_pairs (glsl, glsl -> obj);
+      }
+      else
+      {
+        glsl_bind_cylinders (glsl, glsl -> obj);
+      }
       break;
     case GLSL_CAPS:
-      // narray = 5
-      glsl_bind_caps (glsl, glsl -> obj);
+      // narray = 5, atom pairs: narray = 4, nunif = 3
+      if (glsl -> atom_pairs)
+      {
+        glsl_bind_atom_pairs (glsl, glsl -> obj);
+      }
+      else
+      {
+        glsl_bind_caps (glsl, glsl -> obj);
+      }
       break;
     case GLSL_POLYEDRA:
       glsl_bind_polyhedra (glsl, glsl -> obj);
@@ -805,6 +928,8 @@ void init_shaders (glwin * view)
     }
     view -> create_shaders[i] = TRUE;
   }
+  view -> atom_stream_step = -1;
+  view -> bond_stream_step = -1;
 }
 
 /*!
@@ -828,6 +953,11 @@ gboolean glsl_disable_cull_face (glsl_program * glsl)
   {
     return FALSE;
   }
+  else if (glsl -> impostor)
+  {
+    // Only the front faces of the box are ray cast
+    return FALSE;
+  }
   else
   {
     return TRUE;
@@ -893,6 +1023,12 @@ int this_tilt;
 int this_pattern;
 int this_factor;
 
+char * shader_profile_name[NGLOBAL_SHADERS] = {"draw_vertices: atoms", "draw_vertices: bonds", "draw_vertices: selection",
+                                               "draw_vertices: polyhedra", "draw_vertices: box", "draw_vertices: axis",
+                                               "draw_vertices: arrows", "draw_vertices: rings", "draw_vertices: picking",
+                                               "draw_vertices: labels", "draw_vertices: measures", "draw_vertices: lights",
+                                               "draw_vertices: slabs", "draw_vertices: volumes", "draw_vertices: background"};
+
 /*!
   \fn void shading_glsl_text (glsl_program * glsl)
 
@@ -906,10 +1042,6 @@ void shading_glsl_text (glsl_program * glsl)
   glUniformMatrix4fv (glsl -> uniform_loc[2], 1, GL_FALSE, & wingl -> label_projection_matrix.m00);
   glUniformMatrix4fv (glsl -> uniform_loc[3], 1, GL_FALSE, & wingl -> un_view_matrix.m00);
   glUniform4f (glsl -> uniform_loc[4], wingl -> view_port.w, wingl -> view_port.x, wingl -> view_port.y, wingl -> view_port.z);
-  glUniform4f (glsl -> uniform_loc[5], glsl -> obj -> shift[0], glsl -> obj -> shift[1],
-                                       glsl -> obj -> shift[2], glsl -> obj -> shift[3]);
-  glUniform4f (glsl -> uniform_loc[6], glsl -> col -> red, glsl -> col -> green,
-                                       glsl -> col -> blue, glsl -> col -> alpha);
   if (glsl -> object == MEASU) glUniform1i (glsl -> uniform_loc[7], this_tilt);
 }
 
@@ -999,6 +1131,15 @@ void render_this_shader (glsl_program * glsl, int ids)
   else
   {
     glUniformMatrix4fv (glsl -> uniform_loc[0], 1, GL_FALSE, & wingl -> proj_model_view_matrix.m00);
+    // The depth of the ray cast surface requires the projection
+    if (glsl -> impostor) glUniformMatrix4fv (glsl -> uniform_loc[1], 1, GL_FALSE, & wingl -> projection_matrix.m00);
+    if (glsl -> atom_pairs)
+    {
+      glActiveTexture (GL_TEXTURE1);
+      glBindTexture (GL_TEXTURE_BUFFER, wingl -> atom_positions[1]);
+      glUniform1i (glsl -> uniform_loc[2], 1);
+      glActiveTexture (GL_TEXTURE0);
+    }
   }
 
   if (glsl -> line_width != 0.0) glLineWidth (glsl -> line_width);
@@ -1024,7 +1165,11 @@ void render_this_shader (glsl_program * glsl, int ids)
 
   if (glsl -> draw_type == GLSL_SPHERES || glsl -> draw_type == GLSL_CYLINDERS || glsl -> draw_type == GLSL_CAPS)
   {
-    if (glsl -> draw_instanced)
+    if (glsl -> num_cells)
+    {
+      glsl_draw_visible_cells (glsl, 0);
+    }
+    else if (glsl -> draw_instanced)
     {
       glDrawElementsInstanced (glsl -> vert_type, glsl -> obj -> num_indices, GL_UNSIGNED_INT, 0, glsl -> obj -> num_instances);
     }
@@ -1044,7 +1189,14 @@ void render_this_shader (glsl_program * glsl, int ids)
     if (glsl -> draw_instanced)
     {
       j = (glsl -> draw_type == GLSL_STRING) ? 4 : 3*(glsl -> draw_type+1);
-      glDrawArraysInstanced (glsl -> vert_type, 0, j, glsl -> obj -> num_instances);
+      if (glsl -> num_cells)
+      {
+        glsl_draw_visible_cells (glsl, j);
+      }
+      else
+      {
+        glDrawArraysInstanced (glsl -> vert_type, 0, j, glsl -> obj -> num_instances);
+      }
     }
     else
     {
@@ -1072,6 +1224,11 @@ void draw_vertices (int id)
 {
   int i, j;
   glsl_program * glsl;
+  struct timespec prof;
+  gint64 prof_calls = 0;
+  gint64 prof_inst = 0;
+  gint64 prof_culled = 0;
+  profile_start (& prof);
   if (id != MEASU)
   {
     i = (in_md_shaders(proj_gl, id)) ? step : 0;
@@ -1082,6 +1239,9 @@ void draw_vertices (int id)
         glsl = wingl -> ogl_glsl[id][i][j];
         glUseProgram (glsl -> id);
         render_this_shader (glsl, j);
+        prof_calls ++;
+        prof_inst += max(1, glsl -> obj -> num_instances) - glsl -> culled;
+        prof_culled += glsl -> culled;
       }
     }
   }
@@ -1099,8 +1259,495 @@ void draw_vertices (int id)
           glsl = wingl -> ogl_glsl[id][i][j];
           glUseProgram (glsl -> id);
           render_this_shader (glsl, j);
+          prof_calls ++;
+          prof_inst += max(1, glsl -> obj -> num_instances) - glsl -> culled;
+          prof_culled += glsl -> culled;
         }
       }
     }
   }
+  if (profiling && prof_calls)
+  {
+    // CPU time to submit the pass, the GPU work is asynchronous
+    profile_stop (shader_profile_name[id], & prof);
+    profile_count ("draw calls", prof_calls);
+    profile_count ("instances drawn", prof_inst);
+    profile_count ("instances culled", prof_culled);
+  }
+}
+
+/*!
+  \fn void update_atom_instances (glsl_program * glsl, float * instances)
+
+  \brief rewrite in place the instance buffers of an atom shader,
+  \brief only the positions are sent if the colors and the radii did not change
+
+  \param glsl the target glsl, built with the same number of instances
+  \param instances the new instance data, in atom order, the glsl takes ownership of the pointer
+*/
+void update_atom_instances (glsl_program * glsl, float * instances)
+{
+  int i, j, k;
+  int sz = glsl -> obj -> inst_buffer_size;
+  int num = glsl -> obj -> num_instances;
+  gboolean resend = FALSE;
+  gboolean mapped;
+  float * pos;
+  float * old_instances = glsl -> obj -> instances;
+  int * order = glsl -> inst_order;
+
+  // The old instances are sorted by spatial cell, the colors and the radii are compared in atom order
+  for (i=0; i<num; i++)
+  {
+    k = (order) ? order[i] : i;
+    for (j=3; j<sz; j++)
+    {
+      if (instances[k*sz+j] != old_instances[i*sz+j])
+      {
+        resend = TRUE;
+        break;
+      }
+    }
+    if (resend) break;
+  }
+  if (resend)
+  {
+    // New spatial cells for the new positions
+    glsl -> obj -> instances = instances;
+    glsl_sort_instances (glsl);
+    g_free (old_instances);
+    // Orphan the old storage, the driver does not wait for the frames still using it
+    glBindBuffer (GL_ARRAY_BUFFER, glsl -> vbo[glsl -> nvbo-2]);
+    glBufferData (GL_ARRAY_BUFFER, sz * num * sizeof(GLfloat), NULL, GL_DYNAMIC_DRAW);
+    glBufferSubData (GL_ARRAY_BUFFER, 0, sz * num * sizeof(GLfloat), glsl -> obj -> instances);
+  }
+  else
+  {
+    // The spatial order is kept: the positions move in their cell, only the cell bounds change
+    for (i=0; i<num; i++)
+    {
+      k = (order) ? order[i] : i;
+      for (j=0; j<3; j++) old_instances[i*sz+j] = instances[k*sz+j];
+    }
+    g_free (instances);
+    glsl_cell_bounds (glsl);
+  }
+  instances = glsl -> obj -> instances;
+  glBindBuffer (GL_ARRAY_BUFFER, glsl -> vbo[glsl -> nvbo-1]);
+  pos = glMapBufferRange (GL_ARRAY_BUFFER, 0, 3 * num * sizeof(GLfloat), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+  mapped = (pos != NULL) ? TRUE : FALSE;
+  if (! mapped) pos = allocfloat (3*num);
+  for (i=0; i<num; i++)
+  {
+    pos[3*i]   = instances[i*sz];
+    pos[3*i+1] = instances[i*sz+1];
+    pos[3*i+2] = instances[i*sz+2];
+  }
+  if (mapped)
+  {
+    glUnmapBuffer (GL_ARRAY_BUFFER);
+  }
+  else
+  {
+    glBufferSubData (GL_ARRAY_BUFFER, 0, 3 * num * sizeof(GLfloat), pos);
+    g_free (pos);
+  }
+  glBindBuffer (GL_ARRAY_BUFFER, 0);
+}
+
+/*!
+  \fn void update_pair_instances (glsl_program * glsl, float * instances)
+
+  \brief rewrite in place the instance buffer of an atom pair shader, if the instances changed,
+  \brief the atom positions are not part of the instances, but the bounds of the spatial cells are updated
+
+  \param glsl the target glsl, built with the same number of instances
+  \param instances the new instance data, in bond order, the glsl takes ownership of the pointer
+*/
+void update_pair_instances (glsl_program * glsl, float * instances)
+{
+  int i, k;
+  int sz = glsl -> obj -> inst_buffer_size;
+  int num = glsl -> obj -> num_instances;
+  gboolean resend = FALSE;
+  float * old_instances = glsl -> obj -> instances;
+  int * order = glsl -> inst_order;
+
+  // The old instances are sorted by spatial cell, the pairs are compared in bond order
+  for (i=0; i<num; i++)
+  {
+    k = (order) ? order[i] : i;
+    if (memcmp (& instances[k*sz], & old_instances[i*sz], sz * sizeof(GLfloat)))
+    {
+      resend = TRUE;
+      break;
+    }
+  }
+  if (resend)
+  {
+    // New spatial cells for the atom positions of the active MD step
+    glsl -> obj -> instances = instances;
+    glsl_sort_instances (glsl);
+    g_free (old_instances);
+    // Orphan the old storage, the driver does not wait for the frames still using it
+    glBindBuffer (GL_ARRAY_BUFFER, glsl -> vbo[2]);
+    glBufferData (GL_ARRAY_BUFFER, sz * num * sizeof(GLfloat), NULL, GL_DYNAMIC_DRAW);
+    glBufferSubData (GL_ARRAY_BUFFER, 0, sz * num * sizeof(GLfloat), glsl -> obj -> instances);
+    glBindBuffer (GL_ARRAY_BUFFER, 0);
+  }
+  else
+  {
+    // Same pairs in the same cells: only the cell bounds follow the atoms
+    g_free (instances);
+    glsl_cell_bounds (glsl);
+  }
+}
+
+/*!
+  \fn void free_glsl_program (glsl_program * glsl)
+
+  \brief free an OpenGL shader program, and the GPU buffers it owns
+
+  \param glsl the glsl to free
+*/
+void free_glsl_program (glsl_program * glsl)
+{
+  if (glsl == NULL) return;
+  glDeleteBuffers (glsl -> nvbo, glsl -> vbo);
+  glDeleteVertexArrays (1, & glsl -> vao);
+  glDeleteShader (glsl -> vertex_shader);
+  if (glsl -> geometry_shader) glDeleteShader (glsl -> geometry_shader);
+  glDeleteShader (glsl -> fragment_shader);
+  glDeleteProgram (glsl -> id);
+  g_free (glsl -> vbo);
+  g_free (glsl -> array_pointer);
+  g_free (glsl -> uniform_loc);
+  if (glsl -> light_uniform != NULL) g_free (glsl -> light_uniform);
+  if (glsl -> cell_start != NULL) g_free (glsl -> cell_start);
+  if (glsl -> cell_bound != NULL) g_free (glsl -> cell_bound);
+  if (glsl -> inst_order != NULL) g_free (glsl -> inst_order);
+  if (glsl -> obj != NULL)
+  {
+    if (glsl -> obj -> vertices != NULL) g_free (glsl -> obj -> vertices);
+    if (glsl -> obj -> indices != NULL) g_free (glsl -> obj -> indices);
+    if (glsl -> obj -> instances != NULL) g_free (glsl -> obj -> instances);
+    g_free (glsl -> obj);
+  }
+  g_free (glsl);
+}
+
+/*!
+  \fn const GLchar * impostor_color ()
+
+  \brief get the fragment shader of the sphere and cylinder impostors:
+  \brief the lightning shader, with the surface position and normal computed by ray casting
+*/
+const GLchar * impostor_color ()
+{
+  static gchar * impostor = NULL;
+  gchar * in_vars[4] = {"in vec3 surfacePosition;", "in vec3 surfaceNormal;", "in vec3 surfaceToCamera;", "void main ()"};
+  gchar * out_vars[4] = {"vec3 surfacePosition;", "vec3 surfaceNormal;", "vec3 surfaceToCamera;", "void shade_fragment ()"};
+  gchar * str_a, * str_b;
+  int i;
+  if (impostor == NULL)
+  {
+    str_a = g_strdup_printf ("%s", full_color);
+    for (i=0; i<4; i++)
+    {
+      str_b = substitute_string (str_a, in_vars[i], out_vars[i]);
+      g_free (str_a);
+      str_a = str_b;
+    }
+    impostor = g_strdup_printf ("%s\n%s", str_a, impostor_main);
+    g_free (str_a);
+  }
+  return impostor;
+}
+
+/*!
+  \fn void glsl_set_impostor (glsl_program * glsl)
+
+  \brief flag an OpenGL shader program as impostor, its program must use 'impostor_color'
+
+  \param glsl the target glsl, created with at least 2 uniform locations
+*/
+void glsl_set_impostor (glsl_program * glsl)
+{
+  glsl -> impostor = TRUE;
+  glsl -> uniform_loc[1] = glGetUniformLocation (glsl -> id, "proj");
+}
+
+/*!
+  \fn float glsl_instance_extent (glsl_program * glsl, float * inst)
+
+  \brief get the radius of the sphere that bounds an instance, around its position
+
+  \param glsl the target glsl
+  \param inst the instance data
+*/
+float glsl_instance_extent (glsl_program * glsl, float * inst)
+{
+  int a, b;
+  double d[3];
+  if (glsl -> atom_pairs)
+  {
+    // Half bond, and its cap, from atom 'a' to the middle of the bond 'a-b'
+    a = (int)inst[0];
+    b = (int)inst[1];
+    d[0] = proj_gl -> pos[step][0][b] - proj_gl -> pos[step][0][a];
+    d[1] = proj_gl -> pos[step][1][b] - proj_gl -> pos[step][1][a];
+    d[2] = proj_gl -> pos[step][2][b] - proj_gl -> pos[step][2][a];
+    return 0.25*sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]) + inst[2];
+  }
+  switch (glsl -> draw_type)
+  {
+    case GLSL_SPHERES:
+      return inst[3];
+      break;
+    case GLSL_CYLINDERS:
+      return sqrt (0.25*inst[3]*inst[3] + inst[4]*inst[4]);
+      break;
+    case GLSL_CAPS:
+      return inst[3];
+      break;
+    default:
+      // Points are clipped using their center
+      return 0.0;
+      break;
+  }
+}
+
+/*!
+  \fn void glsl_instance_center (glsl_program * glsl, float * inst, float * center)
+
+  \brief get the position of an instance, atom pairs use the atom positions of the active MD step
+
+  \param glsl the target glsl
+  \param inst the instance data
+  \param center the position to compute
+*/
+void glsl_instance_center (glsl_program * glsl, float * inst, float * center)
+{
+  int k;
+  int a, b;
+  if (glsl -> atom_pairs)
+  {
+    // Center of the half bond from atom 'a' to the middle of the bond 'a-b'
+    a = (int)inst[0];
+    b = (int)inst[1];
+    for (k=0; k<3; k++) center[k] = 0.75*proj_gl -> pos[step][k][a] + 0.25*proj_gl -> pos[step][k][b];
+  }
+  else
+  {
+    for (k=0; k<3; k++) center[k] = inst[k];
+  }
+}
+
+/*!
+  \fn void glsl_sort_instances (glsl_program * glsl)
+
+  \brief sort the instances of an OpenGL shader program using a spatial grid,
+  \brief and compute the bounding sphere of each cell of the grid, for frustum culling,
+  \brief the initial index of each sorted instance is kept in 'inst_order'
+
+  \param glsl the target glsl
+*/
+void glsl_sort_instances (glsl_program * glsl)
+{
+  int i, j, k, l, m;
+  int grid, ncells;
+  int * cell, * cstart;
+  float * sorted, * center;
+  float cmin[3], cmax[3];
+  object_3d * obj = glsl -> obj;
+  int num = obj -> num_instances;
+  int sz = obj -> inst_buffer_size;
+
+  if (glsl -> cell_start != NULL)
+  {
+    g_free (glsl -> cell_start);
+    glsl -> cell_start = NULL;
+  }
+  if (glsl -> cell_bound != NULL)
+  {
+    g_free (glsl -> cell_bound);
+    glsl -> cell_bound = NULL;
+  }
+  if (glsl -> inst_order != NULL)
+  {
+    g_free (glsl -> inst_order);
+    glsl -> inst_order = NULL;
+  }
+  glsl -> num_cells = 0;
+  if (! glsl -> draw_instanced || num < 2*CULL_CELL_INSTANCES) return;
+  if (glsl -> draw_type != GLSL_SPHERES && glsl -> draw_type != GLSL_POINTS && glsl -> draw_type != GLSL_CYLINDERS && glsl -> draw_type != GLSL_CAPS) return;
+  // Drawing a range of instances requires 'base instance' draw calls
+  if (epoxy_gl_version () < 42 && ! epoxy_has_gl_extension ("GL_ARB_base_instance")) return;
+
+  center = allocfloat (3*num);
+  for (i=0; i<num; i++) glsl_instance_center (glsl, & obj -> instances[i*sz], & center[3*i]);
+  for (k=0; k<3; k++) cmin[k] = cmax[k] = center[k];
+  for (i=1; i<num; i++)
+  {
+    for (k=0; k<3; k++)
+    {
+      cmin[k] = min(cmin[k], center[3*i+k]);
+      cmax[k] = max(cmax[k], center[3*i+k]);
+    }
+  }
+  grid = max(1, (int)cbrt((double)num/CULL_CELL_INSTANCES));
+  ncells = grid*grid*grid;
+  cell = allocint (num);
+  cstart = allocint (ncells+1);
+  for (i=0; i<num; i++)
+  {
+    l = 0;
+    for (k=2; k>-1; k--)
+    {
+      m = (cmax[k] > cmin[k]) ? (int)(grid*(center[3*i+k] - cmin[k])/(cmax[k] - cmin[k])) : 0;
+      l = l*grid + min(max(m, 0), grid-1);
+    }
+    cell[i] = l;
+    cstart[l+1] ++;
+  }
+  for (l=0; l<ncells; l++) cstart[l+1] += cstart[l];
+  g_free (center);
+
+  // Counting sort, the order of the instances in a cell is preserved
+  sorted = allocfloat (num*sz);
+  glsl -> cell_start = allocint (ncells+1);
+  glsl -> cell_bound = allocfloat (4*ncells);
+  glsl -> inst_order = allocint (num);
+  j = 0;
+  for (l=0; l<ncells; l++)
+  {
+    if (cstart[l+1] > cstart[l])
+    {
+      glsl -> cell_start[j] = cstart[l];
+      j ++;
+    }
+  }
+  glsl -> num_cells = j;
+  glsl -> cell_start[j] = num;
+  for (i=0; i<num; i++)
+  {
+    l = cell[i];
+    memcpy (& sorted[cstart[l]*sz], & obj -> instances[i*sz], sz*sizeof(GLfloat));
+    glsl -> inst_order[cstart[l]] = i;
+    cstart[l] ++;
+  }
+  g_free (obj -> instances);
+  obj -> instances = sorted;
+  g_free (cell);
+  g_free (cstart);
+  glsl_cell_bounds (glsl);
+}
+
+/*!
+  \fn void glsl_cell_bounds (glsl_program * glsl)
+
+  \brief compute the bounding sphere of each spatial cell of an OpenGL shader program,
+  \brief using the actual instance positions, those of the active MD step for atom pairs
+
+  \param glsl the target glsl, with instances sorted by spatial cell
+*/
+void glsl_cell_bounds (glsl_program * glsl)
+{
+  int i, j, k;
+  float ext;
+  float cmin[3], cmax[3], center[3];
+  float * sorted = glsl -> obj -> instances;
+  int sz = glsl -> obj -> inst_buffer_size;
+
+  for (j=0; j<glsl -> num_cells; j++)
+  {
+    glsl_instance_center (glsl, & sorted[glsl -> cell_start[j]*sz], cmin);
+    for (k=0; k<3; k++) cmax[k] = cmin[k];
+    ext = 0.0;
+    for (i=glsl -> cell_start[j]; i<glsl -> cell_start[j+1]; i++)
+    {
+      glsl_instance_center (glsl, & sorted[i*sz], center);
+      for (k=0; k<3; k++)
+      {
+        cmin[k] = min(cmin[k], center[k]);
+        cmax[k] = max(cmax[k], center[k]);
+      }
+      ext = max(ext, glsl_instance_extent (glsl, & sorted[i*sz]));
+    }
+    for (k=0; k<3; k++) glsl -> cell_bound[4*j+k] = 0.5*(cmin[k] + cmax[k]);
+    glsl -> cell_bound[4*j+3] = 0.5*sqrt((cmax[0]-cmin[0])*(cmax[0]-cmin[0]) + (cmax[1]-cmin[1])*(cmax[1]-cmin[1]) + (cmax[2]-cmin[2])*(cmax[2]-cmin[2])) + ext;
+  }
+}
+
+/*!
+  \fn void glsl_draw_visible_cells (glsl_program * glsl, int vertices)
+
+  \brief render the instances of the spatial cells that intersect the view frustum,
+  \brief contiguous visible cells are rendered in a single draw call
+
+  \param glsl the target glsl
+  \param vertices number of vertices for 'glDrawArrays' instances, 0 to use the indices
+*/
+void glsl_draw_visible_cells (glsl_program * glsl, int vertices)
+{
+  int i, j, k;
+  int first = -1;
+  int visible = 0;
+  int count;
+  float plane[6][4];
+  float norm, dist;
+  gboolean in;
+  mat4_t * mvp = & wingl -> proj_model_view_matrix;
+
+  // Frustum planes from the rows of the MVP matrix, normals pointing inside
+  for (i=0; i<3; i++)
+  {
+    for (k=0; k<4; k++)
+    {
+      plane[2*i][k] = mvp -> m[k][3] + mvp -> m[k][i];
+      plane[2*i+1][k] = mvp -> m[k][3] - mvp -> m[k][i];
+    }
+  }
+  for (i=0; i<6; i++)
+  {
+    norm = sqrt (plane[i][0]*plane[i][0] + plane[i][1]*plane[i][1] + plane[i][2]*plane[i][2]);
+    if (norm > 0.0) for (k=0; k<4; k++) plane[i][k] /= norm;
+  }
+
+  for (j=0; j<=glsl -> num_cells; j++)
+  {
+    in = FALSE;
+    if (j < glsl -> num_cells)
+    {
+      in = TRUE;
+      for (i=0; i<6; i++)
+      {
+        dist = plane[i][0]*glsl -> cell_bound[4*j] + plane[i][1]*glsl -> cell_bound[4*j+1] + plane[i][2]*glsl -> cell_bound[4*j+2] + plane[i][3];
+        if (dist < - glsl -> cell_bound[4*j+3])
+        {
+          in = FALSE;
+          break;
+        }
+      }
+    }
+    if (in)
+    {
+      if (first < 0) first = j;
+    }
+    else if (first > -1)
+    {
+      count = glsl -> cell_start[j] - glsl -> cell_start[first];
+      if (vertices)
+      {
+        glDrawArraysInstancedBaseInstance (glsl -> vert_type, 0, vertices, count, glsl -> cell_start[first]);
+      }
+      else
+      {
+        glDrawElementsInstancedBaseInstance (glsl -> vert_type, glsl -> obj -> num_indices, GL_UNSIGNED_INT, 0, count, glsl -> cell_start[first]);
+      }
+      visible += count;
+      first = -1;
+    }
+  }
+  glsl -> culled = glsl -> obj -> num_instances - visible;
 }
@@ -50,8 +50,15 @@ enum glsl_styles {
 #define LINE_BUFF_SIZE  7  // p(x,y,z), color (r,g,b,a)
 #define CYLI_BUFF_SIZE 13  // p(x,y,z), length, rad, quat(w,x,y,z), color (r,g,b,a)
 #define CAPS_BUFF_SIZE 12  // p(x,y,z), rad, quat(w,x,y,z), color (r,g,b,a)
+#define PAIR_BUFF_SIZE  7  // atoms (a,b), rad, color (r,g,b,a)
 #define ATOM_BUFF_SIZE  8  // p(x,y,z), rad, color (r,g,b,a)
-#define CHAR_BUFF_SIZE  4  // p(x,y), t(x,y)
+
+/*! \def CULL_CELL_INSTANCES
+  \brief Average number of instances per spatial cell, for frustum culling
+*/
+#define CULL_CELL_INSTANCES 256
+#define CHAR_BUFF_SIZE  2  // corner(x,y)
+#define GLYPH_BUFF_SIZE 16 // shift(x,y,z,w), quad(x,y,x,y), t(x,y,x,y), color (r,g,b,a), then the string position(s)
 
 // Points
 extern const GLchar * point_vertex;
@@ -81,6 +88,15 @@ extern const GLchar * cylinder_vertex;
 extern const GLchar * cone_vertex;
 extern const GLchar * cap_vertex;
 
+// Cylinder and caps built from the atom positions
+extern const GLchar * pair_cylinder_vertex;
+extern const GLchar * pair_cap_vertex;
+extern const GLchar * pair_impostor_vertex;
+
+extern const GLchar * sphere_impostor_vertex;
+extern const GLchar * cylinder_impostor_vertex;
+extern const GLchar * impostor_main;
+
 extern const GLchar * axis_sphere_vertex;
 extern const GLchar * axis_cylinder_geom;
 extern const GLchar * axis_line_vertex;
@@ -100,6 +116,7 @@ extern const GLchar * pick_color;
 extern const GLchar * string_vertex;
 extern const GLchar * string_color;
 extern const GLchar * string_color_2d;
+extern const GLchar * glyph_main;
 
 extern const GLchar * background_vertex;
 extern const GLchar * background_linear;
@@ -136,13 +153,21 @@ struct glsl_program
   GLuint fragment_shader;  /*!< The fragment shader ID */
   GLenum vert_type;        /*!< The type of vertex */
   int draw_type;           /*!< In \enum glsl_styles */
+  gboolean impostor;       /*!< Sphere / cylinder impostor, ray cast in a box (1/0) */
+  gboolean atom_pairs;     /*!< Cylinder / cap instances are atom pairs, the positions are read in the atom position buffer (1/0) */
   gboolean draw_instanced; /*!< 0 = single instance, 1 = multiple instances */
   GLuint vao;              /*!< Vertex object array ID */
+  int nvbo;                /*!< Number of binding buffer(s) */
   GLuint * vbo;            /*!< Binding buffer(s) */
   GLuint * array_pointer;  /*!< Vertex pointer(s) */
   GLuint * uniform_loc;    /*!< Uniform location pointer(s) */
   GLuint * light_uniform;  /*!< Light(s) uniform */
   object_3d * obj;         /*!< The 3D object(s) to render */
+  int num_cells;           /*!< Number of spatial cell(s) for frustum culling, 0 = no culling */
+  int * cell_start;        /*!< First instance of each cell, the instances are sorted by cell */
+  float * cell_bound;      /*!< Bounding sphere of each cell (x, y, z, radius) */
+  int * inst_order;        /*!< Initial index of each instance sorted by spatial cell, NULL if not sorted */
+  int culled;              /*!< Number of instance(s) culled at the last rendering */
   float line_width;        /*!< Wireframe line width */
   ColRGBA * col;           /*!< String color */
 };
@@ -32,12 +32,12 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 
   double arc_cos (double val);
 
-  distance distance_2d (atom * at, atom * bt);
-  distance distance_3d (cell_info * cell, int mdstep, atom * at, atom * bt);
-  angle angle_2d (atom * at, atom * bt, atom * ct);
-  angle angle_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct);
-  angle dihedral_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct, atom * dt);
-  angle inversion_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct, atom * dt);
+  distance distance_2d (atom_pos at, atom_pos bt);
+  distance distance_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt);
+  angle angle_2d (atom_pos at, atom_pos bt, atom_pos ct);
+  angle angle_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt, atom_pos ct);
+  angle dihedral_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt, atom_pos ct, atom_pos dt);
+  angle inversion_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt, atom_pos ct, atom_pos dt);
 
 */
 
@@ -50,56 +50,56 @@ extern gboolean field_color;
 extern ColRGBA init_color (int id, int numid);
 
 /*!
-  \fn distance distance_2d (atom * at, atom * bt)
+  \fn distance distance_2d (atom_pos at, atom_pos bt)
 
   \brief distance between atom a and b in 2D
 
-  \param at atom a
-  \param bt atom b
+  \param at coordinates of atom a
+  \param bt coordinates of atom b
 */
-distance distance_2d (atom * at, atom * bt)
+distance distance_2d (atom_pos at, atom_pos bt)
 {
   distance dist;
   dist.pbc = FALSE;
-  dist.x = at -> x - bt -> x;
-  dist.y = at -> y - bt -> y;
+  dist.x = at.x - bt.x;
+  dist.y = at.y - bt.y;
   dist.z = 0.0;
   dist.length = sqrt(dist.x*dist.x + dist.y*dist.y);
   return dist;
 }
 
 /*!
-  \fn distance distance_3d (cell_info * cell, int mdstep, atom * at, atom * bt)
+  \fn distance distance_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt)
 
   \brief distance between atom a and b in 3D
 
   \param cell unit cell
   \param mdstep the MD step
-  \param at atom a
-  \param bt atom b
+  \param at coordinates of atom a
+  \param bt coordinates of atom b
 */
-distance distance_3d (cell_info * cell, int mdstep, atom * at, atom * bt)
+distance distance_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt)
 {
   distance dist;
   double tmp;
   vec3_t dij;
   dist.pbc = FALSE;
-  dist.x = at -> x - bt -> x;
-  dist.y = at -> y - bt -> y;
-  dist.z = at -> z - bt -> z;
+  dist.x = at.x - bt.x;
+  dist.y = at.y - bt.y;
+  dist.z = at.z - bt.z;
   dist.length = sqrt(dist.x*dist.x + dist.y*dist.y + dist.z*dist.z);
   if (cell -> pbc)
   {
     if (cell -> box[mdstep].param[1][0] == 90.0 && cell -> box[mdstep].param[1][1] == 90.0 && cell -> box[mdstep].param[1][2] == 90.0)
     {
-      dij.x = dist.x - round((at -> x-bt -> x)/cell -> box[mdstep].param[0][0]) * cell -> box[mdstep].param[0][0];
-      dij.y = dist.y - round((at -> y-bt -> y)/cell -> box[mdstep].param[0][1]) * cell -> box[mdstep].param[0][1];
-      dij.z = dist.z - round((at -> z-bt -> z)/cell -> box[mdstep].param[0][2]) * cell -> box[mdstep].param[0][2];
+      dij.x = dist.x - round((at.x-bt.x)/cell -> box[mdstep].param[0][0]) * cell -> box[mdstep].param[0][0];
+      dij.y = dist.y - round((at.y-bt.y)/cell -> box[mdstep].param[0][1]) * cell -> box[mdstep].param[0][1];
+      dij.z = dist.z - round((at.z-bt.z)/cell -> box[mdstep].param[0][2]) * cell -> box[mdstep].param[0][2];
     }
     else
     {
-      vec3_t a = vec3(at -> x, at -> y, at -> z);
-      vec3_t b = vec3(bt -> x, bt -> y, bt -> z);
+      vec3_t a = vec3(at.x, at.y, at.z);
+      vec3_t b = vec3(bt.x, bt.y, bt.z);
       vec3_t af = m4_mul_coord (cell -> box[mdstep].cart_to_frac, a);
       vec3_t bf = m4_mul_coord (cell -> box[mdstep].cart_to_frac, b);
       vec3_t nij = v3_sub(af, bf);
@@ -145,15 +145,15 @@ double arc_cos (double val)
 }
 
 /*!
-  \fn angle angle_2d (atom * at, atom * bt, atom * ct)
+  \fn angle angle_2d (atom_pos at, atom_pos bt, atom_pos ct)
 
   \brief angle between atom a, b and c in 2D
 
-  \param at atom a
-  \param bt atom b
-  \param ct atom c
+  \param at coordinates of atom a
+  \param bt coordinates of atom b
+  \param ct coordinates of atom c
 */
-angle angle_2d (atom * at, atom * bt, atom * ct)
+angle angle_2d (atom_pos at, atom_pos bt, atom_pos ct)
 {
   angle theta;
   distance dist_a = distance_2d (bt, at);
@@ -166,17 +166,17 @@ angle angle_2d (atom * at, atom * bt, atom * ct)
 }
 
 /*!
-  \fn angle angle_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct)
+  \fn angle angle_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt, atom_pos ct)
 
   \brief angle between atom a, b and c in 3D
 
   \param cell unit cell
   \param mdstep the MD step
-  \param at atom a
-  \param bt atom b
-  \param ct atom c
+  \param at coordinates of atom a
+  \param bt coordinates of atom b
+  \param ct coordinates of atom c
 */
-angle angle_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct)
+angle angle_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt, atom_pos ct)
 {
   angle theta;
   distance dist_a = distance_3d (cell, mdstep, bt, at);
@@ -190,18 +190,18 @@ angle angle_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct)
 }
 
 /*!
-  \fn angle dihedral_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct, atom * dt)
+  \fn angle dihedral_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt, atom_pos ct, atom_pos dt)
 
   \brief dihedral between atom a, b, c and d in 3D
 
   \param cell unit cell
   \param mdstep the MD step
-  \param at atom a
-  \param bt atom b
-  \param ct atom c
-  \param dt atom d
+  \param at coordinates of atom a
+  \param bt coordinates of atom b
+  \param ct coordinates of atom c
+  \param dt coordinates of atom d
 */
-angle dihedral_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct, atom * dt)
+angle dihedral_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt, atom_pos ct, atom_pos dt)
 {
   angle phi;
   distance dist_a = distance_3d (cell, mdstep, at, bt);
@@ -226,18 +226,18 @@ angle dihedral_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct
 }
 
 /*!
-  \fn angle inversion_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct, atom * dt)
+  \fn angle inversion_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt, atom_pos ct, atom_pos dt)
 
   \brief inversion angle between atom a, b, c and d in 3D
 
   \param cell unit cell
   \param mdstep the MD step
-  \param at atom a
-  \param bt atom b
-  \param ct atom c
-  \param dt atom d
+  \param at coordinates of atom a
+  \param bt coordinates of atom b
+  \param ct coordinates of atom c
+  \param dt coordinates of atom d
 */
-angle inversion_3d (cell_info * cell, int mdstep, atom * at, atom * bt, atom * ct, atom * dt)
+angle inversion_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt, atom_pos ct, atom_pos dt)
 {
   angle inv;
   distance dist_a = distance_3d (cell, mdstep, bt, at);
@@ -30,7 +30,6 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 *
 * List of functions:
 
-  int find_bond_in_bonds (project * this_proj, int i, int j, int b, int id);
   int find_selected_bond (project * this_proj, int id);
   int find_selected_atom (project * this_proj, int id);
   int num_bonds (int i);
@@ -67,76 +66,25 @@ extern void update_label_selection (glwin * view, int pi);
 extern int selected_aspec;
 extern int get_to_be_selected (glwin * view);
 
-/*!
-  \fn int find_bond_in_bonds (project * this_proj, int i, int j, int b, int id)
-
-  \brief Find for a bond ID in the bond list using the atoms in the bond
-
-  \param this_proj the target project
-  \param i id tracker
-  \param j the MD step
-  \param b 0 = normal, 1 = clones
-  \param id the id-th visible bond to find
-*/
-int find_bond_in_bonds (project * this_proj, int i, int j, int b, int id)
-{
-  int k, l, m;
-  for (k=0; k < this_proj -> modelgl -> bonds[j][b]; k++)
-  {
-    l = this_proj -> modelgl -> bondid[j][b][k][0];
-    m = this_proj -> modelgl -> bondid[j][b][k][1];
-    if (this_proj -> atoms[j][l].show[b]) i ++;
-    if (i == id) return k;
-    if (b)
-    {
-      if (this_proj -> atoms[j][l].show[b]) i ++;
-      if (i == id) return k;
-    }
-    if (this_proj -> atoms[j][m].show[b]) i ++;
-    if (i == id) return k;
-    if (b)
-    {
-      if (this_proj -> atoms[j][m].show[b]) i ++;
-      if (i == id) return k;
-    }
-  }
-  return -i;
-}
-
 /*!
   \fn int find_selected_bond (project * this_proj, int id)
 
   \brief find the selected bond based of the picked color id
 
   \param this_proj the target project
-  \param id the id-th visible bond to find
+  \param id the pick id of the bond
 */
 int find_selected_bond (project * this_proj, int id)
 {
-  int i, j, k;
-
-  i = this_proj -> modelgl -> clones_to_be_picked - 1;
-  j = this_proj -> modelgl -> anim -> last -> img -> step;
-  k = find_bond_in_bonds (this_proj, i, j, 0, id);
-  if (k < 0 && this_proj -> modelgl -> anim -> last -> img -> draw_clones)
-  {
-    k = find_bond_in_bonds (this_proj, -k, j, 1, id);
-    if (k < 0)
-    {
-      return -1;
-    }
-    else
-    {
-      return k;
-    }
-  }
-  else if (k < 0)
+  glwin * view = this_proj -> modelgl;
+  // 2 pick ids per bond, 4 pick ids per clone bond
+  if (id < view -> bonds_to_be_picked)
   {
-    return -1;
+    return (id - view -> clones_to_be_picked) / 2;
   }
   else
   {
-    return k;
+    return (id - view -> bonds_to_be_picked) / 4;
   }
 }
 
@@ -146,31 +94,17 @@ int find_selected_bond (project * this_proj, int id)
   \brief find the selected atom based of the picked color id
 
   \param this_proj the target project
-  \param id the id-th visible atom or clone to find
+  \param id the pick id of the atom or clone
 */
 int find_selected_atom (project * this_proj, int id)
 {
-  int i, j, k, l, m;
-  i = -1;
-  j = this_proj -> modelgl -> anim -> last -> img -> step;
-  for (k=0; k<this_proj -> natomes; k++)
-  {
-    if (this_proj -> atoms[j][k].show[0]) i++;
-    if (i == id) return k;
-  }
-  if (this_proj -> modelgl -> anim -> last -> img -> draw_clones)
-  {
-    for (k=0; k < this_proj -> modelgl -> bonds[j][1]; k++)
-    {
-      l = this_proj -> modelgl -> bondid[step][1][k][0];
-      m = this_proj -> modelgl -> bondid[step][1][k][1];
-      if (this_proj -> atoms[j][l].show[1]) i++;
-      if (i == id) return l;
-      if (this_proj -> atoms[j][m].show[1]) i++;
-      if (i == id) return m;
-    }
-  }
-  return -1;
+  glwin * view = this_proj -> modelgl;
+  int i, j;
+  if (id < view -> atoms_to_be_picked) return id;
+  // 2 pick ids per clone bond, one for each clone
+  i = (id - view -> atoms_to_be_picked) / 2;
+  j = view -> anim -> last -> img -> step;
+  return view -> bondid[j][1][i][(id - view -> atoms_to_be_picked) % 2];
 }
 
 /*!
@@ -589,7 +523,7 @@ void process_selection (project * this_proj, glwin * view, int id, int ac, int p
 */
 void process_the_hits (glwin * view, gint event_button, double ptx, double pty)
 {
-  int i, j, k, l, m, n, o, p, q;
+  int j, k, l, m, n, o, p, q;
   view -> picked = FALSE;
   GLubyte pixel[4];
   GLint viewport[4];
@@ -598,16 +532,9 @@ void process_the_hits (glwin * view, gint event_button, double ptx, double pty)
   glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
   glReadPixels (scale * view -> mouseX, viewport[3] - scale * view -> mouseY, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
 
-  int picked_id = pixel[0] + 256*pixel[1] + 256*256*pixel[2];
-  for (i=0; i<view -> to_be_picked; i++)
-  {
-    if (picked_id == view -> color_to_pick[i])
-    {
-      j = i;
-      view -> picked = TRUE;
-      break;
-    }
-  }
+  // The pick colour is the pick id + 1, black being the background
+  j = pixel[0] + 256*pixel[1] + 256*256*pixel[2] - 1;
+  view -> picked = (j > -1 && j < view -> to_be_picked);
   to_pop.action = 0;
   to_pop.x = 0.0;
   to_pop.y = 0.0;
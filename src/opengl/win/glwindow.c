@@ -117,6 +117,7 @@ extern int is_labelled;
 extern G_MODULE_EXPORT void on_create_new_project (GtkWidget * widg, gpointer data);
 extern gchar * action_atoms[3];
 extern int get_selection_type (glwin * view);
+extern void create_batch_model (project * this_proj);
 extern GtkWidget * shortcuts_window (int sections, int group_by_section[sections], int groups, int shortcut_by_group[groups],
                                      gchar * section_names[sections], gchar * group_names[groups], shortcuts shortcs[]);
 
@@ -1536,7 +1537,11 @@ void prep_model (int p)
   gboolean adv_bonding[2];
   if (this_proj -> modelgl == NULL)
   {
-    if (create_3d_model (p, TRUE))
+    if (atomes_batch)
+    {
+      create_batch_model (this_proj);
+    }
+    else if (create_3d_model (p, TRUE))
     {
       /*GtkWidget * dummy = create_menu_item (FALSE, "Dummy");
       gtk_menu_shell_append ((GtkMenuShell *)this_proj -> modelgl -> menu_bar, dummy);
@@ -1552,13 +1557,16 @@ void prep_model (int p)
       active_glwin -> ogl_box_axis[0] = g_malloc0 (OGL_BOX*sizeof*active_glwin -> ogl_box_axis[0]);
       active_glwin -> ogl_box_axis[1] = g_malloc0 (OGL_AXIS*sizeof*active_glwin -> ogl_box_axis[1]);
 #endif
-      prepare_opengl_menu_bar (active_glwin);
+      if (! atomes_batch)
+      {
+        prepare_opengl_menu_bar (active_glwin);
 #ifdef GTK3
-      GtkWidget * menu = gtk_menu_bar_new ();
-      gtk_menu_shell_append ((GtkMenuShell *)menu, menu_item_new_with_submenu ("Help", TRUE, menu_help(active_glwin, 0)));
-      add_box_child_end (active_glwin -> menu_box, menu, FALSE, FALSE, 0);
-      show_the_widgets (menu);
+        GtkWidget * menu = gtk_menu_bar_new ();
+        gtk_menu_shell_append ((GtkMenuShell *)menu, menu_item_new_with_submenu ("Help", TRUE, menu_help(active_glwin, 0)));
+        add_box_child_end (active_glwin -> menu_box, menu, FALSE, FALSE, 0);
+        show_the_widgets (menu);
 #endif
+      }
       if (reading_input)
       {
         adv_bonding[0] = (active_project -> natomes > ATOM_LIMIT) ? 0 : tmp_adv_bonding[0];
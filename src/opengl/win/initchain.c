@@ -76,7 +76,8 @@ void send_chains_opengl_ (int * st, int * ta, int * ri, int nchain[* ta])
 */
 void send_atom_chains_id_opengl_ (int * st, int * at, int * ta, int * num, int nchain[* num])
 {
-  if (nchain != NULL)
+  // Not kept when all MD steps share the same atoms, see 'pos_window.c'
+  if (nchain != NULL && ! active_project -> pos_win)
   {
     int i;
     active_project -> atoms[* st][* at].chain[* ta - 1] = allocint(* num + 1);
@@ -61,6 +61,7 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 #include "color_box.h"
 #include "glwindow.h"
 #include "glview.h"
+#include "project.h"
 
 extern GtkWidget * coord_menu (glwin * view);
 extern cairo_surface_t * col_surface (double r, double g, double b, int x, int y);
@@ -731,7 +732,7 @@ void send_coord_opengl_ (int * id, int * num, int * cmin, int * cmax, int * nt,
       {
         for (j=0; j < active_project -> natomes; j++, k++)
         {
-          active_project -> atoms[i][j].coord[* id] = coord[k] - 1;
+          set_step_coord (active_project, i, j, * id, coord[k] - 1);
         }
       }
     }
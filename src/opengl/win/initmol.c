@@ -59,6 +59,7 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 #include "color_box.h"
 #include "glwindow.h"
 #include "initcoord.h"
+#include "project.h"
 
 typedef struct search_molecule search_molecule;
 struct search_molecule
@@ -510,7 +511,7 @@ void setup_molecules_ (int * stepid)
     for (m=0; m<l; m++)
     {
       n = tmp_mol -> atoms[m] - 1;
-      active_project -> atoms[i][n].coord[3] = k;
+      set_step_coord (active_project, i, n, 3, k);
     }
     duplicate_molecule (& active_project -> modelfc -> mols[i][k], tmp_mol);
     active_project -> modelfc -> mols[i][k].id = k;
@@ -560,6 +561,6 @@ void setup_fragments_ (int * sid, int coord[active_project -> natomes])
   int i;
   for (i=0; i < active_project -> natomes; i++)
   {
-    active_project -> atoms[* sid-1][i].coord[2] = coord[i] - 1;
+    set_step_coord (active_project, * sid-1, i, 2, coord[i] - 1);
   }
 }
@@ -74,7 +74,8 @@ void send_rings_opengl_ (int * id, int * st, int * ta, int * ri, int nring[* ta+
 */
 void send_atom_rings_id_opengl_ (int * st, int * at, int * id, int * ta, int * num, int ring[* num])
 {
-  if (ring != NULL)
+  // Not kept when all MD steps share the same atoms, see 'pos_window.c'
+  if (ring != NULL && ! active_project -> pos_win)
   {
     int i;
     active_project -> atoms[* st][* at].rings[* id][* ta] = allocint(* num + 1);
@@ -745,9 +745,9 @@ G_MODULE_EXPORT void add_object (GtkWidget * widg, gpointer data)
     int i;
     for (i=0; i<object -> atoms; i++)
     {
-      object -> at_list[i].x += opengl_project -> modelgl -> insert_coords.x + object -> dim*ul.a;
-      object -> at_list[i].y += opengl_project -> modelgl -> insert_coords.y + object -> dim*ul.b;
-      object -> at_list[i].z += opengl_project -> modelgl -> insert_coords.z + object -> dim*ul.c;
+      object -> at_pos[i].x += opengl_project -> modelgl -> insert_coords.x + object -> dim*ul.a;
+      object -> at_pos[i].y += opengl_project -> modelgl -> insert_coords.y + object -> dim*ul.b;
+      object -> at_pos[i].z += opengl_project -> modelgl -> insert_coords.z + object -> dim*ul.c;
     }
     allocate_todo (insert_search, 1);
     insert_search -> todo[0] = 1;
@@ -2137,15 +2137,15 @@ void create_new_project_using_data (atom_selection * selection)
       k = tmp -> id;
       active_project -> atoms[i][j].id = j;
       active_project -> atoms[i][j].sp = pos_sp[tmp -> sp];
-      active_project -> atoms[i][j].x = opengl_project -> atoms[i][k].x;
-      active_project -> atoms[i][j].y = opengl_project -> atoms[i][k].y;
-      active_project -> atoms[i][j].z = opengl_project -> atoms[i][k].z;
+      active_project -> pos[i][0][j] = opengl_project -> pos[i][0][k];
+      active_project -> pos[i][1][j] = opengl_project -> pos[i][1][k];
+      active_project -> pos[i][2][j] = opengl_project -> pos[i][2][k];
       active_project -> atoms[i][j].show[0] = TRUE;
       active_project -> atoms[i][j].show[1] = TRUE;
       active_project -> atoms[i][j].label[0] = FALSE;
       active_project -> atoms[i][j].label[1] = FALSE;
       active_project -> atoms[i][j].pick[0] = FALSE;
-      active_project -> atoms[i][j].cloned = FALSE;
+      set_step_clone (active_project, i, j, FALSE);
       // Next line for style, to initialize style use: NONE
       active_project -> atoms[i][j].style = opengl_project -> atoms[i][k].style;
       if (tmp -> next != NULL) tmp = tmp -> next;
@@ -3729,7 +3729,7 @@ void popup_selection (glwin * view, double ptx, double pty, int spe, int mmod, i
     btoid.a = opengl_project -> atoms[s][bti].coord[0];
     btoid.b = opengl_project -> atoms[s][bti].coord[1];
     selected_bspec = opengl_project -> atoms[s][bti].sp;
-    distance dist = distance_3d (& opengl_project -> cell, (opengl_project -> cell.npt) ? s : 0, & opengl_project -> atoms[s][ati], & opengl_project -> atoms[s][bti]);
+    distance dist = distance_3d (& opengl_project -> cell, (opengl_project -> cell.npt) ? s : 0, get_atom_pos (opengl_project, s, ati), get_atom_pos (opengl_project, s, bti));
     if (aoc == 0)
     {
       str = g_strdup_printf ("%s<sub>%d</sub> - %s<sub>%d</sub>",
@@ -3789,7 +3789,7 @@ void popup_selection (glwin * view, double ptx, double pty, int spe, int mmod, i
 #endif
     g_free (str);
     str = g_strdup_printf ("\tx : <b>%f</b>\n\ty : <b>%f</b>\n\tz : <b>%f</b>",
-                           opengl_project -> atoms[s][ati].x, opengl_project -> atoms[s][ati].y, opengl_project -> atoms[s][ati].z);
+                           opengl_project -> pos[s][0][ati], opengl_project -> pos[s][1][ati], opengl_project -> pos[s][2][ati]);
 #ifdef GTK4
     append_opengl_item (view, gmenu, str, "xyz", 1, 0, NULL, IMG_NONE, NULL, FALSE, NULL, NULL, FALSE, FALSE, FALSE, TRUE);
 #else
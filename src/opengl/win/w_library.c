@@ -508,15 +508,15 @@ int sml_preview (const char * filetoread)
       if (lot_node == NULL) return clean_xml_data (doc, reader);
       if (g_strcmp0 ("x",(char *)xspec -> name) == 0)
       {
-        lib_proj -> atoms[0][i].x = string_to_double ((gpointer)xmlNodeGetContent(lot_node));
+        lib_proj -> pos[0][0][i] = string_to_double ((gpointer)xmlNodeGetContent(lot_node));
       }
       else if (g_strcmp0 ("y",(char *)xspec -> name) == 0)
       {
-        lib_proj -> atoms[0][i].y = string_to_double ((gpointer)xmlNodeGetContent(lot_node));
+        lib_proj -> pos[0][1][i] = string_to_double ((gpointer)xmlNodeGetContent(lot_node));
       }
       else if (g_strcmp0 ("z",(char *)xspec -> name) == 0)
       {
-        lib_proj -> atoms[0][i].z = string_to_double ((gpointer)xmlNodeGetContent(lot_node));
+        lib_proj -> pos[0][2][i] = string_to_double ((gpointer)xmlNodeGetContent(lot_node));
       }
       else if (g_strcmp0 ("sp",(char *)xspec -> name) == 0)
       {
@@ -118,7 +118,7 @@ void fill_bond_model_row (int p, int a, int b, GtkTreeStore * store)
   at = & this_proj -> atoms[s][a];
   bt = & this_proj -> atoms[s][b];
   bond_id ++;
-  dist = distance_3d (& this_proj -> cell, (this_proj -> cell.npt) ? s : 0, at, bt);
+  dist = distance_3d (& this_proj -> cell, (this_proj -> cell.npt) ? s : 0, get_atom_pos (this_proj, s, a), get_atom_pos (this_proj, s, b));
   str_a = g_strdup_printf("%s<sub>%d</sub>", this_proj -> chemistry -> label[at -> sp], a+1);
   str_b = g_strdup_printf("%s<sub>%d</sub>", this_proj -> chemistry -> label[bt -> sp], b+1);
   str_c = g_strdup_printf("%.3lf", dist.length);
@@ -168,7 +168,7 @@ void fill_angle_model_row (int p, int a, int b, int c, GtkTreeStore * store)
   bt = & this_proj -> atoms[s][b];
   ct = & this_proj -> atoms[s][c];
   angle_id ++;
-  theta = angle_3d (& this_proj -> cell, (this_proj -> cell.npt) ? s : 0, at, bt, ct);
+  theta = angle_3d (& this_proj -> cell, (this_proj -> cell.npt) ? s : 0, get_atom_pos (this_proj, s, a), get_atom_pos (this_proj, s, b), get_atom_pos (this_proj, s, c));
   str_a = g_strdup_printf("%s<sub>%d</sub>", this_proj -> chemistry -> label[at -> sp], a+1);
   str_b = g_strdup_printf("%s<sub>%d</sub>", this_proj -> chemistry -> label[bt -> sp], b+1);
   str_c = g_strdup_printf("%s<sub>%d</sub>", this_proj -> chemistry -> label[ct -> sp], c+1);
@@ -224,7 +224,8 @@ void fill_dihedral_model_row (int p, int a, int b, int c, int d, GtkTreeStore *
   ct = & this_proj -> atoms[s][c];
   dt = & this_proj -> atoms[s][d];
   dihedral_id ++;
-  phi = dihedral_3d (& this_proj -> cell, (this_proj -> cell.npt) ? s : 0, at, bt, ct, dt);
+  phi = dihedral_3d (& this_proj -> cell, (this_proj -> cell.npt) ? s : 0,
+                     get_atom_pos (this_proj, s, a), get_atom_pos (this_proj, s, b), get_atom_pos (this_proj, s, c), get_atom_pos (this_proj, s, d));
   str_a = g_strdup_printf("%s<sub>%d</sub>", this_proj -> chemistry -> label[at -> sp], a+1);
   str_b = g_strdup_printf("%s<sub>%d</sub>", this_proj -> chemistry -> label[bt -> sp], b+1);
   str_c = g_strdup_printf("%s<sub>%d</sub>", this_proj -> chemistry -> label[ct -> sp], c+1);
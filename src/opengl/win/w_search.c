@@ -556,6 +556,7 @@ void adjust_object_to_move (project * this_proj, atom_search * asearch, int mv,
       if (object -> ibonds) g_free (object -> ibonds);
       if (object -> baryc) g_free (object -> baryc);
       if (object -> at_list) g_free (object -> at_list);
+      if (object -> at_pos) g_free (object -> at_pos);
       if (object -> coord) g_free (object -> coord);
       if (object -> bcid) g_free (object -> bcid);
       object -> atoms = object -> bonds = 0;
@@ -36,7 +36,7 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
   double get_sphere_caps_volume (double dab, double rad, double rbd);
   double sphere_volume (double rad);
   double get_atoms_volume (project * this_proj, int rid, int sid, int gid, int gcid);
-  double molecular_volume (int nats, atom * ats_vol, double baryc[3], double * rvdws, double a_ang, double b_ang, double c_ang);
+  double molecular_volume (int nats, atom * ats_vol, atom_pos * pos_vol, double baryc[3], double * rvdws, double a_ang, double b_ang, double c_ang);
   double get_atoms_box (project * this_proj, int rid, int sid, int geo, int gid);
 
   void clean_volumes_data (glwin * view);
@@ -208,7 +208,7 @@ double get_atoms_volume (project * this_proj, int rid, int sid, int gid, int gci
       o = this_proj -> atoms[sid][n].sp;
       if (gid < 0 || this_proj -> atoms[sid][l].coord[gid] == gcid)
       {
-        dist = distance_3d (& this_proj -> cell, (this_proj -> cell.npt) ? sid : 0, & this_proj -> atoms[sid][l], & this_proj -> atoms[sid][n]);
+        dist = distance_3d (& this_proj -> cell, (this_proj -> cell.npt) ? sid : 0, get_atom_pos (this_proj, sid, l), get_atom_pos (this_proj, sid, n));
         if (dist.length < rvdws[m]+rvdws[o]) cap_vol += get_sphere_caps_volume (dist.length, rvdws[m], rvdws[o]);
       }
     }
@@ -254,19 +254,20 @@ double get_atoms_volume (project * this_proj, int rid, int sid, int gid, int gci
 double vamin[3], vamax[3];
 
 /*!
-  \fn double molecular_volume (int nats, atom * ats_vol, double baryc[3], double * rvdws, double a_ang, double b_ang, double c_ang)
+  \fn double molecular_volume (int nats, atom * ats_vol, atom_pos * pos_vol, double baryc[3], double * rvdws, double a_ang, double b_ang, double c_ang)
 
   \brief compute volume
 
   \param nats number of atoms
   \param ats_vol the list of atom(s)
+  \param pos_vol the coordinates of the atom(s)
   \param baryc barycenter of the atomic coordinates
   \param rvdws the list of atomic radius (ii)
   \param a_ang x axis rotation angle
   \param b_ang y axis rotation angle
   \param c_ang z axis rotation angle
 */
-double molecular_volume (int nats, atom * ats_vol, double baryc[3], double * rvdws, double a_ang, double b_ang, double c_ang)
+double molecular_volume (int nats, atom * ats_vol, atom_pos * pos_vol, double baryc[3], double * rvdws, double a_ang, double b_ang, double c_ang)
 {
   double paral[3][3];
   mat4_t rot;
@@ -277,7 +278,7 @@ double molecular_volume (int nats, atom * ats_vol, double baryc[3], double * rvd
   for (i=0; i<nats; i++)
   {
     j = ats_vol[i].sp;
-    c_old = vec3(ats_vol[i].x+baryc[0], ats_vol[i].y+baryc[1], ats_vol[i].z+baryc[2]);
+    c_old = vec3(pos_vol[i].x+baryc[0], pos_vol[i].y+baryc[1], pos_vol[i].z+baryc[2]);
     c_new = m4_mul_pos (rot, c_old);
     if (! k)
     {
@@ -338,6 +339,7 @@ double get_atoms_box (project * this_proj, int rid, int sid, int geo, int gid)
   int finess = pow (10, this_proj -> modelgl -> volume_win -> angp);
   int nats;
   atom * ats_vol = NULL;
+  atom_pos * pos_vol = NULL;
   atomic_object * object = NULL;
   gboolean rtmp;
   double * baryc;
@@ -353,10 +355,13 @@ double get_atoms_box (project * this_proj, int rid, int sid, int geo, int gid)
       nats = object -> atoms;
       baryc = duplicate_double (3, object -> baryc);
       ats_vol = object -> at_list;
+      pos_vol = object -> at_pos;
       break;
     default:
       nats = this_proj -> natomes;
       ats_vol = this_proj -> atoms[sid];
+      pos_vol = g_malloc (nats*sizeof*pos_vol);
+      for (i=0; i<nats; i++) pos_vol[i] = get_atom_pos (this_proj, sid, i);
       baryc = allocdouble (3);
       break;
   }
@@ -367,7 +372,7 @@ double get_atoms_box (project * this_proj, int rid, int sid, int geo, int gid)
     {
       for (c_ang=0; c_ang < 90*finess; c_ang ++)
       {
-        val = molecular_volume (nats, ats_vol, baryc, rvdws, a_ang/finess, b_ang/finess, c_ang/finess);
+        val = molecular_volume (nats, ats_vol, pos_vol, baryc, rvdws, a_ang/finess, b_ang/finess, c_ang/finess);
         if (a_ang == 0 && b_ang == 0 && c_ang == 0)
         {
           vbl = val;
@@ -428,6 +433,7 @@ double get_atoms_box (project * this_proj, int rid, int sid, int geo, int gid)
     }
   }
   ats_vol = NULL;
+  if (geo != 2) g_free (pos_vol);
   g_free (rvdws);
   g_free (baryc);
   if (geo == 2) g_free (object);
@@ -0,0 +1,383 @@
+/* This file is part of the 'atomes' software
+
+'atomes' is free software: you can redistribute it and/or modify it under the terms
+of the GNU Affero General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+'atomes' is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License along with 'atomes'.
+If not, see <https://www.gnu.org/licenses/>
+
+Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
+
+/*!
+* @file profile.c
+* @short Named timers and counters to profile the program \n
+         Export as JSON summary or Chrome trace file
+* @author Sébastien Le Roux <sebastien.leroux@ipcms.unistra.fr>
+*/
+
+/*
+* This file: 'profile.c'
+*
+* Contains:
+*
+
+ - Named timers and counters to profile the program
+ - Export of the results as JSON summary or Chrome trace file
+
+ Profiling is enabled using environment variables:
+  - ATOMES_PROFILE=file: JSON summary (calls, total, min, max time of each timer, value of each counter)
+  - ATOMES_TRACE=file: Chrome trace (chrome://tracing, Perfetto), one event per timer call
+
+ The files are written when the program quits.
+
+*
+* List of functions:
+
+  void init_profiling ();
+  void profile_start (struct timespec * start);
+  void profile_stop (const gchar * name, struct timespec * start);
+  void profile_add (const gchar * name, struct timespec start, struct timespec stop);
+  void profile_count (const gchar * name, gint64 value);
+  void save_profiling ();
+
+  static void profile_event_add (const gchar * name, gboolean counter, gint64 start, gint64 value);
+  static void json_string (FILE * fp, const gchar * str);
+  static void save_profile_summary (const gchar * filename);
+  static void save_profile_trace (const gchar * filename);
+
+  static guint profile_thread ();
+
+  static gint64 profile_time (struct timespec time);
+
+*/
+
+#include "global.h"
+
+#define PROFILE_MAX_EVENTS 2000000
+
+/*! \typedef profile_timer
+
+  \brief timer statistics
+*/
+typedef struct {
+  const gchar * name;        /*!< Timer name */
+  gint64 calls;              /*!< Number of calls */
+  gint64 total;              /*!< Total time, in ns */
+  gint64 min;                /*!< Shortest call, in ns */
+  gint64 max;                /*!< Longest call, in ns */
+} profile_timer;
+
+/*! \typedef profile_event
+
+  \brief trace event, timer call or counter update
+*/
+typedef struct {
+  const gchar * name;        /*!< Event name */
+  gboolean counter;          /*!< Counter (TRUE) or timer (FALSE) */
+  gint64 start;              /*!< Timer start or counter update, in ns since profiling started */
+  gint64 value;              /*!< Timer duration in ns, or counter value */
+  guint thread;              /*!< Thread id */
+} profile_event;
+
+gboolean profiling = FALSE;
+
+static gchar * profile_summary = NULL;
+static gchar * profile_trace = NULL;
+static GMutex profile_lock;
+static GHashTable * profile_timers = NULL;
+static GHashTable * profile_counters = NULL;
+static GHashTable * profile_threads = NULL;
+static GArray * profile_events = NULL;
+static struct timespec profile_origin;
+
+/*!
+  \fn void init_profiling ()
+
+  \brief enable profiling if requested by the environment
+*/
+void init_profiling ()
+{
+  const gchar * str = g_getenv ("ATOMES_PROFILE");
+  if (str && * str) profile_summary = g_strdup (str);
+  str = g_getenv ("ATOMES_TRACE");
+  if (str && * str) profile_trace = g_strdup (str);
+  if (! profile_summary && ! profile_trace) return;
+  profile_timers = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+  profile_counters = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+  profile_threads = g_hash_table_new (g_direct_hash, g_direct_equal);
+  if (profile_trace) profile_events = g_array_new (FALSE, FALSE, sizeof(profile_event));
+  clock_gettime (CLOCK_MONOTONIC, & profile_origin);
+  profiling = TRUE;
+}
+
+/*!
+  \fn static gint64 profile_time (struct timespec time)
+
+  \brief time since profiling started, in ns
+
+  \param time the time to convert
+*/
+static gint64 profile_time (struct timespec time)
+{
+  return (gint64)(time.tv_sec - profile_origin.tv_sec)*1000000000 + (gint64)(time.tv_nsec - profile_origin.tv_nsec);
+}
+
+/*!
+  \fn static guint profile_thread ()
+
+  \brief small id of the calling thread, 0 for the first thread to record something
+*/
+static guint profile_thread ()
+{
+  gpointer thread = g_thread_self ();
+  gpointer tid;
+  if (! g_hash_table_lookup_extended (profile_threads, thread, NULL, & tid))
+  {
+    tid = GUINT_TO_POINTER(g_hash_table_size (profile_threads));
+    g_hash_table_insert (profile_threads, thread, tid);
+  }
+  return GPOINTER_TO_UINT(tid);
+}
+
+/*!
+  \fn static void profile_event_add (const gchar * name, gboolean counter, gint64 start, gint64 value)
+
+  \brief record a trace event, the profile lock must be held
+
+  \param name the event name
+  \param counter counter (TRUE) or timer (FALSE)
+  \param start the timer start or counter update time
+  \param value the timer duration or counter value
+*/
+static void profile_event_add (const gchar * name, gboolean counter, gint64 start, gint64 value)
+{
+  profile_event event;
+  if (! profile_events || profile_events -> len >= PROFILE_MAX_EVENTS) return;
+  event.name = name;
+  event.counter = counter;
+  event.start = start;
+  event.value = value;
+  event.thread = profile_thread ();
+  g_array_append_val (profile_events, event);
+}
+
+/*!
+  \fn void profile_add (const gchar * name, struct timespec start, struct timespec stop)
+
+  \brief record a call to a named timer
+
+  \param name the timer name
+  \param start the initial time
+  \param stop the final time
+*/
+void profile_add (const gchar * name, struct timespec start, struct timespec stop)
+{
+  if (! profiling) return;
+  const gchar * key = g_intern_string (name);
+  gint64 t_start = profile_time (start);
+  gint64 t_length = profile_time (stop) - t_start;
+  g_mutex_lock (& profile_lock);
+  profile_timer * timer = g_hash_table_lookup (profile_timers, key);
+  if (! timer)
+  {
+    timer = g_malloc0 (sizeof*timer);
+    timer -> name = key;
+    timer -> min = t_length;
+    g_hash_table_insert (profile_timers, (gpointer)key, timer);
+  }
+  timer -> calls ++;
+  timer -> total += t_length;
+  timer -> min = min (timer -> min, t_length);
+  timer -> max = max (timer -> max, t_length);
+  profile_event_add (key, FALSE, t_start, t_length);
+  g_mutex_unlock (& profile_lock);
+}
+
+/*!
+  \fn void profile_start (struct timespec * start)
+
+  \brief start a timer, if profiling is enabled
+
+  \param start the initial time to set
+*/
+void profile_start (struct timespec * start)
+{
+  if (profiling) clock_gettime (CLOCK_MONOTONIC, start);
+}
+
+/*!
+  \fn void profile_stop (const gchar * name, struct timespec * start)
+
+  \brief stop a timer started with 'profile_start' and record the call
+
+  \param name the timer name
+  \param start the initial time
+*/
+void profile_stop (const gchar * name, struct timespec * start)
+{
+  struct timespec stop;
+  if (! profiling) return;
+  clock_gettime (CLOCK_MONOTONIC, & stop);
+  profile_add (name, * start, stop);
+}
+
+/*!
+  \fn void profile_count (const gchar * name, gint64 value)
+
+  \brief add to a named counter
+
+  \param name the counter name
+  \param value the value to add
+*/
+void profile_count (const gchar * name, gint64 value)
+{
+  if (! profiling) return;
+  const gchar * key = g_intern_string (name);
+  struct timespec now;
+  clock_gettime (CLOCK_MONOTONIC, & now);
+  g_mutex_lock (& profile_lock);
+  gint64 * counter = g_hash_table_lookup (profile_counters, key);
+  if (! counter)
+  {
+    counter = g_malloc0 (sizeof*counter);
+    g_hash_table_insert (profile_counters, (gpointer)key, counter);
+  }
+  * counter += value;
+  profile_event_add (key, TRUE, profile_time (now), * counter);
+  g_mutex_unlock (& profile_lock);
+}
+
+/*!
+  \fn static void json_string (FILE * fp, const gchar * str)
+
+  \brief write a JSON string
+
+  \param fp the file pointer
+  \param str the string to write
+*/
+static void json_string (FILE * fp, const gchar * str)
+{
+  const gchar * c;
+  fputc ('"', fp);
+  for (c=str; * c; c++)
+  {
+    if (* c == '"' || * c == '\\')
+    {
+      fprintf (fp, "\\%c", * c);
+    }
+    else if ((guchar)* c < 0x20)
+    {
+      fprintf (fp, "\\u%04x", (guchar)* c);
+    }
+    else
+    {
+      fputc (* c, fp);
+    }
+  }
+  fputc ('"', fp);
+}
+
+/*!
+  \fn static void save_profile_summary (const gchar * filename)
+
+  \brief save the timers and counters statistics, JSON format
+
+  \param filename the file name
+*/
+static void save_profile_summary (const gchar * filename)
+{
+  GHashTableIter iter;
+  gpointer key, val;
+  profile_timer * timer;
+  gboolean first = TRUE;
+  FILE * fp = fopen (filename, "w");
+  if (! fp)
+  {
+    g_warning ("Impossible to write profiling summary: %s", filename);
+    return;
+  }
+  fprintf (fp, "{\n  \"timers\": [");
+  g_hash_table_iter_init (& iter, profile_timers);
+  while (g_hash_table_iter_next (& iter, & key, & val))
+  {
+    timer = (profile_timer *)val;
+    fprintf (fp, "%s\n    {\"name\": ", (first) ? "" : ",");
+    json_string (fp, timer -> name);
+    fprintf (fp, ", \"calls\": %" G_GINT64_FORMAT ", \"total_ms\": %.6f, \"mean_ms\": %.6f, \"min_ms\": %.6f, \"max_ms\": %.6f}",
+             timer -> calls, timer -> total*1e-6, timer -> total*1e-6/timer -> calls, timer -> min*1e-6, timer -> max*1e-6);
+    first = FALSE;
+  }
+  fprintf (fp, "\n  ],\n  \"counters\": [");
+  first = TRUE;
+  g_hash_table_iter_init (& iter, profile_counters);
+  while (g_hash_table_iter_next (& iter, & key, & val))
+  {
+    fprintf (fp, "%s\n    {\"name\": ", (first) ? "" : ",");
+    json_string (fp, (const gchar *)key);
+    fprintf (fp, ", \"value\": %" G_GINT64_FORMAT "}", * (gint64 *)val);
+    first = FALSE;
+  }
+  fprintf (fp, "\n  ]\n}\n");
+  fclose (fp);
+}
+
+/*!
+  \fn static void save_profile_trace (const gchar * filename)
+
+  \brief save the timer and counter events, Chrome trace event format
+
+  \param filename the file name
+*/
+static void save_profile_trace (const gchar * filename)
+{
+  guint i;
+  profile_event * event;
+  FILE * fp = fopen (filename, "w");
+  if (! fp)
+  {
+    g_warning ("Impossible to write profiling trace: %s", filename);
+    return;
+  }
+  fprintf (fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+  for (i=0; i<profile_events -> len; i++)
+  {
+    event = & g_array_index (profile_events, profile_event, i);
+    fprintf (fp, "%s\n{\"name\": ", (i) ? "," : "");
+    json_string (fp, event -> name);
+    if (event -> counter)
+    {
+      fprintf (fp, ", \"ph\": \"C\", \"ts\": %.3f, \"pid\": 1, \"tid\": %u, \"args\": {\"value\": %" G_GINT64_FORMAT "}}",
+               event -> start*1e-3, event -> thread, event -> value);
+    }
+    else
+    {
+      fprintf (fp, ", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %u}",
+               event -> start*1e-3, event -> value*1e-3, event -> thread);
+    }
+  }
+  fprintf (fp, "\n]}\n");
+  fclose (fp);
+  if (profile_events -> len >= PROFILE_MAX_EVENTS)
+  {
+    g_warning ("Profiling trace limited to the first %d events", PROFILE_MAX_EVENTS);
+  }
+}
+
+/*!
+  \fn void save_profiling ()
+
+  \brief save the profiling results, if profiling is enabled
+*/
+void save_profiling ()
+{
+  if (! profiling) return;
+  g_mutex_lock (& profile_lock);
+  if (profile_summary) save_profile_summary (profile_summary);
+  if (profile_trace) save_profile_trace (profile_trace);
+  g_mutex_unlock (& profile_lock);
+}
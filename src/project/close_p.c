@@ -180,6 +180,7 @@ void close_project (project * to_close)
     }
     to_close -> modelgl -> win = destroy_this_widget (to_close -> modelgl -> win);
     for (i=0; i<NGLOBAL_SHADERS; i++) cleaning_shaders (to_close -> modelgl, i);
+    free_poly_hulls (to_close -> modelgl);
     g_free (to_close -> modelgl);
     if (to_close -> modelfc)
     {
@@ -191,12 +192,19 @@ void close_project (project * to_close)
   }
   if (to_close -> atoms)
   {
-    for (i=0; i<to_close -> steps; i++)
+    // All MD steps might share the same atoms, see 'pos_window.c'
+    for (i=0; i<atom_steps (to_close); i++)
     {
-      if (to_close -> atoms[i]) g_free (to_close -> atoms[i]);
+      if (to_close -> atoms[i])
+      {
+        free_step_neighbors (to_close, i);
+        g_free (to_close -> atoms[i]);
+      }
     }
     g_free (to_close -> atoms);
   }
+  free_project_pos (to_close);
+  free_neighbor_lists (to_close);
   if (to_close -> run)
   {
     for (i=0 ; i<NGRAPHS ; i++)
@@ -256,11 +256,11 @@ void debugioproj (project * this_proj, gchar * iost)
     for (i=0; i<this_proj -> steps; i++)
     {
       g_debug ("IODEBUG::%s: proj.atom[%d][%d].x= %f, proj.atom[%d][%d].x= %f",
-               iost, i, 0, this_proj -> atoms[i][0].x, i, this_proj -> natomes-1, this_proj -> atoms[i][this_proj -> natomes - 1].x);
+               iost, i, 0, this_proj -> pos[i][0][0], i, this_proj -> natomes-1, this_proj -> pos[i][0][this_proj -> natomes - 1]);
       g_debug ("IODEBUG::%s: proj.atom[%d][%d].y= %f, proj.atom[%d][%d].y= %f",
-               iost, i, 0, this_proj -> atoms[i][0].y, i, this_proj -> natomes - 1, this_proj -> atoms[i][this_proj -> natomes - 1].y);
+               iost, i, 0, this_proj -> pos[i][1][0], i, this_proj -> natomes - 1, this_proj -> pos[i][1][this_proj -> natomes - 1]);
       g_debug ("IODEBUG::%s: proj.atom[%d][%d].z= %f, proj.atom[%d][%d].z= %f",
-               iost, i, 0, this_proj -> atoms[i][0].z, i, this_proj -> natomes - 1, this_proj -> atoms[i][this_proj -> natomes - 1].z);
+               iost, i, 0, this_proj -> pos[i][2][0], i, this_proj -> natomes - 1, this_proj -> pos[i][2][this_proj -> natomes - 1]);
     }
     for (i=0; i<this_proj -> nspec; i++)
     {
@@ -37,6 +37,8 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
   gchar * read_this_string (FILE * fp);
 
   void initcnames (int w, int s);
+  void free_project_pos (project * this_proj);
+  void alloc_project_pos (project * this_proj);
   void allocatoms (project * this_proj);
   void alloc_proj_data (project * this_proj, int cid);
 
@@ -153,10 +155,66 @@ void initcnames (int w, int s)
   }
 }
 
+/*!
+  \fn void free_project_pos (project * this_proj)
+
+  \brief free the atomic coordinates of a project
+
+  \param this_proj the target project
+*/
+void free_project_pos (project * this_proj)
+{
+  if (this_proj -> pos)
+  {
+    g_free (this_proj -> pos[0]);
+    g_free (this_proj -> pos);
+    this_proj -> pos = NULL;
+  }
+  if (this_proj -> pos_win)
+  {
+    close_pos_window (this_proj);
+  }
+  else if (this_proj -> pos_store)
+  {
+    g_free (this_proj -> pos_store);
+    this_proj -> pos_store = NULL;
+  }
+}
+
+/*!
+  \fn void alloc_project_pos (project * this_proj)
+
+  \brief allocate the atomic coordinates of a project:
+  a single buffer with one block per MD step, x, y then z for all atoms,
+  for large trajectories the buffer is a file mapped in memory, see 'pos_window.c'
+
+  \param this_proj the target project
+*/
+void alloc_project_pos (project * this_proj)
+{
+  int i, j;
+  double ** ptab;
+  gsize size = (gsize)this_proj -> steps*3*this_proj -> natomes;
+  free_project_pos (this_proj);
+  if (default_frame_window && this_proj -> steps > default_frame_window && size*sizeof*this_proj -> pos_store > FRAME_WINDOW_LIMIT)
+  {
+    this_proj -> pos_store = open_pos_window (this_proj, size);
+  }
+  if (! this_proj -> pos_store) this_proj -> pos_store = g_malloc0 (size*sizeof*this_proj -> pos_store);
+  this_proj -> pos = g_malloc (this_proj -> steps*sizeof*this_proj -> pos);
+  ptab = g_malloc (3*this_proj -> steps*sizeof*ptab);
+  for (i=0; i < this_proj -> steps; i++)
+  {
+    this_proj -> pos[i] = ptab + 3*i;
+    for (j=0; j<3; j++) this_proj -> pos[i][j] = this_proj -> pos_store + ((gsize)i*3 + j)*this_proj -> natomes;
+  }
+}
+
 /*!
   \fn void allocatoms (project * this_proj)
 
-  \brief allocate project data
+  \brief allocate project data,
+  if only a window of MD steps is kept in memory all MD steps share the same atoms
 
   \param this_proj the target project
 */
@@ -168,13 +226,23 @@ void allocatoms (project * this_proj)
     g_free (this_proj -> atoms);
     this_proj -> atoms = NULL;
   }
+  // The neighbor lists were views on the previous atoms
+  free_neighbor_lists (this_proj);
+  alloc_project_pos (this_proj);
   this_proj -> atoms = g_malloc0 (this_proj -> steps*sizeof*this_proj -> atoms);
   for (i=0; i < this_proj -> steps; i++)
   {
-    this_proj -> atoms[i] = g_malloc0 (this_proj -> natomes*sizeof*this_proj -> atoms[i]);
-    for (j=0; j<this_proj -> natomes; j++)
+    if (i < atom_steps (this_proj))
+    {
+      this_proj -> atoms[i] = g_malloc0 (this_proj -> natomes*sizeof*this_proj -> atoms[i]);
+      for (j=0; j<this_proj -> natomes; j++)
+      {
+        this_proj -> atoms[i][j].style = NONE;
+      }
+    }
+    else
     {
-      this_proj -> atoms[i][j].style = NONE;
+      this_proj -> atoms[i] = this_proj -> atoms[0];
     }
   }
 }
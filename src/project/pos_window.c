@@ -0,0 +1,331 @@
+/* This file is part of the 'atomes' software
+
+'atomes' is free software: you can redistribute it and/or modify it under the terms
+of the GNU Affero General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+'atomes' is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License along with 'atomes'.
+If not, see <https://www.gnu.org/licenses/>
+
+Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
+
+/*!
+* @file pos_window.c
+* @short Functions to keep only a window of MD steps of a large trajectory in memory
+* @author Sébastien Le Roux <sebastien.leroux@ipcms.unistra.fr>
+*/
+
+/*
+* This file: 'pos_window.c'
+*
+* Contains:
+*
+
+ - The functions to keep only a window of MD steps of a large trajectory in memory:
+   the atomic coordinates, and the atom data that change with the MD step, are stored in a binary file mapped in memory,
+   all MD steps share the same atoms, the data of an MD step is loaded in the atoms from the file when the MD step is used,
+   only the last 'default_frame_window' MD steps used are kept in memory, the least recently used MD step is released first
+
+*
+* List of functions:
+
+  int atom_steps (project * this_proj);
+
+  double * open_pos_window (project * this_proj, gsize size);
+
+  void set_step_coord (project * this_proj, int step, int aid, int cid, int val);
+  void set_step_clone (project * this_proj, int step, int aid, gboolean val);
+  void release_pos_pages (project * this_proj, gsize start, gsize end);
+  void load_pos_pages (project * this_proj, gsize start, gsize end);
+  void load_step_atoms (project * this_proj, int step);
+  void use_pos_step (project * this_proj, int step);
+  void release_pos_window (project * this_proj);
+  void close_pos_window (project * this_proj);
+
+*/
+
+#include "global.h"
+#include "project.h"
+#include "preferences.h"
+#ifndef G_OS_WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <glib/gstdio.h>
+#endif
+
+/*! \def STEP_DATA
+  \brief number of atom data stored in the file for each atom and each MD step: coord[0-4] and cloned
+*/
+#define STEP_DATA 6
+
+/*!
+  \fn int atom_steps (project * this_proj)
+
+  \brief return the number of MD steps with their own atoms, 1 if all MD steps share the same atoms
+
+  \param this_proj the target project
+*/
+int atom_steps (project * this_proj)
+{
+  return (this_proj -> pos_win) ? 1 : this_proj -> steps;
+}
+
+/*!
+  \fn double * open_pos_window (project * this_proj, gsize size)
+
+  \brief store the atomic coordinates of a project, and the atom data of each MD step,
+  in a binary file mapped in memory, return the mapped coordinates, NULL if the file cannot be created
+
+  \param this_proj the target project
+  \param size the number of coordinates
+*/
+double * open_pos_window (project * this_proj, gsize size)
+{
+#ifdef G_OS_WIN32
+  return NULL;
+#else
+  gchar * dir = g_build_filename (g_get_user_cache_dir (), "atomes", NULL);
+  gchar * file = g_build_filename (dir, "coord-XXXXXX", NULL);
+  gsize data = size*sizeof(double);
+  gsize length = data + (gsize)this_proj -> steps*this_proj -> natomes*STEP_DATA*sizeof(int);
+  void * map = MAP_FAILED;
+  int fd = -1;
+  int res = -1;
+  if (g_mkdir_with_parents (dir, 0700) == 0) fd = g_mkstemp (file);
+  if (fd > -1)
+  {
+    // The file is deleted as soon as it is closed, even if atomes does not exit properly
+    g_unlink (file);
+#ifdef __APPLE__
+    res = ftruncate (fd, length);
+#else
+    // The disk space is reserved now, not to run out of space while writing the coordinates
+    res = posix_fallocate (fd, 0, length);
+#endif
+    if (res == 0) map = mmap (NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  g_free (dir);
+  g_free (file);
+  if (map == MAP_FAILED)
+  {
+    if (fd > -1) close (fd);
+    return NULL;
+  }
+  this_proj -> pos_win = g_malloc0 (sizeof*this_proj -> pos_win);
+  this_proj -> pos_win -> size = default_frame_window;
+  this_proj -> pos_win -> steps = allocint (default_frame_window);
+  this_proj -> pos_win -> active = -1;
+  this_proj -> pos_win -> step_data = (int *)((gchar *)map + data);
+  this_proj -> pos_win -> fd = fd;
+  this_proj -> pos_win -> length = length;
+  return (double *)map;
+#endif
+}
+
+/*!
+  \fn void set_step_coord (project * this_proj, int step, int aid, int cid, int val)
+
+  \brief set a coordination id of an atom for an MD step
+
+  \param this_proj the target project
+  \param step the MD step
+  \param aid the atom id
+  \param cid the coordination type
+  \param val the value
+*/
+void set_step_coord (project * this_proj, int step, int aid, int cid, int val)
+{
+  pos_window * win = this_proj -> pos_win;
+  if (win)
+  {
+    win -> step_data[((gsize)step*this_proj -> natomes + aid)*STEP_DATA + cid] = val;
+    // The atoms hold the data of the active MD step only
+    if (step != win -> active) return;
+  }
+  this_proj -> atoms[step][aid].coord[cid] = val;
+}
+
+/*!
+  \fn void set_step_clone (project * this_proj, int step, int aid, gboolean val)
+
+  \brief set if an atom has clone(s) for an MD step
+
+  \param this_proj the target project
+  \param step the MD step
+  \param aid the atom id
+  \param val the value
+*/
+void set_step_clone (project * this_proj, int step, int aid, gboolean val)
+{
+  pos_window * win = this_proj -> pos_win;
+  if (win)
+  {
+    win -> step_data[((gsize)step*this_proj -> natomes + aid)*STEP_DATA + STEP_DATA - 1] = val;
+    if (step != win -> active) return;
+  }
+  this_proj -> atoms[step][aid].cloned = val;
+}
+
+/*!
+  \fn void release_pos_pages (project * this_proj, gsize start, gsize end)
+
+  \brief release the memory pages of the mapped file between 'start' and 'end',
+  modified pages are written to the file, the pages are loaded again from the file if needed
+
+  \param this_proj the target project
+  \param start the starting position in the mapped file
+  \param end the ending position in the mapped file
+*/
+void release_pos_pages (project * this_proj, gsize start, gsize end)
+{
+#ifndef G_OS_WIN32
+  gsize page = sysconf (_SC_PAGESIZE);
+  // Only the pages that are entirely in the range, not to release a neighbor MD step
+  start = ((start + page - 1)/page)*page;
+  end = (end/page)*page;
+  if (end > start)
+  {
+    madvise ((gchar *)this_proj -> pos_store + start, end - start, MADV_DONTNEED);
+#ifdef POSIX_FADV_DONTNEED
+    posix_fadvise (this_proj -> pos_win -> fd, start, end - start, POSIX_FADV_DONTNEED);
+#endif
+  }
+#endif
+}
+
+/*!
+  \fn void load_pos_pages (project * this_proj, gsize start, gsize end)
+
+  \brief load in memory the pages of the mapped file between 'start' and 'end'
+
+  \param this_proj the target project
+  \param start the starting position in the mapped file
+  \param end the ending position in the mapped file
+*/
+void load_pos_pages (project * this_proj, gsize start, gsize end)
+{
+#ifndef G_OS_WIN32
+  gsize page = sysconf (_SC_PAGESIZE);
+  volatile gchar * map = (gchar *)this_proj -> pos_store;
+  gchar val;
+  start = (start/page)*page;
+  if (end <= start) return;
+#ifdef MADV_POPULATE_READ
+  if (madvise ((gchar *)this_proj -> pos_store + start, end - start, MADV_POPULATE_READ) == 0) return;
+#endif
+  // Reading one value per page loads it now, not while the MD step is used
+  madvise ((gchar *)this_proj -> pos_store + start, end - start, MADV_WILLNEED);
+  for ( ; start < end; start += page) val = map[start];
+  (void)val;
+#endif
+}
+
+/*!
+  \fn void load_step_atoms (project * this_proj, int step)
+
+  \brief load in the atoms the data of an MD step: coordinations, clones and neighbors
+
+  \param this_proj the target project
+  \param step the MD step
+*/
+void load_step_atoms (project * this_proj, int step)
+{
+  int i, j;
+  int * data = this_proj -> pos_win -> step_data + (gsize)step*this_proj -> natomes*STEP_DATA;
+  int * csr = (this_proj -> vois_csr && step < this_proj -> csr_steps) ? this_proj -> vois_csr[step] : NULL;
+  atom * at;
+  for (i=0; i<this_proj -> natomes; i++, data += STEP_DATA)
+  {
+    at = & this_proj -> atoms[step][i];
+    for (j=0; j<STEP_DATA-1; j++) at -> coord[j] = data[j];
+    at -> cloned = data[STEP_DATA-1];
+    at -> numv = (csr) ? csr[i+1] - csr[i] : 0;
+    at -> vois = (at -> numv) ? & csr[csr[i]] : NULL;
+  }
+  this_proj -> pos_win -> active = step;
+}
+
+/*!
+  \fn void use_pos_step (project * this_proj, int step)
+
+  \brief the MD step is going to be used:
+  the MD step enters the window, its coordinates and atom data are loaded from the file if released,
+  or becomes the most recently used MD step of the window,
+  if the window is full the least recently used MD step is released,
+  then the atom data of the MD step is loaded in the atoms
+
+  \param this_proj the target project
+  \param step the MD step
+*/
+void use_pos_step (project * this_proj, int step)
+{
+  pos_window * win = this_proj -> pos_win;
+  if (! win || step < 0 || step >= this_proj -> steps) return;
+  int i, j;
+  gsize length = (gsize)3*this_proj -> natomes*sizeof(double);
+  gsize data = (gsize)this_proj -> natomes*STEP_DATA*sizeof(int);
+  gsize start = (gsize)this_proj -> steps*length;
+  for (i=0; i<win -> num; i++)
+  {
+    if (win -> steps[i] == step) break;
+  }
+  if (i == win -> num)
+  {
+    if (win -> num == win -> size)
+    {
+      j = win -> steps[0];
+      release_pos_pages (this_proj, j*length, (j+1)*length);
+      release_pos_pages (this_proj, start + j*data, start + (j+1)*data);
+      i = 0;
+    }
+    else
+    {
+      win -> num ++;
+    }
+    load_pos_pages (this_proj, step*length, (step+1)*length);
+    load_pos_pages (this_proj, start + step*data, start + (step+1)*data);
+  }
+  for (j=i; j<win -> num-1; j++) win -> steps[j] = win -> steps[j+1];
+  win -> steps[win -> num-1] = step;
+  if (step != win -> active) load_step_atoms (this_proj, step);
+}
+
+/*!
+  \fn void release_pos_window (project * this_proj)
+
+  \brief release the memory pages of all MD steps, and empty the window,
+  to use once all MD steps have been read or modified, ie. by an analysis
+
+  \param this_proj the target project
+*/
+void release_pos_window (project * this_proj)
+{
+  if (! this_proj -> pos_win) return;
+  release_pos_pages (this_proj, 0, this_proj -> pos_win -> length);
+  this_proj -> pos_win -> num = 0;
+  // The atom data might have been modified for all MD steps
+  this_proj -> pos_win -> active = -1;
+}
+
+/*!
+  \fn void close_pos_window (project * this_proj)
+
+  \brief close the window of MD steps and the coordinates file
+
+  \param this_proj the target project
+*/
+void close_pos_window (project * this_proj)
+{
+#ifndef G_OS_WIN32
+  munmap (this_proj -> pos_store, this_proj -> pos_win -> length);
+  close (this_proj -> pos_win -> fd);
+#endif
+  g_free (this_proj -> pos_win -> steps);
+  g_free (this_proj -> pos_win);
+  this_proj -> pos_win = NULL;
+  this_proj -> pos_store = NULL;
+}
@@ -30,11 +30,13 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 *
 * List of functions:
 
-  void save_pos_ (int * nat, int lot[* nat], int * num, double xpos[* num], double ypos[* num], double zpos[* num]);
+  void save_pos_ (int * nat, int lot[* nat], int * stp, double xpos[* nat], double ypos[* nat], double zpos[* nat]);
   void send_steps_ (int * steps);
 
   project * get_project_by_id (int p);
 
+  atom_pos get_atom_pos (project * this_proj, int step, int aid);
+
 */
 
 #include "global.h"
@@ -42,6 +44,7 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 #include "callbacks.h"
 #include "interface.h"
 #include "bind.h"
+#include "project.h"
 
 workspace workzone;
 project * active_project = NULL;
@@ -54,47 +57,41 @@ glwin * active_glwin = NULL;
 project * opengl_project = NULL;
 
 /*!
-  \fn void save_pos_ (int * nat, int lot[*nat], int * num, double xpos[*num], double ypos[*num], double zpos[*num])
+  \fn void save_pos_ (int * nat, int lot[*nat], int * stp, double xpos[*nat], double ypos[*nat], double zpos[*nat])
 
-  \brief retrieve atomic coordinates from Fortran90
+  \brief retrieve atomic coordinates of one MD step from Fortran90
 
   \param nat Number of atoms
   \param lot List of chemical species by atoms
-  \param num Number of coordinates (NA x NS)
+  \param stp the MD step
   \param xpos x coordinates
   \param ypos y coordinates
   \param zpos z coordinates
 */
-void save_pos_ (int * nat, int lot[* nat], int * num, double xpos[* num], double ypos[* num], double zpos[* num])
+void save_pos_ (int * nat, int lot[* nat], int * stp, double xpos[* nat], double ypos[* nat], double zpos[* nat])
 {
-  int i, j, k;
-
-  k = 0;
-
-  for ( i=0 ; i < active_project -> steps ; i++ )
+  int i, j;
+  i = * stp;
+  for (j=0; j < active_project -> natomes; j++)
   {
-    for (j=0; j < active_project -> natomes; j++)
+    active_project -> pos[i][0][j] = xpos[j];
+    active_project -> pos[i][1][j] = ypos[j];
+    active_project -> pos[i][2][j] = zpos[j];
+    active_project -> atoms[i][j].sp = lot[j]-1;
+    active_project -> atoms[i][j].id = j;
+    active_project -> atoms[i][j].show[0] = TRUE;
+    active_project -> atoms[i][j].show[1] = TRUE;
+    active_project -> atoms[i][j].label[0] = FALSE;
+    active_project -> atoms[i][j].label[1] = FALSE;
+    if (active_glwin == NULL)
     {
-      active_project -> atoms[i][j].x = xpos[k];
-      active_project -> atoms[i][j].y = ypos[k];
-      active_project -> atoms[i][j].z = zpos[k];
-      active_project -> atoms[i][j].sp = lot[j]-1;
-      active_project -> atoms[i][j].id = j;
-      active_project -> atoms[i][j].show[0] = TRUE;
-      active_project -> atoms[i][j].show[1] = TRUE;
-      active_project -> atoms[i][j].label[0] = FALSE;
-      active_project -> atoms[i][j].label[1] = FALSE;
-      if (active_glwin == NULL)
-      {
-        active_project -> atoms[i][j].pick[0] = FALSE;
-      }
-      else if (! active_image -> selected[0] -> selected)
-      {
-        active_project -> atoms[i][j].pick[0] = FALSE;
-      }
-      active_project -> atoms[i][j].cloned = FALSE;
-      k++;
+      active_project -> atoms[i][j].pick[0] = FALSE;
     }
+    else if (! active_image -> selected[0] -> selected)
+    {
+      active_project -> atoms[i][j].pick[0] = FALSE;
+    }
+    set_step_clone (active_project, i, j, FALSE);
   }
 }
 
@@ -128,3 +125,21 @@ project * get_project_by_id (int p)
   }
   return NULL;
 }
+
+/*!
+  \fn atom_pos get_atom_pos (project * this_proj, int step, int aid)
+
+  \brief get the coordinates of an atom
+
+  \param this_proj the target project
+  \param step the MD step
+  \param aid the atom id
+*/
+atom_pos get_atom_pos (project * this_proj, int step, int aid)
+{
+  atom_pos at;
+  at.x = this_proj -> pos[step][0][aid];
+  at.y = this_proj -> pos[step][1][aid];
+  at.z = this_proj -> pos[step][2][aid];
+  return at;
+}
@@ -52,6 +52,15 @@ extern int read_cpmd_data (FILE * fp, int cid, project * this_proj);
 extern int read_cp2k_data (FILE * fp, int cid, project * this_proj);
 extern gchar * read_this_string (FILE * fp);
 extern void alloc_proj_data (project * this_proj,  int cid);
+extern void alloc_project_pos (project * this_proj);
+extern void free_project_pos (project * this_proj);
+extern int atom_steps (project * this_proj);
+extern double * open_pos_window (project * this_proj, gsize size);
+extern void set_step_coord (project * this_proj, int step, int aid, int cid, int val);
+extern void set_step_clone (project * this_proj, int step, int aid, gboolean val);
+extern void use_pos_step (project * this_proj, int step);
+extern void release_pos_window (project * this_proj);
+extern void close_pos_window (project * this_proj);
 extern int open_project (FILE * fp, int wid);
 
 // Save
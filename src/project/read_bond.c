@@ -93,7 +93,7 @@ int read_bonding (FILE * fp)
             {
               l = active_glwin -> bondid[i][j][k][0];
               m = active_glwin -> bondid[i][j][k][1];
-              clo = distance_3d (active_cell, (active_cell -> npt) ? i : 0, & active_project -> atoms[i][l], & active_project -> atoms[i][m]);
+              clo = distance_3d (active_cell, (active_cell -> npt) ? i : 0, get_atom_pos (active_project, i, l), get_atom_pos (active_project, i, m));
               active_glwin -> clones[i][k].x = clo.x;
               active_glwin -> clones[i][k].y = clo.y;
               active_glwin -> clones[i][k].z = clo.z;
@@ -62,11 +62,11 @@ int read_atom_a (FILE * fp, project * this_proj, int s, int a)
 {
   if (fread (& this_proj -> atoms[s][a].id, sizeof(int), 1, fp) != 1) return ERROR_RW;
   if (fread (& this_proj -> atoms[s][a].sp, sizeof(int), 1, fp) != 1) return ERROR_RW;
-  if (fread (& this_proj -> atoms[s][a].x, sizeof(double), 1, fp) != 1) return ERROR_RW;
-  if (fread (& this_proj -> atoms[s][a].y, sizeof(double), 1, fp) != 1) return ERROR_RW;
-  if (fread (& this_proj -> atoms[s][a].z, sizeof(double), 1, fp) != 1) return ERROR_RW;
+  if (fread (& this_proj -> pos[s][0][a], sizeof(double), 1, fp) != 1) return ERROR_RW;
+  if (fread (& this_proj -> pos[s][1][a], sizeof(double), 1, fp) != 1) return ERROR_RW;
+  if (fread (& this_proj -> pos[s][2][a], sizeof(double), 1, fp) != 1) return ERROR_RW;
   //g_debug ("Reading:: step= %d, at= %d, sp[%d]= %d, x[%d]= %f, y[%d]= %f, z[%d]= %f",
-  //         s, a+1, a, this_proj -> atoms[s][a].sp, a, this_proj -> atoms[s][a].x, a, this_proj -> atoms[s][a].y, a, this_proj -> atoms[s][a].z);
+  //         s, a+1, a, this_proj -> atoms[s][a].sp, a, this_proj -> pos[s][0][a], a, this_proj -> pos[s][1][a], a, this_proj -> pos[s][2][a]);
   return OK;
 }
 
@@ -87,6 +87,25 @@ int read_atom_b (FILE * fp, project * this_proj, int s, int a)
   if (fread (& this_proj -> atoms[s][a].style, sizeof(int), 1, fp) != 1) return ERROR_RW;
   int i, j, k, l, m;
   int * rings_ij;
+  if (this_proj -> pos_win)
+  {
+    // All MD steps share the same atoms, see 'pos_window.c': the ring(s) and chain(s) of each atom are not kept
+    if (! s)
+    {
+      for (i=0; i<5; i++)
+      {
+        if (this_proj -> modelgl -> rings && this_proj -> modelgl -> ring_max[i])
+        {
+          this_proj -> atoms[s][a].rings[i] = g_malloc0 (this_proj -> rsparam[i][1]*sizeof*this_proj -> atoms[s][a].rings[i]);
+        }
+      }
+      if (this_proj -> modelgl -> chains && this_proj -> modelgl -> chain_max)
+      {
+        this_proj -> atoms[s][a].chain = g_malloc0 (this_proj -> csparam[5]*sizeof*this_proj -> atoms[s][a].chain);
+      }
+    }
+    return OK;
+  }
   if (this_proj -> modelgl -> rings)
   {
     for (i=0; i<5; i++)
@@ -130,7 +130,7 @@ int c3d_get_atom_coordinates ()
             res = 2;
             goto enda;
           }
-          active_project -> atoms[i][j].x = string_to_double ((gpointer)this_word);
+          active_project -> pos[i][0][j] = string_to_double ((gpointer)this_word);
           this_word = strtok_r (NULL, " ", & saved_line);
           if (! this_word)
           {
@@ -138,7 +138,7 @@ int c3d_get_atom_coordinates ()
             res = 2;
             goto enda;
           }
-          active_project -> atoms[i][j].y = string_to_double ((gpointer)this_word);
+          active_project -> pos[i][1][j] = string_to_double ((gpointer)this_word);
           this_word = strtok_r (NULL, " ", & saved_line);
           if (! this_word)
           {
@@ -146,7 +146,7 @@ int c3d_get_atom_coordinates ()
             res = 2;
             goto enda;
           }
-          active_project -> atoms[i][j].z = string_to_double ((gpointer)this_word);
+          active_project -> pos[i][2][j] = string_to_double ((gpointer)this_word);
         }
         else
         {
@@ -206,7 +206,7 @@ int c3d_get_atom_coordinates ()
             res = 2;
             goto ends;
           }
-          active_project -> atoms[i][j].x = string_to_double ((gpointer)this_word);
+          active_project -> pos[i][0][j] = string_to_double ((gpointer)this_word);
           this_word = strtok_r (NULL, " ", & saved_line);
           if (! this_word)
           {
@@ -214,7 +214,7 @@ int c3d_get_atom_coordinates ()
             res = 2;
             goto ends;
           }
-          active_project -> atoms[i][j].y = string_to_double ((gpointer)this_word);
+          active_project -> pos[i][1][j] = string_to_double ((gpointer)this_word);
           this_word = strtok_r (NULL, " ", & saved_line);
           if (! this_word)
           {
@@ -222,7 +222,7 @@ int c3d_get_atom_coordinates ()
             res = 2;
             goto ends;
           }
-          active_project -> atoms[i][j].z = string_to_double ((gpointer)this_word);
+          active_project -> pos[i][2][j] = string_to_double ((gpointer)this_word);
         }
         else
         {
@@ -272,21 +272,21 @@ int c3d_get_atom_coordinates ()
           format_error (i+1, j+1, lia[2], k+j);
           return 2;
         }
-        active_project -> atoms[i][j].x = string_to_double ((gpointer)this_word);
+        active_project -> pos[i][0][j] = string_to_double ((gpointer)this_word);
         this_word = strtok (NULL, " ");
         if (! this_word)
         {
           format_error (i+1, j+1, lia[3], k+j);
           return 2;
         }
-        active_project -> atoms[i][j].y = string_to_double ((gpointer)this_word);
+        active_project -> pos[i][1][j] = string_to_double ((gpointer)this_word);
         this_word = strtok (NULL, " ");
         if (! this_word)
         {
           format_error (i+1, j+1, lia[4], k+j);
           return 2;
         }
-        active_project -> atoms[i][j].z = string_to_double ((gpointer)this_word);
+        active_project -> pos[i][2][j] = string_to_double ((gpointer)this_word);
       }
       else
       {
@@ -86,7 +86,7 @@ extern int read_space_group (builder_edition * cbuilder, int spg);
 extern gchar * wnpos[3];
 extern void get_wyck_char (float val, int ax, int bx);
 extern space_group * duplicate_space_group (space_group * spg);
-extern distance distance_3d (cell_info * cell, int mdstep, atom * at, atom * bt);
+extern distance distance_3d (cell_info * cell, int mdstep, atom_pos at, atom_pos bt);
 extern void sort (int dim, int * tab);
 
 extern gchar * tmp_pos;
@@ -1019,9 +1019,9 @@ gboolean cif_file_get_atoms_data (int conf, int lin, int cid[9])
     }
     if (this_reader -> cartesian)
     {
-      active_project -> atoms[at_step][i].x = get_atom_coord (cline, cid[2]);
-      active_project -> atoms[at_step][i].y = get_atom_coord (cline, cid[3]);
-      active_project -> atoms[at_step][i].z = get_atom_coord (cline, cid[4]);
+      active_project -> pos[at_step][0][i] = get_atom_coord (cline, cid[2]);
+      active_project -> pos[at_step][1][i] = get_atom_coord (cline, cid[3]);
+      active_project -> pos[at_step][2][i] = get_atom_coord (cline, cid[4]);
     }
     else
     {
@@ -1063,9 +1063,9 @@ gboolean cif_file_get_atoms_data (int conf, int lin, int cid[9])
     }
     if (this_reader -> cartesian)
     {
-      active_project -> atoms[at_step][i].x = get_atom_coord (cline, cid[2]);
-      active_project -> atoms[at_step][i].y = get_atom_coord (cline, cid[3]);
-      active_project -> atoms[at_step][i].z = get_atom_coord (cline, cid[4]);
+      active_project -> pos[at_step][0][i] = get_atom_coord (cline, cid[2]);
+      active_project -> pos[at_step][1][i] = get_atom_coord (cline, cid[3]);
+      active_project -> pos[at_step][2][i] = get_atom_coord (cline, cid[4]);
     }
     else
     {
@@ -2182,7 +2182,7 @@ int open_cif_configuration (int linec, int conf)
       vec3_t f_pos, c_pos;
       gboolean * save_pos = allocbool (max_pos);
       mat4_t pos_mat;
-      atom at, bt;
+      atom_pos at, bt;
       distance dist;
       double u;
       vec3_t * all_pos = g_malloc0(max_pos*sizeof*all_pos);
@@ -2340,7 +2340,7 @@ int open_cif_configuration (int linec, int conf)
               bt.x = all_pos[k].x;
               bt.y = all_pos[k].y;
               bt.z = all_pos[k].z;
-              dist = distance_3d (active_cell, 0, & at, & bt);
+              dist = distance_3d (active_cell, 0, at, bt);
               if (dist.length < 0.1)
               {
                 dist_message = TRUE;
@@ -2457,9 +2457,9 @@ int open_cif_configuration (int linec, int conf)
             n = c_obj -> old_z[m];
             spec_num[n] ++;
             active_project -> atoms[cid][i].sp = n;
-            active_project -> atoms[cid][i].x = cryst -> coord[j][0].x + c_obj -> at_list[l].x;
-            active_project -> atoms[cid][i].y = cryst -> coord[j][0].y + c_obj -> at_list[l].y;
-            active_project -> atoms[cid][i].z = cryst -> coord[j][0].z + c_obj -> at_list[l].z;
+            active_project -> pos[cid][0][i] = cryst -> coord[j][0].x + c_obj -> at_pos[l].x;
+            active_project -> pos[cid][1][i] = cryst -> coord[j][0].y + c_obj -> at_pos[l].y;
+            active_project -> pos[cid][2][i] = cryst -> coord[j][0].z + c_obj -> at_pos[l].z;
             i ++;
           }
         }
@@ -2468,9 +2468,9 @@ int open_cif_configuration (int linec, int conf)
           k = (int)this_reader -> z[cryst_lot[j]];
           spec_num[k] ++;
           active_project -> atoms[cid][i].sp = k;
-          active_project -> atoms[cid][i].x = cryst -> coord[j][0].x;
-          active_project -> atoms[cid][i].y = cryst -> coord[j][0].y;
-          active_project -> atoms[cid][i].z = cryst -> coord[j][0].z;
+          active_project -> pos[cid][0][i] = cryst -> coord[j][0].x;
+          active_project -> pos[cid][1][i] = cryst -> coord[j][0].y;
+          active_project -> pos[cid][2][i] = cryst -> coord[j][0].z;
           i ++;
         }
       }
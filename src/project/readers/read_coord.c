@@ -31,9 +31,17 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 * List of functions:
 
   gboolean set_dummy_in_use (gchar * this_word);
+  gboolean map_coord_file (gchar * filename);
+  gboolean coord_get_word (gsize * pos, gsize end, gchar * word);
 
+  int index_coord_frames (int lpf);
   int open_coord_file (gchar * filename, int fti);
 
+  gsize coord_next_line (gsize pos);
+
+  void unmap_coord_file ();
+  void release_coord_pages (gsize start, gsize end);
+  void release_coord_frame (int stp);
   void add_reader_info (gchar * info, int mid);
   void reader_info (gchar * type, gchar * sinf, int val);
   void format_error (int stp, int ato, gchar * mot, int line);
@@ -48,14 +56,18 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 #include "project.h"
 #include "bind.h"
 #include "cbuild_edit.h"
+#include "readers.h"
 #ifdef OPENMP
 #  include <omp.h>
 #endif
+#ifndef G_OS_WIN32
+#  include <sys/mman.h>
+#endif
 
-extern int open_xyz_file (int linec);
+extern int open_xyz_file ();
 extern int open_c3d_file (int linec);
 extern int open_pdb_file (int linec);
-extern int open_trj_file (int linec);
+extern int open_trj_file ();
 extern int open_vas_file (int linec);
 extern int open_cif_configuration (int linec, int conf);
 extern int open_cif_file (int linec);
@@ -76,6 +88,10 @@ gchar * this_line = NULL;
 char * this_word;
 line_node * head = NULL;
 line_node * tail = NULL;
+GMappedFile * coord_map = NULL;
+gchar * coord_data = NULL;
+gsize coord_size = 0;
+gsize * coord_frame = NULL;
 
 /*!
   \fn void add_reader_info (gchar * info, int mid)
@@ -264,135 +280,315 @@ void check_for_species (double v, int ato)
 }
 
 /*!
-  \fn int open_coord_file (gchar * filename, int fti)
+  \fn gboolean map_coord_file (gchar * filename)
 
-  \brief open atomic coordinates file
+  \brief map the atomic coordinates file in memory, read only
 
   \param filename the file name
-  \param fti the type of coordinates
 */
-int open_coord_file (gchar * filename, int fti)
+gboolean map_coord_file (gchar * filename)
 {
-  int res = 0;
-#ifdef OPENMP
-  struct stat status;
-  res = stat (filename, & status);
-  if (res == -1)
+  GError * error = NULL;
+  coord_map = g_mapped_file_new (filename, FALSE, & error);
+  if (! coord_map)
   {
-    add_reader_info ("Error - cannot get file statistics !\n", 0);
-    return 1;
+    add_reader_info ("Error - cannot open coordinates file !\n", 0);
+    g_error_free (error);
+    return FALSE;
+  }
+  coord_data = g_mapped_file_get_contents (coord_map);
+  coord_size = g_mapped_file_get_length (coord_map);
+  if (! coord_data || ! coord_size)
+  {
+    unmap_coord_file ();
+    return FALSE;
   }
-  int fsize = status.st_size;
+#ifndef G_OS_WIN32
+  madvise (coord_data, coord_size, MADV_SEQUENTIAL);
 #endif
-  coordf = fopen (filename, dfi[0]);
-  if (! coordf)
+  return TRUE;
+}
+
+/*!
+  \fn void unmap_coord_file ()
+
+  \brief release the memory mapping of the atomic coordinates file
+*/
+void unmap_coord_file ()
+{
+  if (coord_map) g_mapped_file_unref (coord_map);
+  coord_map = NULL;
+  coord_data = NULL;
+  coord_size = 0;
+  if (coord_frame) g_free (coord_frame);
+  coord_frame = NULL;
+}
+
+/*!
+  \fn gsize coord_next_line (gsize pos)
+
+  \brief position of the line following position 'pos' in the mapped file
+
+  \param pos the position in the mapped file
+*/
+gsize coord_next_line (gsize pos)
+{
+  if (pos >= coord_size) return coord_size;
+  gchar * eol = memchr (coord_data + pos, '\n', coord_size - pos);
+  return (eol) ? (gsize)(eol - coord_data) + 1 : coord_size;
+}
+
+/*!
+  \fn gboolean coord_get_word (gsize * pos, gsize end, gchar * word)
+
+  \brief copy the next word before position 'end' of the mapped file,
+  and move 'pos' after it, return FALSE if there is no word
+
+  \param pos the position in the mapped file
+  \param end the end of the current line
+  \param word the word, at least COORD_WORD long
+*/
+gboolean coord_get_word (gsize * pos, gsize end, gchar * word)
+{
+  gsize i = * pos;
+  int j = 0;
+  while (i < end && g_ascii_isspace (coord_data[i])) i ++;
+  while (i < end && ! g_ascii_isspace (coord_data[i]))
   {
-    add_reader_info ("Error - cannot open coordinates file !\n", 0);
-    return 1;
+    if (j == COORD_WORD-1) return FALSE;
+    word[j] = coord_data[i];
+    i ++;
+    j ++;
   }
-  int i, j, k, l;
-#ifdef OPENMP
-  gchar * coord_content = g_malloc0(fsize*sizeof*coord_content);
-  fread (coord_content, fsize, 1, coordf);
-  fclose (coordf);
-  int linecount = 0;
-  for (j=0; j<fsize; j++) if (coord_content[j] == '\n') linecount ++;
-  coord_line = g_malloc0 (linecount*sizeof*coord_line);
-  coord_line[0] = & coord_content[0];
-  i = 1;
-  for (j=0; j<fsize; j++)
+  word[j] = '\0';
+  * pos = i;
+  return (j > 0);
+}
+
+/*!
+  \fn void release_coord_pages (gsize start, gsize end)
+
+  \brief tell the system that the pages of the mapped file between 'start' and 'end'
+  are not needed anymore, so that the memory used to read large trajectories remains bounded,
+  pages are reloaded from the file if needed again, ie. by a neighbor frame
+
+  \param start the starting position in the mapped file
+  \param end the ending position in the mapped file
+*/
+void release_coord_pages (gsize start, gsize end)
+{
+#ifndef G_OS_WIN32
+  gsize page = sysconf (_SC_PAGESIZE);
+  start = (start/page)*page;
+  end = (end/page)*page;
+  if (end > start) madvise (coord_data + start, end - start, MADV_DONTNEED);
+#endif
+}
+
+/*!
+  \fn void release_coord_frame (int stp)
+
+  \brief release the pages of a frame already read
+
+  \param stp the frame id
+*/
+void release_coord_frame (int stp)
+{
+  release_coord_pages (coord_frame[stp], coord_frame[stp+1]);
+}
+
+/*!
+  \fn int index_coord_frames (int lpf)
+
+  \brief index the position of each frame in the mapped file,
+  return the number of complete frames, -1 on error
+
+  \param lpf the number of lines per frame
+*/
+int index_coord_frames (int lpf)
+{
+  gsize pos = 0;
+  gsize end = coord_size;
+  gsize lines = 0;
+  gsize released = 0;
+  int frames = 0;
+  int nalloc = 1024;
+  gchar * str;
+  if (lpf < 1) return -1;
+  // Blank lines at the end of the file are not part of any frame
+  while (end > 0 && g_ascii_isspace (coord_data[end-1])) end --;
+  if (end) end = coord_next_line (end);
+  coord_frame = g_malloc0 (nalloc*sizeof*coord_frame);
+  while (pos < end)
   {
-    if (coord_content[j] == '\n')
+    if (! (lines % lpf))
     {
-      coord_content[j] = '\0';
-      if (i < linecount)
+      if (frames == nalloc-1)
       {
-        coord_line[i] = & coord_content[j+1];
-        i ++;
+        nalloc *= 2;
+        coord_frame = g_realloc (coord_frame, nalloc*sizeof*coord_frame);
       }
+      coord_frame[frames] = pos;
+      frames ++;
     }
-  }
-#else
-  gchar * buf = g_malloc0(LINE_SIZE*sizeof*buf);
-  head = NULL;
-  tail = NULL;
-  i = 0;
-  while (fgets(buf, LINE_SIZE, coordf))
-  {
-    if (head == NULL)
-    {
-      head = g_malloc0 (sizeof*head);
-      tail = g_malloc0 (sizeof*tail);
-      tail = head;
-    }
-    else
+    pos = coord_next_line (pos);
+    lines ++;
+    if (pos - released > COORD_CHUNK)
     {
-      tail -> next = g_malloc0 (sizeof*tail -> next);
-      if (fti == 9 || fti == 10)
-      {
-        tail -> next -> prev = g_malloc0 (sizeof*tail -> next -> prev);
-        tail -> next -> prev = tail;
-      }
-      tail = tail -> next;
+      release_coord_pages (released, pos);
+      released = pos;
     }
-    tail -> line = g_strdup_printf ("%s", buf);
-    tail -> line = substitute_string (tail -> line, "\n", "\0");
-    i ++;
   }
-  g_free (buf);
-  fclose (coordf);
-#endif
-  if (i)
+  if (lines % lpf)
+  {
+    // The last frame is incomplete: it is dropped, its first line closes the previous frame
+    frames --;
+    str = g_strdup_printf ("Last MD step incomplete - %d line(s) instead of %d, this MD step is ignored !", (int)(lines % lpf), lpf);
+    add_reader_info (str, 1);
+    g_free (str);
+  }
+  else
+  {
+    coord_frame[frames] = end;
+  }
+  return frames;
+}
+
+/*!
+  \fn int open_coord_file (gchar * filename, int fti)
+
+  \brief open atomic coordinates file
+
+  \param filename the file name
+  \param fti the type of coordinates
+*/
+int open_coord_file (gchar * filename, int fti)
+{
+  int res = 0;
+  int i, j, k, l;
+  if (fti < 2 || fti == 3 || fti == 4)
   {
+    // XYZ and TRJ trajectories can be very large:
+    // the file is mapped in memory and parsed in place, frame by frame
+    if (! map_coord_file (filename)) return 1;
     this_reader -> cartesian = TRUE;
-    if (fti < 2)
-    {
-      res = open_xyz_file (i);
-    }
-    else if (fti == 2)
+    res = (fti < 2) ? open_xyz_file () : open_trj_file ();
+    unmap_coord_file ();
+  }
+  else
+  {
+#ifdef OPENMP
+    struct stat status;
+    res = stat (filename, & status);
+    if (res == -1)
     {
-      res = open_c3d_file (i);
+      add_reader_info ("Error - cannot get file statistics !\n", 0);
+      return 1;
     }
-    else if (fti < 5)
+    gsize fsize = status.st_size;
+    gsize m;
+#endif
+    coordf = fopen (filename, dfi[0]);
+    if (! coordf)
     {
-      res = open_trj_file (i);
+      add_reader_info ("Error - cannot open coordinates file !\n", 0);
+      return 1;
     }
-    else if (fti < 7)
+#ifdef OPENMP
+    gchar * coord_content = g_malloc0(fsize*sizeof*coord_content);
+    fread (coord_content, fsize, 1, coordf);
+    fclose (coordf);
+    int linecount = 0;
+    for (m=0; m<fsize; m++) if (coord_content[m] == '\n') linecount ++;
+    coord_line = g_malloc0 (linecount*sizeof*coord_line);
+    coord_line[0] = & coord_content[0];
+    i = 1;
+    for (m=0; m<fsize; m++)
     {
-      res = open_vas_file (i);
+      if (coord_content[m] == '\n')
+      {
+        coord_content[m] = '\0';
+        if (i < linecount)
+        {
+          coord_line[i] = & coord_content[m+1];
+          i ++;
+        }
+      }
     }
-    else if (fti > 6 && fti < 9)
+#else
+    gchar * buf = g_malloc0(LINE_SIZE*sizeof*buf);
+    head = NULL;
+    tail = NULL;
+    i = 0;
+    while (fgets(buf, LINE_SIZE, coordf))
     {
-      res = open_pdb_file (i);
+      if (head == NULL)
+      {
+        head = g_malloc0 (sizeof*head);
+        tail = g_malloc0 (sizeof*tail);
+        tail = head;
+      }
+      else
+      {
+        tail -> next = g_malloc0 (sizeof*tail -> next);
+        if (fti == 9 || fti == 10)
+        {
+          tail -> next -> prev = g_malloc0 (sizeof*tail -> next -> prev);
+          tail -> next -> prev = tail;
+        }
+        tail = tail -> next;
+      }
+      tail -> line = g_strdup_printf ("%s", buf);
+      tail -> line = substitute_string (tail -> line, "\n", "\0");
+      i ++;
     }
-    else if (fti > 8 && fti < 12)
+    g_free (buf);
+    fclose (coordf);
+#endif
+    if (i)
     {
-      if (fti == 11) cif_use_symmetry_positions = TRUE;
-      this_reader -> cartesian = FALSE;
-      if (fti == 10)
+      this_reader -> cartesian = TRUE;
+      if (fti == 2)
       {
-        res = open_cif_file (i);
+        res = open_c3d_file (i);
       }
-      else
+      else if (fti < 7)
+      {
+        res = open_vas_file (i);
+      }
+      else if (fti > 6 && fti < 9)
+      {
+        res = open_pdb_file (i);
+      }
+      else if (fti > 8 && fti < 12)
+      {
+        if (fti == 11) cif_use_symmetry_positions = TRUE;
+        this_reader -> cartesian = FALSE;
+        if (fti == 10)
+        {
+          res = open_cif_file (i);
+        }
+        else
+        {
+          active_project -> steps = this_reader -> steps = 1;
+          this_reader -> rounding = -1;
+          cif_multiple = FALSE;
+          res = open_cif_configuration (i, 0);
+        }
+      }
+      else if (fti == 12)
       {
-        active_project -> steps = this_reader -> steps = 1;
-        this_reader -> rounding = -1;
-        cif_multiple = FALSE;
-        res = open_cif_configuration (i, 0);
+        res = open_hist_file (i);
       }
     }
-    else if (fti == 12)
+    else
     {
-      res = open_hist_file (i);
+      res = 1;
     }
-  }
-  else
-  {
-    res = 1;
-  }
 #ifndef OPENMP
-  if (tail) g_free (tail);
+    if (tail) g_free (tail);
 #endif
+  }
   if (! res)
   {
     if (fti == 9 && ! this_reader -> cartesian)
@@ -457,9 +653,11 @@ int open_coord_file (gchar * filename, int fti)
         active_project -> atoms[i][j].label[0] = FALSE;
         active_project -> atoms[i][j].label[1] = FALSE;
         active_project -> atoms[i][j].pick[0] = FALSE;
-        active_project -> atoms[i][j].cloned = FALSE;
+        set_step_clone (active_project, i, j, FALSE);
       }
     }
+    // All MD steps have been read: only the window of MD steps remains in memory
+    release_pos_window (active_project);
     if (fti != 9 || this_reader -> cartesian)
     {
       active_project -> nspec = this_reader -> nspec;
@@ -180,7 +180,7 @@ int hist_get_content ()
             res = 0;
             goto enda;
           }
-          active_project -> atoms[i][j].x = string_to_double ((gpointer)this_word);
+          active_project -> pos[i][0][j] = string_to_double ((gpointer)this_word);
           this_word = strtok_r (NULL, " ", & saved_line);
           if (! this_word)
           {
@@ -188,7 +188,7 @@ int hist_get_content ()
             res = 0;
             goto enda;
           }
-          active_project -> atoms[i][j].y = string_to_double ((gpointer)this_word);
+          active_project -> pos[i][1][j] = string_to_double ((gpointer)this_word);
           this_word = strtok_r (NULL, " ", & saved_line);
           if (! this_word)
           {
@@ -196,7 +196,7 @@ int hist_get_content ()
             res = 0;
             goto enda;
           }
-          active_project -> atoms[i][j].z = string_to_double ((gpointer)this_word);
+          active_project -> pos[i][2][j] = string_to_double ((gpointer)this_word);
         }
         else
         {
@@ -262,7 +262,7 @@ int hist_get_content ()
             res = 0;
             goto ends;
           }
-          active_project -> atoms[i][j].x = string_to_double ((gpointer)this_word);
+          active_project -> pos[i][0][j] = string_to_double ((gpointer)this_word);
           this_word = strtok_r (NULL, " ", & saved_line);
           if (! this_word)
           {
@@ -270,7 +270,7 @@ int hist_get_content ()
             res = 0;
             goto ends;
           }
-          active_project -> atoms[i][j].y = string_to_double ((gpointer)this_word);
+          active_project -> pos[i][1][j] = string_to_double ((gpointer)this_word);
           this_word = strtok_r (NULL, " ", & saved_line);
           if (! this_word)
           {
@@ -278,7 +278,7 @@ int hist_get_content ()
             res = 0;
             goto ends;
           }
-          active_project -> atoms[i][j].z = string_to_double ((gpointer)this_word);
+          active_project -> pos[i][2][j] = string_to_double ((gpointer)this_word);
         }
         else
         {
@@ -348,21 +348,21 @@ int hist_get_content ()
           format_error (i+1, j+1, lil[0], k+2*j+1);
           return 0;
         }
-        active_project -> atoms[i][j].x = string_to_double ((gpointer)this_word);
+        active_project -> pos[i][0][j] = string_to_double ((gpointer)this_word);
         this_word = strtok (NULL, " ");
         if (! this_word)
         {
           format_error (i+1, j+1, lil[1], k+2*j+1);
           return 0;
         }
-        active_project -> atoms[i][j].y = string_to_double ((gpointer)this_word);
+        active_project -> pos[i][1][j] = string_to_double ((gpointer)this_word);
         this_word = strtok (NULL, " ");
         if (! this_word)
         {
           format_error (i+1, j+1, lil[2], k+2*j+1);
           return 0;
         }
-        active_project -> atoms[i][j].z = string_to_double ((gpointer)this_word);
+        active_project -> pos[i][2][j] = string_to_double ((gpointer)this_word);
       }
       else
       {
@@ -191,9 +191,9 @@ int pdb_get_atoms_data (int linec)
     {
       active_project -> atoms[0][j].id = j;
       active_project -> atoms[0][j].sp = other_at -> sp;
-      active_project -> atoms[0][j].x = other_at -> x;
-      active_project -> atoms[0][j].y = other_at -> y;
-      active_project -> atoms[0][j].z = other_at -> z;
+      active_project -> pos[0][0][j] = other_at -> x;
+      active_project -> pos[0][1][j] = other_at -> y;
+      active_project -> pos[0][2][j] = other_at -> z;
       j ++;
       other_at = other_at -> next;
       g_free (other_at -> prev);
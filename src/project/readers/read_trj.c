@@ -30,8 +30,10 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 *
 * List of functions:
 
+  int trj_get_atom (int stp, int ato, gsize pos, int line);
+  int trj_get_frame (int stp);
   int trj_get_atom_coordinates ();
-  int open_trj_file (int linec);
+  int open_trj_file ();
 
 */
 
@@ -46,6 +48,64 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 #  include <omp.h>
 #endif
 
+/*!
+  \fn int trj_get_atom (int stp, int ato, gsize pos, int line)
+
+  \brief read the data of one atom from the mapped CPMD file
+
+  \param stp the MD step id
+  \param ato the atom id
+  \param pos the position of the atom line in the mapped file
+  \param line the line number
+*/
+int trj_get_atom (int stp, int ato, gsize pos, int line)
+{
+  int i;
+  double xyz[3];
+  gchar word[COORD_WORD];
+  gchar * lia[4] = {"a", "b", "c", "d"};
+  gsize end = coord_next_line (pos);
+  if (! coord_get_word (& pos, end, word))
+  {
+    format_error (stp+1, ato+1, lia[0], line);
+    return 2;
+  }
+  for (i=0; i<3; i++)
+  {
+    if (! coord_get_word (& pos, end, word))
+    {
+      format_error (stp+1, ato+1, lia[i+1], line);
+      return 2;
+    }
+    xyz[i] = string_to_double ((gpointer)word) * 0.52917721;
+  }
+  active_project -> pos[stp][0][ato] = xyz[0];
+  active_project -> pos[stp][1][ato] = xyz[1];
+  active_project -> pos[stp][2][ato] = xyz[2];
+  return 0;
+}
+
+/*!
+  \fn int trj_get_frame (int stp)
+
+  \brief read one frame of the mapped CPMD file
+
+  \param stp the MD step id
+*/
+int trj_get_frame (int stp)
+{
+  int i, j;
+  gsize pos = coord_frame[stp];
+  i = stp*active_project -> natomes;
+  for (j=0; j<active_project -> natomes; j++)
+  {
+    if (trj_get_atom (stp, j, pos, i+j)) return 2;
+    pos = coord_next_line (pos);
+  }
+  release_coord_frame (stp);
+  return 0;
+}
+
 /*!
   \fn int trj_get_atom_coordinates ()
 
@@ -54,13 +114,13 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 int trj_get_atom_coordinates ()
 {
   int i, j, k, l;
-  gchar * lia[4] = {"a", "b", "c", "d"};
+  int res = 0;
   allocatoms (active_project);
 #ifdef OPENMP
-  int res;
   int numth = omp_get_max_threads ();
   gboolean doatoms =  FALSE;
-  gchar * saved_line;
+  gsize pos;
+  gsize * atom_line;
   if (active_project -> steps < numth)
   {
     if (numth >= 2*(active_project -> steps-1))
@@ -74,156 +134,50 @@ int trj_get_atom_coordinates ()
   }
   if (doatoms)
   {
-    // OpenMP on atoms
-    res = 0;
+    // OpenMP on atoms, the lines of each frame are indexed first
+    atom_line = g_malloc0 (active_project -> natomes*sizeof*atom_line);
     for (i=0; i<active_project -> steps; i++)
     {
-      k = i*active_project -> natomes;
-      #pragma omp parallel for num_threads(numth) private(j,this_line,saved_line,this_word) shared(i,k,lia,coord_line,active_project,res)
+      pos = coord_frame[i];
       for (j=0; j<active_project -> natomes; j++)
       {
-        if (res == 2) goto enda;
-        this_line = g_strdup_printf ("%s", coord_line[k+j]);
-        this_word = strtok_r (this_line, " ", & saved_line);
-        if (! this_word)
-        {
-          format_error (i+1, j+1, lia[0], k+j);
-          res = 2;
-          goto enda;
-        }
-        this_word = strtok_r (NULL, " ", & saved_line);
-        if (! this_word)
-        {
-          format_error (i+1, j+1, lia[1], k+j);
-          res = 2;
-          goto enda;
-        }
-        active_project -> atoms[i][j].x = string_to_double ((gpointer)this_word);
-        this_word = strtok_r (NULL, " ", & saved_line);
-        if (! this_word)
-        {
-          format_error (i+1, j+1, lia[2], k+j);
-          res = 2;
-          goto enda;
-        }
-        active_project -> atoms[i][j].y = string_to_double ((gpointer)this_word);
-        this_word = strtok_r (NULL, " ", & saved_line);
-        if (! this_word)
-        {
-          format_error (i+1, j+1, lia[3], k+j);
-          res = 2;
-          goto enda;
-        }
-        active_project -> atoms[i][j].z = string_to_double ((gpointer)this_word);
-        g_free (this_line);
-        enda:;
+        atom_line[j] = pos;
+        pos = coord_next_line (pos);
       }
-      if (res == 2) break;
-    }
-  }
-  else
-  {
-    res = 0;
-    #pragma omp parallel for num_threads(numth) private(i,j,k,this_line,saved_line,this_word) shared(lia,coord_line,active_project,res)
-    for (i=0; i<active_project -> steps; i++)
-    {
-      if (res == 2) goto ends;
       k = i*active_project -> natomes;
+      #pragma omp parallel for num_threads(numth) private(j) shared(i,k,atom_line,active_project,res)
       for (j=0; j<active_project -> natomes; j++)
       {
-        this_line = g_strdup_printf ("%s", coord_line[k+j]);
-        this_word = strtok_r (this_line, " ", & saved_line);
-        if (! this_word)
-        {
-          format_error (i+1, j+1, lia[0], k+j);
-          res = 2;
-          goto ends;
-        }
-        this_word = strtok_r (NULL, " ", & saved_line);
-        if (! this_word)
-        {
-          format_error (i+1, j+1, lia[1], k+j);
-          res = 2;
-          goto ends;
-        }
-        active_project -> atoms[i][j].x = string_to_double ((gpointer)this_word) * 0.52917721;
-        this_word = strtok_r (NULL, " ", & saved_line);
-        if (! this_word)
+        if (! res)
         {
-          format_error (i+1, j+1, lia[2], k+j);
-          res = 2;
-          goto ends;
+          if (trj_get_atom (i, j, atom_line[j], k+j)) res = 2;
         }
-        active_project -> atoms[i][j].y = string_to_double ((gpointer)this_word) * 0.52917721;
-        this_word = strtok_r (NULL, " ", & saved_line);
-        if (! this_word)
-        {
-          format_error (i+1, j+1, lia[3], k+j);
-          res = 2;
-          goto ends;
-        }
-        active_project -> atoms[i][j].z = string_to_double ((gpointer)this_word) * 0.52917721;
-        g_free (this_line);
       }
-      ends:;
+      release_coord_frame (i);
+      if (res) break;
     }
+    g_free (atom_line);
   }
-  g_free (coord_line);
-  if (res == 2) return 2;
-  for (i=1; i<active_project -> steps; i++)
+  else
   {
-    for (j=0; j<active_project -> natomes; j++)
+    // OpenMP on MD steps
+    #pragma omp parallel for num_threads(numth) private(i) shared(active_project,res)
+    for (i=0; i<active_project -> steps; i++)
     {
-      if (active_project -> atoms[i-1][j].sp != active_project -> atoms[i][j].sp)
+      if (! res)
       {
-        add_reader_info (g_strdup_printf ("Error - chemical species changes between steps %d and %d, for atom %d !", i, i+1, j+1), 0);
-        return 2;
+        if (trj_get_frame (i)) res = 2;
       }
     }
   }
 #else
-  line_node * tmp_line;
-  tail = head;
-  k = 0;
   for (i=0; i<active_project -> steps; i++)
   {
-    for (j=0; j<active_project -> natomes; j++)
-    {
-      this_line = g_strdup_printf ("%s", tail -> line);
-      this_word = strtok (this_line, " ");
-      if (! this_word)
-      {
-        format_error (i+1, j+1, lia[0], k);
-        return 2;
-      }
-      this_word = strtok (NULL, " ");
-      if (! this_word)
-      {
-        format_error (i+1, j+1, lia[1], k);
-        return 2;
-      }
-      active_project -> atoms[i][j].x = string_to_double ((gpointer)this_word) * 0.52917721;
-      this_word = strtok (NULL, " ");
-      if (! this_word)
-      {
-        format_error (i+1, j+1, lia[2], k);
-        return 2;
-      }
-      active_project -> atoms[i][j].y = string_to_double ((gpointer)this_word) * 0.52917721;
-      this_word = strtok (NULL, " ");
-      if (! this_word)
-      {
-        format_error (i+1, j+1, lia[3], k);
-        return 2;
-      }
-      active_project -> atoms[i][j].z = string_to_double ((gpointer)this_word) * 0.52917721;
-      tmp_line = tail;
-      tail = tail -> next;
-      g_free (tmp_line);
-      k ++;
-    }
+    res = trj_get_frame (i);
+    if (res) break;
   }
 #endif
+  if (res) return 2;
   i = 0;
   for (j=0; j<this_reader -> nspec; j++)
   {
@@ -240,17 +194,16 @@ int trj_get_atom_coordinates ()
 }
 
 /*!
-  \fn int open_trj_file (int linec)
-
-  \brief open CPMD file
+  \fn int open_trj_file ()
 
-  \param linec Number of lines in the file
+  \brief open CPMD file, the file is mapped in memory
 */
-int open_trj_file (int linec)
+int open_trj_file ()
 {
-  if (linec%(this_reader -> natomes) != 0) return 2;
+  if (this_reader -> natomes < 1) return 2;
+  active_project -> steps = index_coord_frames (this_reader -> natomes);
+  if (active_project -> steps < 1) return 2;
   reader_info ("trj", "Number of atoms", this_reader -> natomes);
-  active_project -> steps = linec / this_reader -> natomes;
   reader_info ("trj", "Number of steps", active_project -> steps);
   active_project -> natomes = this_reader -> natomes;
   return trj_get_atom_coordinates ();
@@ -93,7 +93,7 @@ int vas_get_atom_coordinates (int sli)
           res = 2;
           goto enda;
         }
-        active_project -> atoms[i][j].x = string_to_double ((gpointer)this_word);
+        active_project -> pos[i][0][j] = string_to_double ((gpointer)this_word);
         this_word = strtok_r (NULL, " ", & saved_line);
         if (! this_word)
         {
@@ -101,7 +101,7 @@ int vas_get_atom_coordinates (int sli)
           res = 2;
           goto enda;
         }
-        active_project -> atoms[i][j].y = string_to_double ((gpointer)this_word);
+        active_project -> pos[i][1][j] = string_to_double ((gpointer)this_word);
         this_word = strtok_r (NULL, " ", & saved_line);
         if (! this_word)
         {
@@ -109,7 +109,7 @@ int vas_get_atom_coordinates (int sli)
           res = 2;
           goto enda;
         }
-        active_project -> atoms[i][j].z = string_to_double ((gpointer)this_word);
+        active_project -> pos[i][2][j] = string_to_double ((gpointer)this_word);
         g_free (this_line);
         enda:;
       }
@@ -134,7 +134,7 @@ int vas_get_atom_coordinates (int sli)
           res = 2;
           goto ends;
         }
-        active_project -> atoms[i][j].x = string_to_double ((gpointer)this_word);
+        active_project -> pos[i][0][j] = string_to_double ((gpointer)this_word);
         this_word = strtok_r (NULL, " ", & saved_line);
         if (! this_word)
         {
@@ -142,7 +142,7 @@ int vas_get_atom_coordinates (int sli)
           res = 2;
           goto ends;
         }
-        active_project -> atoms[i][j].y = string_to_double ((gpointer)this_word);
+        active_project -> pos[i][1][j] = string_to_double ((gpointer)this_word);
         this_word = strtok_r (NULL, " ", & saved_line);
         if (! this_word)
         {
@@ -150,7 +150,7 @@ int vas_get_atom_coordinates (int sli)
           res = 2;
           goto ends;
         }
-        active_project -> atoms[i][j].z = string_to_double ((gpointer)this_word);
+        active_project -> pos[i][2][j] = string_to_double ((gpointer)this_word);
         g_free (this_line);
       }
       ends:;
@@ -195,21 +195,21 @@ int vas_get_atom_coordinates (int sli)
         format_error (i+1, j+1, lia[0], k);
         return 2;
       }
-      active_project -> atoms[i][j].x = string_to_double ((gpointer)this_word);
+      active_project -> pos[i][0][j] = string_to_double ((gpointer)this_word);
       this_word = strtok (NULL, " ");
       if (! this_word)
       {
         format_error (i+1, j+1, lia[1], k);
         return 2;
       }
-      active_project -> atoms[i][j].y = string_to_double ((gpointer)this_word);
+      active_project -> pos[i][1][j] = string_to_double ((gpointer)this_word);
       this_word = strtok (NULL, " ");
       if (! this_word)
       {
         format_error (i+1, j+1, lia[2], k);
         return 2;
       }
-      active_project -> atoms[i][j].z = string_to_double ((gpointer)this_word);
+      active_project -> pos[i][2][j] = string_to_double ((gpointer)this_word);
       tmp_line = tail;
       tail = tail -> next;
       g_free (tmp_line);
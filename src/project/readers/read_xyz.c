@@ -30,8 +30,10 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 *
 * List of functions:
 
+  int xyz_get_atom (int stp, int ato, gsize pos, int line);
+  int xyz_get_frame (int stp);
   int xyz_get_atom_coordinates ();
-  int open_xyz_file (int linec);
+  int open_xyz_file ();
 
 */
 
@@ -46,6 +48,89 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 #  include <omp.h>
 #endif
 
+/*!
+  \fn int xyz_get_atom (int stp, int ato, gsize pos, int line)
+
+  \brief read the data of one atom from the mapped XYZ file
+
+  \param stp the MD step id
+  \param ato the atom id
+  \param pos the position of the atom line in the mapped file
+  \param line the line number
+*/
+int xyz_get_atom (int stp, int ato, gsize pos, int line)
+{
+  int i;
+  int v_dummy;
+  double v;
+  double xyz[3];
+  gchar word[COORD_WORD];
+  gchar * lia[4] = {"a", "b", "c", "d"};
+  gsize end = coord_next_line (pos);
+  if (! coord_get_word (& pos, end, word))
+  {
+    format_error (stp+1, ato+1, lia[0], line);
+    return 2;
+  }
+  v = get_z_from_periodic_table (word);
+  v_dummy = 0;
+  if (! v)
+  {
+#ifdef OPENMP
+    #pragma omp critical
+#endif
+    v_dummy = set_v_dummy (word);
+  }
+  if (! v && ! v_dummy)
+  {
+    format_error (stp+1, ato+1, lia[0], line);
+    return 2;
+  }
+  if (! stp)
+  {
+    v = v + v_dummy * 0.1;
+#ifdef OPENMP
+    #pragma omp critical
+#endif
+    check_for_species (v, ato);
+  }
+  for (i=0; i<3; i++)
+  {
+    if (! coord_get_word (& pos, end, word))
+    {
+      format_error (stp+1, ato+1, lia[i+1], line);
+      return 2;
+    }
+    xyz[i] = string_to_double ((gpointer)word);
+  }
+  active_project -> pos[stp][0][ato] = xyz[0];
+  active_project -> pos[stp][1][ato] = xyz[1];
+  active_project -> pos[stp][2][ato] = xyz[2];
+  return 0;
+}
+
+/*!
+  \fn int xyz_get_frame (int stp)
+
+  \brief read one frame of the mapped XYZ file
+
+  \param stp the MD step id
+*/
+int xyz_get_frame (int stp)
+{
+  int i, j;
+  // Skip the 2 header lines of the frame
+  gsize pos = coord_next_line (coord_next_line (coord_frame[stp]));
+  i = stp*(this_reader -> natomes + 2) + 2;
+  for (j=0; j<this_reader -> natomes; j++)
+  {
+    if (xyz_get_atom (stp, j, pos, i+j)) return 2;
+    pos = coord_next_line (pos);
+  }
+  release_coord_frame (stp);
+  return 0;
+}
+
 /*!
   \fn int xyz_get_atom_coordinates ()
 
@@ -53,9 +138,8 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 */
 int xyz_get_atom_coordinates ()
 {
-  int i, j, k;
-  double v;
-  gchar * lia[4] = {"a", "b", "c", "d"};
+  int i, j;
+  int res = 0;
   this_reader -> nspec = 0;
   active_project -> steps = this_reader -> steps;
   active_project -> natomes = this_reader -> natomes;
@@ -63,11 +147,10 @@ int xyz_get_atom_coordinates ()
   this_reader -> z = allocdouble (1);
   this_reader -> nsps = allocint (1);
 #ifdef OPENMP
-  int v_dummy;
-  int res;
   int numth = omp_get_max_threads ();
   gboolean doatoms =  FALSE;
-  gchar * saved_line;
+  gsize pos;
+  gsize * atom_line;
   if (this_reader -> steps < numth)
   {
     if (numth >= 2*(this_reader -> steps-1))
@@ -82,205 +165,49 @@ int xyz_get_atom_coordinates ()
 
   if (doatoms)
   {
-    // OpenMP on atoms
-    res = 0;
+    // OpenMP on atoms, the lines of each frame are indexed first
+    atom_line = g_malloc0 (this_reader -> natomes*sizeof*atom_line);
     for (i=0; i<this_reader -> steps; i++)
     {
-      k = i*(this_reader -> natomes + 2) + 2;
-      #pragma omp parallel for num_threads(numth) private(j,v,v_dummy,this_line,saved_line,this_word) shared(i,k,lia,coord_line,this_reader,active_project,res)
+      pos = coord_next_line (coord_next_line (coord_frame[i]));
       for (j=0; j<this_reader -> natomes; j++)
       {
-        if (res == 2) goto enda;
-        this_line = g_strdup_printf ("%s", coord_line[k+j]);
-        this_word = strtok_r (this_line, " ", & saved_line);
-        if (! this_word)
-        {
-          format_error (i+1, j+1, lia[0], k+j);
-          res = 2;
-          goto enda;
-        }
-        v = get_z_from_periodic_table (this_word);
-        v_dummy = 0;
-        if (! v)
-        {
-          #pragma omp critical
-          v_dummy = set_v_dummy (this_word);
-        }
-        if (v || v_dummy)
-        {
-          if (! i)
-          {
-            v = v + v_dummy * 0.1;
-            #pragma omp critical
-            check_for_species (v, j);
-          }
-          this_word = strtok_r (NULL, " ", & saved_line);
-          if (! this_word)
-          {
-            format_error (i+1, j+1, lia[1], k+j);
-            res = 2;
-            goto enda;
-          }
-          active_project -> atoms[i][j].x = string_to_double ((gpointer)this_word);
-          this_word = strtok_r (NULL, " ", & saved_line);
-          if (! this_word)
-          {
-            format_error (i+1, j+1, lia[2], k+j);
-            res = 2;
-            goto enda;
-          }
-          active_project -> atoms[i][j].y = string_to_double ((gpointer)this_word);
-          this_word = strtok_r (NULL, " ", & saved_line);
-          if (! this_word)
-          {
-            format_error (i+1, j+1, lia[3], k+j);
-            res = 2;
-            goto enda;
-          }
-          active_project -> atoms[i][j].z = string_to_double ((gpointer)this_word);
-        }
-        else
+        atom_line[j] = pos;
+        pos = coord_next_line (pos);
+      }
+      #pragma omp parallel for num_threads(numth) private(j) shared(i,atom_line,this_reader,res)
+      for (j=0; j<this_reader -> natomes; j++)
+      {
+        if (! res)
         {
-          format_error (i+1, j+1, lia[0], k+j);
-          res = 2;
-          goto enda;
+          if (xyz_get_atom (i, j, atom_line[j], i*(this_reader -> natomes + 2) + 2 + j)) res = 2;
         }
-        g_free (this_line);
-        enda:;
       }
-      if (res == 2) break;
+      release_coord_frame (i);
+      if (res) break;
     }
+    g_free (atom_line);
   }
   else
   {
-    res = 0;
-    #pragma omp parallel for num_threads(numth) private(i,j,k,v,v_dummy,this_line,saved_line,this_word) shared(lia,coord_line,this_reader,active_project,res)
+    // OpenMP on MD steps
+    #pragma omp parallel for num_threads(numth) private(i) shared(this_reader,res)
     for (i=0; i<this_reader -> steps; i++)
     {
-      if (res == 2) goto ends;
-      k = i*(this_reader -> natomes + 2) + 2;
-      for (j=0; j<this_reader -> natomes; j++)
+      if (! res)
       {
-        this_line = g_strdup_printf ("%s", coord_line[k+j]);
-        this_word = strtok_r (this_line, " ", & saved_line);
-        if (! this_word)
-        {
-          format_error (i+1, j+1, lia[0], k+j);
-          res = 2;
-          goto ends;
-        }
-        v = get_z_from_periodic_table (this_word);
-        v_dummy = 0;
-        if (! v)
-        {
-          #pragma omp critical
-          v_dummy = set_v_dummy (this_word);
-        }
-        if (v || v_dummy)
-        {
-          if (! i)
-          {
-            v = v + v_dummy * 0.1;
-            check_for_species (v, j);
-          }
-          this_word = strtok_r (NULL, " ", & saved_line);
-          if (! this_word)
-          {
-            format_error (i+1, j+1, lia[1], k+j);
-            res = 2;
-            goto ends;
-          }
-          active_project -> atoms[i][j].x = string_to_double ((gpointer)this_word);
-          this_word = strtok_r (NULL, " ", & saved_line);
-          if (! this_word)
-          {
-            format_error (i+1, j+1, lia[1], k+j);
-            res = 2;
-            goto ends;
-          }
-          active_project -> atoms[i][j].y = string_to_double ((gpointer)this_word);
-          this_word = strtok_r (NULL, " ", & saved_line);
-          if (! this_word)
-          {
-            format_error (i+1, j+1, lia[2], k+j);
-            res = 2;
-            goto ends;
-          }
-          active_project -> atoms[i][j].z = string_to_double ((gpointer)this_word);
-        }
-        else
-        {
-          format_error (i+1, j+1, lia[3], k+j);
-          res = 2;
-          goto ends;
-        }
-        g_free (this_line);
+        if (xyz_get_frame (i)) res = 2;
       }
-      ends:;
     }
   }
-  g_free (coord_line);
-  if (res == 2) return 2;
 #else
-  line_node * tmp_line;
-  tail = head;
-  k = 0;
-  for (i=0; i<active_project -> steps; i++)
+  for (i=0; i<this_reader -> steps; i++)
   {
-    for (j=0; j<2; j++)
-    {
-      tmp_line = tail;
-      tail = tail -> next;
-      g_free (tmp_line);
-      k ++;
-    }
-    for (j=0; j<active_project -> natomes; j++)
-    {
-      this_line = g_strdup_printf ("%s", tail -> line);
-      this_word = strtok (this_line, " ");
-      if (! this_word)
-      {
-        format_error (i+1, j+1, lia[0], k+j);
-        return 2;
-      }
-      v = get_z_from_periodic_table (this_word);
-      if (v)
-      {
-        if (! i) check_for_species (v, j);
-        this_word = strtok (NULL, " ");
-        if (! this_word)
-        {
-          format_error (i+1, j+1, lia[1], k+j);
-          return 2;
-        }
-        active_project -> atoms[i][j].x = string_to_double ((gpointer)this_word);
-        this_word = strtok (NULL, " ");
-        if (! this_word)
-        {
-          format_error (i+1, j+1, lia[2], k+j);
-          return 2;
-        }
-        active_project -> atoms[i][j].y = string_to_double ((gpointer)this_word);
-        this_word = strtok (NULL, " ");
-        if (! this_word)
-        {
-          format_error (i+1, j+1, lia[3], k+j);
-          return 2;
-        }
-        active_project -> atoms[i][j].z = string_to_double ((gpointer)this_word);
-      }
-      else
-      {
-        format_error (i+1, j+1, lia[0], k+j);
-        return 2;
-      }
-      tmp_line = tail;
-      tail = tail -> next;
-      g_free (tmp_line);
-      k ++;
-    }
+    res = xyz_get_frame (i);
+    if (res) break;
   }
 #endif
+  if (res) return 2;
   for (i=1; i<active_project -> steps; i++)
   {
     for (j=0; j<active_project -> natomes; j++)
@@ -292,62 +219,25 @@ int xyz_get_atom_coordinates ()
 }
 
 /*!
-  \fn int open_xyz_file (int linec)
-
-  \brief open XYZ file
+  \fn int open_xyz_file ()
 
-  \param linec Number of lines in the file
+  \brief open XYZ file, the file is mapped in memory
 */
-int open_xyz_file (int linec)
+int open_xyz_file ()
 {
-  int res;
-#ifdef OPENMP
-  this_line = g_strdup_printf ("%s", coord_line[0]);
-  this_word = strtok (this_line, " ");
-  if (! this_word)
+  gsize pos = 0;
+  gchar word[COORD_WORD];
+  if (! coord_get_word (& pos, coord_next_line (0), word))
   {
     add_reader_info ("Wrong file format - cannot find the number of atoms !", 0);
     add_reader_info ("Wrong file format - first line is corrupted !", 0);
-    res = 2;
-    goto end;
+    return 2;
   }
-  this_reader -> natomes = (int)string_to_double ((gpointer)this_word);
+  this_reader -> natomes = (int)string_to_double ((gpointer)word);
   reader_info ("xyz", "Number of atoms", this_reader -> natomes);
-  g_free (this_line);
-  if (linec%(this_reader -> natomes + 2) != 0)
-  {
-    res = 2;
-  }
-  else
-  {
-    this_reader -> steps = linec / (this_reader -> natomes + 2);
-    reader_info ("xyz", "Number of steps", this_reader -> steps);
-    res = xyz_get_atom_coordinates ();
-  }
-#else
-  this_line = g_strdup_printf ("%s", head -> line);
-  this_word = strtok (this_line, " ");
-  if (! this_word)
-  {
-    add_reader_info ("Wrong file format - cannot find the number of atoms !", 0);
-    add_reader_info ("Wrong file format - the first line is corrupted !", 0);
-    res = 2;
-    goto end;
-  }
-  this_reader -> natomes = (int)string_to_double ((gpointer)this_word);
-  reader_info ("xyz", "Number of atoms", this_reader -> natomes);
-  g_free (this_line);
-  if (linec%(this_reader -> natomes + 2) != 0)
-  {
-    res = 2;
-  }
-  else
-  {
-    this_reader -> steps = linec / (this_reader -> natomes + 2);
-    reader_info ("xyz", "Number of steps", this_reader -> steps);
-    res = xyz_get_atom_coordinates ();
-  }
-#endif
-  end:
-  return res;
+  if (this_reader -> natomes < 1) return 2;
+  this_reader -> steps = index_coord_frames (this_reader -> natomes + 2);
+  if (this_reader -> steps < 1) return 2;
+  reader_info ("xyz", "Number of steps", this_reader -> steps);
+  return xyz_get_atom_coordinates ();
 }
@@ -34,6 +34,9 @@ Copyright (C) 2022-2025 by CNRS and University of Strasbourg */
 
 #include "read_isaacs.h"
 
+#define COORD_WORD 64
+#define COORD_CHUNK 33554432
+
 extern int set_v_dummy (gchar * this_word);
 
 extern double get_z_from_periodic_table (gchar * lab);
@@ -49,6 +52,13 @@ extern gchar ** coord_line;
 extern line_node * head;
 extern line_node * tail;
 
+extern gchar * coord_data;
+extern gsize * coord_frame;
+extern gsize coord_next_line (gsize pos);
+extern gboolean coord_get_word (gsize * pos, gsize end, gchar * word);
+extern int index_coord_frames (int lpf);
+extern void release_coord_frame (int stp);
+
 extern void add_reader_info (gchar * info, int mid);
 extern void reader_info (gchar * type, gchar * sinf, int val);
 extern void format_error (int stp, int ato, gchar * mot, int line);
@@ -58,11 +58,11 @@ int save_atom_a (FILE * fp, project * this_proj, int s, int a)
 {
   if (fwrite (& this_proj -> atoms[s][a].id, sizeof(int), 1, fp) != 1) return ERROR_RW;
   if (fwrite (& this_proj -> atoms[s][a].sp, sizeof(int), 1, fp) != 1) return ERROR_RW;
-  if (fwrite (& this_proj -> atoms[s][a].x, sizeof(double), 1, fp) != 1) return ERROR_RW;
-  if (fwrite (& this_proj -> atoms[s][a].y, sizeof(double), 1, fp) != 1) return ERROR_RW;
-  if (fwrite (& this_proj -> atoms[s][a].z, sizeof(double), 1, fp) != 1) return ERROR_RW;
+  if (fwrite (& this_proj -> pos[s][0][a], sizeof(double), 1, fp) != 1) return ERROR_RW;
+  if (fwrite (& this_proj -> pos[s][1][a], sizeof(double), 1, fp) != 1) return ERROR_RW;
+  if (fwrite (& this_proj -> pos[s][2][a], sizeof(double), 1, fp) != 1) return ERROR_RW;
   //g_debug ("Saving:: step= %d, at= %d, sp[%d]= %d, x[%d]= %f, y[%d]= %f, z[%d]= %f",
-  //         s, a+1, a, this_proj -> atoms[s][a].sp, a, this_proj -> atoms[s][a].x, a, this_proj -> atoms[s][a].y, a, this_proj -> atoms[s][a].z);
+  //         s, a+1, a, this_proj -> atoms[s][a].sp, a, this_proj -> pos[s][0][a], a, this_proj -> pos[s][1][a], a, this_proj -> pos[s][2][a]);
   return OK;
 }
 
@@ -175,8 +175,8 @@ int update_project ()
 void active_project_changed (int id)
 {
   char * errp = NULL;
-  if (id != inactep && inactep < nprojects && ! atomes_logo) clean_view ();
-  gtk_tree_store_clear (tool_model);
+  if (id != inactep && inactep < nprojects && ! atomes_logo && ! atomes_batch) clean_view ();
+  if (! atomes_batch) gtk_tree_store_clear (tool_model);
   activep = id;
   active_project = get_project_by_id (id);
   active_chem = active_project -> chemistry;
@@ -213,7 +213,7 @@ void active_project_changed (int id)
   }
   else
   {
-    if (active_project -> numwid > 0)
+    if (active_project -> numwid > 0 && ! atomes_batch)
     {
       prep_calc_actions ();
       add_action (edition_actions[0]);